@@ -5,8 +5,48 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
 #include "CharacterSaveData.generated.h"
 
+/**
+ * Gnero do personagem
+ */
+UENUM(BlueprintType)
+enum class ECharacterGender : uint8
+{
+	Male		UMETA(DisplayName = "Male"),
+	Female		UMETA(DisplayName = "Female"),
+	Count		UMETA(Hidden)
+};
+
+inline const TCHAR* LexToString(ECharacterGender Gender)
+{
+	switch (Gender)
+	{
+		case ECharacterGender::Male: return TEXT("Male");
+		case ECharacterGender::Female: return TEXT("Female");
+		default: return TEXT("Unknown");
+	}
+}
+
+/**
+ * Converte o texto salvo no JSON ("Male"/"Female") para o enum
+ */
+inline bool LexTryParseString(ECharacterGender& OutGender, const TCHAR* Buffer)
+{
+	if (FCString::Stricmp(Buffer, TEXT("Male")) == 0)
+	{
+		OutGender = ECharacterGender::Male;
+		return true;
+	}
+	if (FCString::Stricmp(Buffer, TEXT("Female")) == 0)
+	{
+		OutGender = ECharacterGender::Female;
+		return true;
+	}
+	return false;
+}
+
 
 /**
  * Preset de rosto (base para customizao)
@@ -23,9 +63,9 @@ struct FFacePresetData
 	FString PresetName = TEXT("Default");
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preset")
-	FString Gender = TEXT("Male");
+	ECharacterGender Gender = ECharacterGender::Male;
 
-	// Futuro: morphs do preset (por enquanto s ID)
+	// Peso por nome de morph (slots da UErosMorphTable)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preset")
 	TMap<FName, float> MorphValues;
 };
@@ -137,7 +177,7 @@ struct FCharacterSaveData
 	FString CharacterName;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Basic")
-	FString CharacterGender;
+	ECharacterGender CharacterGender = ECharacterGender::Male;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Basic")
 	int32 CharacterSlot;
@@ -168,4 +208,28 @@ struct FCharacterSaveData
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Metadata")
 	FString LastLocationName;
+};
+
+/**
+ * Converses de ECharacterGender para Blueprint
+ * CharacterGender era FString: widgets que ligavam o pino direto em texto usam estas funes
+ */
+UCLASS()
+class EROSSOCIAL_API UCharacterSaveDataLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintPure, Category = "Character", meta = (DisplayName = "To String (CharacterGender)", CompactNodeTitle = "->", BlueprintAutocast))
+	static FString Conv_CharacterGenderToString(ECharacterGender Gender) { return LexToString(Gender); }
+
+	UFUNCTION(BlueprintPure, Category = "Character", meta = (DisplayName = "To Text (CharacterGender)", CompactNodeTitle = "->", BlueprintAutocast))
+	static FText Conv_CharacterGenderToText(ECharacterGender Gender)
+	{
+		return StaticEnum<ECharacterGender>()->GetDisplayNameTextByValue(static_cast<int64>(Gender));
+	}
+
+	/** Gnero como o antigo campo FString ("Male"/"Female") */
+	UFUNCTION(BlueprintPure, Category = "Character")
+	static FString GetCharacterGenderString(const FCharacterSaveData& CharacterData) { return LexToString(CharacterData.CharacterGender); }
 };
\ No newline at end of file
@@ -0,0 +1,65 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosUserId.cpp
+
+#include "ErosUserId.h"
+#include "Misc/Guid.h"
+#include "Misc/SecureHash.h"
+
+FErosUserId FErosUserId::FromString(const FString& InString)
+{
+	if (InString.IsEmpty())
+	{
+		return FErosUserId();
+	}
+
+	// IDs já no formato hex (ou GUID) são lidos diretamente
+	FGuid Guid;
+	if (FGuid::Parse(InString, Guid))
+	{
+		return FErosUserId(
+			(static_cast<uint64>(Guid.A) << 32) | Guid.B,
+			(static_cast<uint64>(Guid.C) << 32) | Guid.D);
+	}
+
+	// Qualquer outro ID do login vira 128 bits via MD5
+	FTCHARToUTF8 Utf8(*InString);
+	uint8 Digest[16];
+	FMD5 Md5;
+	Md5.Update(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	Md5.Final(Digest);
+
+	uint64 High = 0;
+	uint64 Low = 0;
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		High = (High << 8) | Digest[Index];
+		Low = (Low << 8) | Digest[Index + 8];
+	}
+
+	return FErosUserId(High, Low);
+}
+
+FString FErosUserId::ToString() const
+{
+	return FString::Printf(TEXT("%016llx%016llx"), High, Low);
+}
+
+bool FErosUserId::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// 1 bit de validade: IDs vazios (ex: sem partner) custam só esse bit
+	uint8 bValid = IsValid() ? 1 : 0;
+	Ar.SerializeBits(&bValid, 1);
+
+	if (bValid)
+	{
+		Ar << High;
+		Ar << Low;
+	}
+	else if (Ar.IsLoading())
+	{
+		Invalidate();
+	}
+
+	bOutSuccess = true;
+	return true;
+}
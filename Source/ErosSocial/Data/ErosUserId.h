@@ -0,0 +1,90 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosUserId.h
+// Identificador compacto (128 bits) de usuário
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "ErosUserId.generated.h"
+
+/**
+ * Identificador de usuário de 128 bits
+ * Substitui o FString usado em replicação, save e lookups (hash rápido, 16 bytes na rede)
+ */
+USTRUCT(BlueprintType)
+struct EROSSOCIAL_API FErosUserId
+{
+	GENERATED_BODY()
+
+	FErosUserId() = default;
+
+	FErosUserId(uint64 InHigh, uint64 InLow)
+		: High(InHigh)
+		, Low(InLow)
+	{
+	}
+
+	/**
+	 * Converte a string do login em ID
+	 * Aceita 32 dígitos hex (formato de ToString/GUID); qualquer outra string é convertida via MD5
+	 */
+	static FErosUserId FromString(const FString& InString);
+
+	/** 32 dígitos hex, usado também como nome da pasta de save */
+	FString ToString() const;
+
+	bool IsValid() const { return (High | Low) != 0; }
+
+	void Invalidate() { High = 0; Low = 0; }
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FErosUserId& Other) const { return High == Other.High && Low == Other.Low; }
+	bool operator!=(const FErosUserId& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FErosUserId& UserId)
+	{
+		// Os bits já são uniformes (MD5/GUID), basta dobrar para 32 bits
+		return HashCombineFast(GetTypeHash(UserId.High), GetTypeHash(UserId.Low));
+	}
+
+	UPROPERTY()
+	uint64 High = 0;
+
+	UPROPERTY()
+	uint64 Low = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FErosUserId> : public TStructOpsTypeTraitsBase2<FErosUserId>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+/**
+ * Conversões de FErosUserId para Blueprint
+ */
+UCLASS()
+class EROSSOCIAL_API UErosUserIdLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintPure, Category = "UserId", meta = (DisplayName = "To ErosUserId (String)", CompactNodeTitle = "->", BlueprintAutocast))
+	static FErosUserId Conv_StringToErosUserId(const FString& InString) { return FErosUserId::FromString(InString); }
+
+	UFUNCTION(BlueprintPure, Category = "UserId", meta = (DisplayName = "To String (ErosUserId)", CompactNodeTitle = "->", BlueprintAutocast))
+	static FString Conv_ErosUserIdToString(const FErosUserId& UserId) { return UserId.ToString(); }
+
+	UFUNCTION(BlueprintPure, Category = "UserId", meta = (DisplayName = "Equal (ErosUserId)", CompactNodeTitle = "==", Keywords = "== equal"))
+	static bool EqualEqual_ErosUserId(const FErosUserId& A, const FErosUserId& B) { return A == B; }
+
+	UFUNCTION(BlueprintPure, Category = "UserId")
+	static bool IsValidUserId(const FErosUserId& UserId) { return UserId.IsValid(); }
+};
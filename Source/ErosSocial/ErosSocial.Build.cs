@@ -21,7 +21,8 @@ public class ErosSocial : ModuleRules
             "Slate",
             "SlateCore",
             "Json",           // ← ADICIONAR!
-            "JsonUtilities"   // ← ADICIONAR!
+            "JsonUtilities",  // ← ADICIONAR!
+            "ReplicationGraph"
         });
 
         PublicIncludePaths.AddRange(new string[]
@@ -32,6 +33,8 @@ public class ErosSocial : ModuleRules
 
         PrivateDependencyModuleNames.AddRange(new string[]
         {
+            "RenderCore",
+            "HairStrandsCore"
         });
     }
 }
\ No newline at end of file
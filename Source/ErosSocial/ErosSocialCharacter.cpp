@@ -10,11 +10,29 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
+#include "Net/UnrealNetwork.h"
 #include "Systems/ClothingSystem.h"
+#include "Systems/Customization/ErosMorphComponent.h"
+#include "Systems/Customization/ErosMorphTable.h"
+#include "Systems/Customization/ErosAppearanceColors.h"
 #include "ErosSocialPlayerState.h"
+#include "ErosSocialPlayerController.h"
+#include "Systems/Proximity/ErosProximitySubsystem.h"
+#include "Systems/Significance/ErosSignificanceSubsystem.h"
+#include "Systems/Profiling/ErosSpawnProfiler.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
+namespace
+{
+	// Morph de cada slider do FBodyCustomization (precisam existir no skeletal mesh)
+	TConstArrayView<FName> GetBodyMorphNames()
+	{
+		static const FName Names[] = { TEXT("BreastSize"), TEXT("ButtSize"), TEXT("Height"), TEXT("Weight"), TEXT("Muscle") };
+		return Names;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // AErosSocialCharacter
 
@@ -52,10 +70,16 @@ AErosSocialCharacter::AErosSocialCharacter()
 
 	// Criar ClothingSystem
 	ClothingSystem = CreateDefaultSubobject<UClothingSystem>(TEXT("ClothingSystem"));
+
+	MorphComponent = CreateDefaultSubobject<UErosMorphComponent>(TEXT("MorphComponent"));
+
+	NetUpdateRate = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(NetUpdateFrequency), 1, 255));
 }
 
 void AErosSocialCharacter::BeginPlay()
 {
+	EROS_SPAWN_STAGE_SCOPE(BeginPlay);
+
 	Super::BeginPlay();
 
 	// Inicializar ClothingSystem
@@ -67,22 +91,166 @@ void AErosSocialCharacter::BeginPlay()
 	// Obter PlayerState
 	PlayerStateRef = Cast<AErosSocialPlayerState>(GetPlayerState());
 
+	{
+		EROS_SPAWN_STAGE_SCOPE(MorphSetup);
+		EnsureMorphSetup();
+		MorphComponent->SetUseBakedMesh(!IsLocallyControlled());
+	}
+
+	// Aparncia que chegou junto com o spawn do ator
+	if (!HasAuthority() && ReplicatedAppearance.IsValid() && ReplicatedAppearance.GetHash() != AppliedAppearanceHash)
+	{
+		ApplyReplicatedAppearance(true, true);
+	}
+
+	// Registrar no hash de proximidade
+	if (UErosProximitySubsystem* Proximity = UErosProximitySubsystem::Get(this))
+	{
+		Proximity->RegisterCharacter(this);
+	}
+
+	// Oramento de animao, morphs, cabelo e roupas
+	if (UErosSignificanceSubsystem* Significance = UErosSignificanceSubsystem::Get(this))
+	{
+		Significance->RegisterCharacter(this);
+	}
+
 	UE_LOG(LogTemplateCharacter, Warning, TEXT("AErosSocialCharacter::BeginPlay - Character initialized"));
 }
 
+void AErosSocialCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UErosProximitySubsystem* Proximity = UErosProximitySubsystem::Get(this))
+	{
+		Proximity->UnregisterCharacter(this);
+	}
+
+	if (UErosSignificanceSubsystem* Significance = UErosSignificanceSubsystem::Get(this))
+	{
+		Significance->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AErosSocialCharacter::PossessedBy(AController* NewController)
 {
+	EROS_SPAWN_STAGE_SCOPE(PossessedBy);
+
 	Super::PossessedBy(NewController);
 
 	// Sincronizar com PlayerState quando possed
 	SyncWithPlayerState();
 }
 
+void AErosSocialCharacter::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	MorphComponent->SetUseBakedMesh(!IsLocallyControlled());
+}
+
+void AErosSocialCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(AErosSocialCharacter, NetUpdateRate, COND_SimulatedOnly);
+	DOREPLIFETIME(AErosSocialCharacter, ReplicatedAppearance);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Network
+
+bool AErosSocialCharacter::SetAdaptiveNetUpdateFrequency(float Frequency)
+{
+	if (FMath::IsNearlyEqual(NetUpdateFrequency, Frequency))
+	{
+		return false;
+	}
+
+	NetUpdateFrequency = Frequency;
+	NetUpdateRate = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Frequency), 1, 255));
+
+	// Listen server tambm suaviza os proxies dos outros jogadores
+	ApplyNetUpdateRateSmoothing();
+	return true;
+}
+
+void AErosSocialCharacter::OnRep_NetUpdateRate()
+{
+	ApplyNetUpdateRateSmoothing();
+}
+
+void AErosSocialCharacter::OnRep_ReplicatedAppearance(const FErosAppearanceDescriptor& OldAppearance)
+{
+	ReplicatedAppearance.UpdateHash();
+
+	// Antes do BeginPlay o mesh e a tabela ainda no esto prontos; o BeginPlay aplica tudo
+	if (!HasActorBegunPlay() || !ReplicatedAppearance.IsValid() || ReplicatedAppearance.GetHash() == AppliedAppearanceHash)
+	{
+		return;
+	}
+
+	const bool bFirstApply = AppliedAppearanceHash == 0 || !OldAppearance.IsValid();
+	ApplyReplicatedAppearance(bFirstApply || !ReplicatedAppearance.HasSameMorphs(OldAppearance),
+		bFirstApply || !ReplicatedAppearance.HasSameColors(OldAppearance));
+}
+
+void AErosSocialCharacter::UpdateReplicatedAppearance()
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	// Mesmo contedo quantizado: nada sujo para a replicao
+	const FErosAppearanceDescriptor NewAppearance = FErosAppearanceDescriptor::Pack(
+		CurrentCharacterData.BodyCustomization, CurrentCharacterData.AppearanceCustomization, EnsureMorphSetup());
+	if (NewAppearance.GetHash() != ReplicatedAppearance.GetHash())
+	{
+		ReplicatedAppearance = NewAppearance;
+		AppliedAppearanceHash = NewAppearance.GetHash();
+	}
+}
+
+void AErosSocialCharacter::ApplyReplicatedAppearance(bool bUpdateMorphs, bool bUpdateColors)
+{
+	FBodyCustomization BodyCustomization;
+	FAppearanceCustomization AppearanceCustomization;
+	ReplicatedAppearance.Unpack(BodyCustomization, AppearanceCustomization, EnsureMorphSetup());
+
+	AppliedAppearanceHash = ReplicatedAppearance.GetHash();
+	ApplyCustomizationChanges(BodyCustomization, AppearanceCustomization, bUpdateMorphs, bUpdateColors);
+
+	UE_LOG(LogTemplateCharacter, Verbose, TEXT("AErosSocialCharacter::ApplyReplicatedAppearance - Applied appearance %08x (morphs: %d, colors: %d)"),
+		AppliedAppearanceHash, bUpdateMorphs, bUpdateColors);
+}
+
+void AErosSocialCharacter::ApplyNetUpdateRateSmoothing()
+{
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	const UCharacterMovementComponent* DefaultMovement = GetClass()->GetDefaultObject<AErosSocialCharacter>()->GetCharacterMovement();
+	if (!Movement || !DefaultMovement)
+	{
+		return;
+	}
+
+	// Suavizao mais curta que o intervalo entre updates faz o proxy parar e dar saltos
+	const float SmoothTime = FMath::Min(1.5f / FMath::Max<uint8>(NetUpdateRate, 1), 0.5f);
+
+	Movement->NetworkSimulatedSmoothLocationTime = FMath::Max(DefaultMovement->NetworkSimulatedSmoothLocationTime, SmoothTime);
+	Movement->NetworkSimulatedSmoothRotationTime = FMath::Max(DefaultMovement->NetworkSimulatedSmoothRotationTime, SmoothTime);
+	Movement->ListenServerNetworkSimulatedSmoothLocationTime = FMath::Max(DefaultMovement->ListenServerNetworkSimulatedSmoothLocationTime, SmoothTime);
+	Movement->ListenServerNetworkSimulatedSmoothRotationTime = FMath::Max(DefaultMovement->ListenServerNetworkSimulatedSmoothRotationTime, SmoothTime);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Customization
 
 void AErosSocialCharacter::InitializeCharacter(const FCharacterSaveData& CharacterData)
 {
+	EROS_SPAWN_STAGE_SCOPE(InitializeCharacter);
+
 	CurrentCharacterData = CharacterData;
 
 	// Aplicar customizaes de corpo
@@ -105,34 +273,61 @@ void AErosSocialCharacter::InitializeCharacter(const FCharacterSaveData& Charact
 
 void AErosSocialCharacter::ApplyBodyCustomization(const FBodyCustomization& BodyCustomization)
 {
+	EROS_SPAWN_STAGE_SCOPE(BodyCustomization);
+
 	// Armazenar os valores dos morphs
-	BreastSizeMorph = BodyCustomization.BreastSize;
-	ButtSizeMorph = BodyCustomization.ButtSize;
-	HeightMorph = BodyCustomization.Height;
-	WeightMorph = BodyCustomization.Weight;
-	MuscleMorph = BodyCustomization.Muscle;
+	CurrentCharacterData.BodyCustomization = BodyCustomization;
 
 	// Atualizar morphs no skeletal mesh
 	UpdateMorphTargets();
+	UpdateReplicatedAppearance();
 
-	UE_LOG(LogTemplateCharacter, Warning, TEXT("AErosSocialCharacter::ApplyBodyCustomization - Applied body morphs"));
+	UE_LOG(LogTemplateCharacter, Verbose, TEXT("AErosSocialCharacter::ApplyBodyCustomization - Applied body morphs"));
 }
 
 void AErosSocialCharacter::ApplyAppearanceCustomization(const FAppearanceCustomization& AppearanceCustomization)
 {
-	// Aplicar cor de pele
-	ApplySkinColor(AppearanceCustomization.SkinColor);
+	EROS_SPAWN_STAGE_SCOPE(AppearanceCustomization);
+
+	CurrentCharacterData.AppearanceCustomization = AppearanceCustomization;
+
+	// Preset de rosto e overrides
+	UpdateMorphTargets();
+
+	// Cores e densidade de pelos
+	ApplyAppearanceColors(AppearanceCustomization);
+
+	UpdateReplicatedAppearance();
+
+	UE_LOG(LogTemplateCharacter, Verbose, TEXT("AErosSocialCharacter::ApplyAppearanceCustomization - Applied appearance"));
+}
+
+void AErosSocialCharacter::ApplyCustomizationChanges(const FBodyCustomization& BodyCustomization, const FAppearanceCustomization& AppearanceCustomization,
+	bool bUpdateMorphs, bool bUpdateColors)
+{
+	CurrentCharacterData.BodyCustomization = BodyCustomization;
+	CurrentCharacterData.AppearanceCustomization = AppearanceCustomization;
 
-	// Aplicar cor de cabelo
-	ApplyHairColor(AppearanceCustomization.HairColor);
+	// O morph component s envia os pesos que mudaram
+	if (bUpdateMorphs)
+	{
+		UpdateMorphTargets();
+	}
 
-	// Outros parmetros de aparncia podem ser adicionados aqui
+	// S os vec4 de custom primitive data que mudaram
+	if (bUpdateColors)
+	{
+		ApplyAppearanceColors(AppearanceCustomization);
+	}
 
-	UE_LOG(LogTemplateCharacter, Warning, TEXT("AErosSocialCharacter::ApplyAppearanceCustomization - Applied appearance"));
+	// Penteado tambm muda o descritor; contedo igual no suja a replicao
+	UpdateReplicatedAppearance();
 }
 
 void AErosSocialCharacter::SyncWithPlayerState()
 {
+	EROS_SPAWN_STAGE_SCOPE(SyncWithPlayerState);
+
 	if (!PlayerStateRef)
 	{
 		PlayerStateRef = Cast<AErosSocialPlayerState>(GetPlayerState());
@@ -150,40 +345,90 @@ void AErosSocialCharacter::SyncWithPlayerState()
 	}
 }
 
-void AErosSocialCharacter::UpdateMorphTargets()
+UErosMorphTable* AErosSocialCharacter::EnsureMorphSetup()
 {
-	// Obter o skeletal mesh
-	USkeletalMeshComponent* MeshComponent = GetMesh();
-	if (!MeshComponent)
+	if (!MorphComponent)
 	{
-		return;
+		return nullptr;
 	}
 
-	// Aplicar morphs (estes nomes precisam existir no skeleton)
-	MeshComponent->SetMorphTarget(FName("BreastSize"), BreastSizeMorph);
-	MeshComponent->SetMorphTarget(FName("ButtSize"), ButtSizeMorph);
-	MeshComponent->SetMorphTarget(FName("Height"), HeightMorph);
-	MeshComponent->SetMorphTarget(FName("Weight"), WeightMorph);
-	MeshComponent->SetMorphTarget(FName("Muscle"), MuscleMorph);
+	UErosMorphTable* Table = MorphComponent->GetMorphTable();
+	if (!Table)
+	{
+		// Sem tabela configurada: s os sliders do corpo
+		Table = NewObject<UErosMorphTable>(this, TEXT("BodyMorphTable"), RF_Transient);
+		for (const FName& MorphName : GetBodyMorphNames())
+		{
+			Table->AddMorph(MorphName, 0.5f);
+		}
+		MorphComponent->SetMorphTable(Table);
+		BodyMorphSlots.Reset();
+	}
+
+	if (BodyMorphSlots.Num() != GetBodyMorphNames().Num())
+	{
+		MorphComponent->SetTargetMesh(GetMesh());
+
+		BodyMorphSlots.Reset();
+		for (const FName& MorphName : GetBodyMorphNames())
+		{
+			BodyMorphSlots.Add(Table->FindSlot(MorphName));
+		}
+	}
 
-	UE_LOG(LogTemplateCharacter, Log, TEXT("AErosSocialCharacter::UpdateMorphTargets - Updated morph targets"));
+	return Table;
 }
 
-void AErosSocialCharacter::ApplySkinColor(const FLinearColor& SkinColor)
+void AErosSocialCharacter::UpdateMorphTargets()
 {
-	USkeletalMeshComponent* MeshComponent = GetMesh();
-	if (!MeshComponent)
+	const UErosMorphTable* Table = EnsureMorphSetup();
+	if (!Table)
 	{
 		return;
 	}
 
-	// Criar material dinmico para pele
-	// Isto ser implementado quando voc tiver o material de pele configurado
+	const FAppearanceCustomization& Appearance = CurrentCharacterData.AppearanceCustomization;
+	FErosMorphBlendLayers Layers;
+
+	// Rosto: preset escolhido e depois os presets misturados (customizao)
+	Layers.Layers.Emplace(Table->GetFacePresetLayer(Appearance.FacePresetID), 1.0f);
+	for (const TPair<FString, float>& Pair : FacePresetBlend)
+	{
+		Layers.Layers.Emplace(Table->GetFacePresetLayer(Pair.Key), FMath::Clamp(Pair.Value, 0.0f, 1.0f));
+	}
+
+	// Corpo
+	const FBodyCustomization& Body = CurrentCharacterData.BodyCustomization;
+	const float BodyValues[] = { Body.BreastSize, Body.ButtSize, Body.Height, Body.Weight, Body.Muscle };
+	static_assert(UE_ARRAY_COUNT(BodyValues) == 5, "Um valor por nome em GetBodyMorphNames");
+
+	TSharedRef<FErosMorphLayer, ESPMode::ThreadSafe> BodyLayer = MakeShared<FErosMorphLayer, ESPMode::ThreadSafe>();
+	BodyLayer->Init(Table->Num());
+	for (int32 Index = 0; Index < BodyMorphSlots.Num(); ++Index)
+	{
+		BodyLayer->Set(BodyMorphSlots[Index], BodyValues[Index]);
+	}
+	Layers.Layers.Emplace(BodyLayer, 1.0f);
+
+	// Overrides do jogador por ltimo
+	if (Appearance.FaceMorphOverrides.Num() > 0)
+	{
+		TSharedRef<FErosMorphLayer, ESPMode::ThreadSafe> OverrideLayer = MakeShared<FErosMorphLayer, ESPMode::ThreadSafe>();
+		OverrideLayer->SetFromMap(*Table, Appearance.FaceMorphOverrides);
+		Layers.Layers.Emplace(OverrideLayer, 1.0f);
+	}
 
-	UE_LOG(LogTemplateCharacter, Log, TEXT("AErosSocialCharacter::ApplySkinColor - Applied skin color"));
+	// Blend em lote no fim do frame; s os pesos que mudaram ficam sujos
+	MorphComponent->SetBlendLayers(MoveTemp(Layers));
+}
+
+void AErosSocialCharacter::BlendFacePresets(const TMap<FString, float>& PresetWeights)
+{
+	FacePresetBlend = PresetWeights;
+	UpdateMorphTargets();
 }
 
-void AErosSocialCharacter::ApplyHairColor(const FLinearColor& HairColor)
+void AErosSocialCharacter::ApplyAppearanceColors(const FAppearanceCustomization& AppearanceCustomization)
 {
 	USkeletalMeshComponent* MeshComponent = GetMesh();
 	if (!MeshComponent)
@@ -191,10 +436,21 @@ void AErosSocialCharacter::ApplyHairColor(const FLinearColor& HairColor)
 		return;
 	}
 
-	// Criar material dinmico para cabelo
-	// Isto ser implementado quando voc tiver o material de cabelo configurado
+	const FErosAppearancePrimitiveData PrimitiveData = FErosAppearancePrimitiveData::Pack(AppearanceCustomization);
+	PrimitiveData.ApplyToComponent(*MeshComponent);
 
-	UE_LOG(LogTemplateCharacter, Log, TEXT("AErosSocialCharacter::ApplyHairColor - Applied hair color"));
+	// Cabelo, roupas e acessrios presos no mesh leem o mesmo layout
+	TArray<USceneComponent*> Children;
+	MeshComponent->GetChildrenComponents(true, Children);
+	for (USceneComponent* Child : Children)
+	{
+		if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Child))
+		{
+			PrimitiveData.ApplyToComponent(*Primitive);
+		}
+	}
+
+	UE_LOG(LogTemplateCharacter, Verbose, TEXT("AErosSocialCharacter::ApplyAppearanceColors - Applied colors to %d components"), Children.Num() + 1);
 }
 
 void AErosSocialCharacter::OnCharacterDataReceived()
@@ -221,7 +477,7 @@ void AErosSocialCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInpu
 	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent))
 	{
 		// Jumping
-		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &ACharacter::Jump);
+		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &AErosSocialCharacter::Jump);
 		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Completed, this, &ACharacter::StopJumping);
 
 		// Moving
@@ -250,6 +506,8 @@ void AErosSocialCharacter::Move(const FInputActionValue& Value)
 
 		AddMovementInput(ForwardDirection, MovementVector.Y);
 		AddMovementInput(RightDirection, MovementVector.X);
+
+		WakeFromNetIdleIfNeeded();
 	}
 }
 
@@ -261,5 +519,27 @@ void AErosSocialCharacter::Look(const FInputActionValue& Value)
 	{
 		AddControllerYawInput(LookAxisVector.X);
 		AddControllerPitchInput(LookAxisVector.Y);
+
+		WakeFromNetIdleIfNeeded();
+	}
+}
+
+void AErosSocialCharacter::Jump()
+{
+	WakeFromNetIdleIfNeeded();
+
+	Super::Jump();
+}
+
+void AErosSocialCharacter::WakeFromNetIdleIfNeeded()
+{
+	// O servidor s volta a receber o movimento (e a rotao) depois de acordar
+	const AErosSocialPlayerState* ErosPlayerState = GetPlayerState<AErosSocialPlayerState>();
+	if (ErosPlayerState && ErosPlayerState->IsNetIdle())
+	{
+		if (AErosSocialPlayerController* ErosController = Cast<AErosSocialPlayerController>(Controller))
+		{
+			ErosController->RequestWakeFromNetIdle();
+		}
 	}
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "GameFramework/Character.h"
 #include "Logging/LogMacros.h"
 #include "CharacterSaveData.h"
+#include "Systems/Customization/ErosAppearanceDescriptor.h"
 #include "ErosSocialCharacter.generated.h"
 
 class USpringArmComponent;
@@ -13,6 +14,8 @@ class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
 class UClothingSystem;
+class UErosMorphComponent;
+class UErosMorphTable;
 class AErosSocialPlayerState;
 struct FInputActionValue;
 
@@ -70,12 +73,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Character|Customization")
 	void ApplyAppearanceCustomization(const FAppearanceCustomization& AppearanceCustomization);
 
+	/**
+	 * Aplica corpo e aparncia recalculando s morphs e/ou cores conforme o que mudou
+	 * Usado pelo preview da customizao (uma vez por frame) e pela aparncia replicada
+	 */
+	void ApplyCustomizationChanges(const FBodyCustomization& BodyCustomization, const FAppearanceCustomization& AppearanceCustomization,
+		bool bUpdateMorphs, bool bUpdateColors);
+
 	/**
 	 * Obtm o sistema de roupas
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Character|Clothing")
 	class UClothingSystem* GetClothingSystem() const { return ClothingSystem; }
 
+	/**
+	 * Obtm os pesos de morph do personagem
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Morphs")
+	UErosMorphComponent* GetMorphComponent() const { return MorphComponent; }
+
+	/**
+	 * Mistura outros presets de rosto sobre o FacePresetID (ID -> peso 0..1, aplicados em ordem)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Customization")
+	void BlendFacePresets(const TMap<FString, float>& PresetWeights);
+
 	/**
 	 * Obtm os dados do personagem atual
 	 */
@@ -88,6 +110,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Character|Sync")
 	void SyncWithPlayerState();
 
+	// ========== REDE ==========
+
+	/**
+	 * Define a taxa de replicao (servidor, chamado pelo UErosNetUpdateRateManager)
+	 * Retorna false se a taxa j era essa
+	 */
+	bool SetAdaptiveNetUpdateFrequency(float Frequency);
+
 protected:
 
 	/** Called for movement input */
@@ -96,11 +126,21 @@ protected:
 	/** Called for looking input */
 	void Look(const FInputActionValue& Value);
 
+	/** Called for jump input (acorda o pawn dormente como Move e Look) */
+	virtual void Jump() override;
+
+	/** Pawn dormente por inatividade: pede ao servidor para acordar antes do input chegar nele */
+	void WakeFromNetIdleIfNeeded();
+
 	// ========== COMPONENTES ==========
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character|Clothing")
 	class UClothingSystem* ClothingSystem;
 
+	// Tabela de morphs definida no componente (Blueprint); sem tabela, usa s os morphs do corpo
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character|Morphs")
+	TObjectPtr<UErosMorphComponent> MorphComponent;
+
 	// ========== DADOS DO PERSONAGEM ==========
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character|Data")
@@ -109,33 +149,56 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character|Data")
 	AErosSocialPlayerState* PlayerStateRef;
 
-	// ========== MORPHS DO CORPO (Variveis para controlar morphs) ==========
+	// ========== FUNES PRIVADAS ==========
+
+	UFUNCTION()
+	void OnCharacterDataReceived();
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character|Morphs")
-	float BreastSizeMorph = 0.5f;
+	/**
+	 * Recalcula os pesos (padres da tabela, presets de rosto, corpo, overrides) como camadas densas
+	 * O blend roda em lote (UErosMorphBlendSubsystem) e s os pesos que mudaram vo para o mesh
+	 */
+	void UpdateMorphTargets();
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character|Morphs")
-	float ButtSizeMorph = 0.5f;
+	/** Tabela e mesh do MorphComponent; resolve os slots dos sliders do corpo */
+	UErosMorphTable* EnsureMorphSetup();
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character|Morphs")
-	float HeightMorph = 0.5f;
+	// Slot de cada slider do FBodyCustomization (ordem de GetBodyMorphNames)
+	TArray<int32> BodyMorphSlots;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character|Morphs")
-	float WeightMorph = 0.5f;
+	// Presets extras sobre o FacePresetID (BlendFacePresets)
+	TMap<FString, float> FacePresetBlend;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character|Morphs")
-	float MuscleMorph = 0.5f;
+	/**
+	 * Cores de pele, cabelo, olhos, maquiagem e densidade de pelos no custom primitive data
+	 * do mesh e dos componentes presos nele (materiais compartilhados entre todos os avatares)
+	 */
+	void ApplyAppearanceColors(const FAppearanceCustomization& AppearanceCustomization);
 
-	// ========== FUNES PRIVADAS ==========
+	// Taxa de replicao atual (Hz) para os simulated proxies ajustarem a suavizao
+	UPROPERTY(ReplicatedUsing = OnRep_NetUpdateRate)
+	uint8 NetUpdateRate;
 
 	UFUNCTION()
-	void OnCharacterDataReceived();
+	void OnRep_NetUpdateRate();
 
-	void UpdateMorphTargets();
+	void ApplyNetUpdateRateSmoothing();
+
+	// Corpo e aparncia quantizados para os outros jogadores (entrada completa, depois delta)
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedAppearance)
+	FErosAppearanceDescriptor ReplicatedAppearance;
+
+	UFUNCTION()
+	void OnRep_ReplicatedAppearance(const FErosAppearanceDescriptor& OldAppearance);
 
-	void ApplySkinColor(const FLinearColor& SkinColor);
+	/** Servidor: reempacota CurrentCharacterData depois de qualquer mudana de customizao */
+	void UpdateReplicatedAppearance();
 
-	void ApplyHairColor(const FLinearColor& HairColor);
+	/** Clientes: aplica o descritor recebido pelo caminho normal de customizao */
+	void ApplyReplicatedAppearance(bool bUpdateMorphs, bool bUpdateColors);
+
+	// Hash do ltimo descritor aplicado (ignora reenvios iguais)
+	uint32 AppliedAppearanceHash = 0;
 
 protected:
 	// APawn interface
@@ -144,8 +207,15 @@ protected:
 	// To add mapping context
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void PossessedBy(AController* NewController) override;
 
+	// Jogador local fica nos morphs ao vivo; avatares remotos podem usar o mesh assado
+	virtual void NotifyControllerChanged() override;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 public:
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
@@ -7,7 +7,6 @@
 
 UErosSocialGameInstance::UErosSocialGameInstance()
 	: Username(TEXT(""))
-	, UserID(TEXT(""))
 	, bIsLoggedIn(false)
 	, SelectedCharacterSlot(-1)
 	, CharacterManager(nullptr)
@@ -44,13 +43,19 @@ void UErosSocialGameInstance::InitializeManagers()
 void UErosSocialGameInstance::SetUserLoggedIn(const FString& InUsername, const FString& InUserID)
 {
 	Username = InUsername;
-	UserID = InUserID;
+	UserID = FErosUserId::FromString(InUserID);
 	bIsLoggedIn = true;
 
+	// Saves de antes do FErosUserId ficavam numa pasta com o nome da string do login
+	if (SaveGameManager)
+	{
+		SaveGameManager->MigrateLegacySaveDirectory(InUserID, UserID);
+	}
+
 	// Inicializar CharacterManager com o UserID
 	if (CharacterManager)
 	{
-		CharacterManager->Initialize(InUserID);
+		CharacterManager->Initialize(UserID);
 	}
 
 	UE_LOG(LogTemp, Warning, TEXT("ErosSocialGameInstance::SetUserLoggedIn - User logged in: %s (ID: %s)"),
@@ -60,7 +65,7 @@ void UErosSocialGameInstance::SetUserLoggedIn(const FString& InUsername, const F
 void UErosSocialGameInstance::Logout()
 {
 	Username = TEXT("");
-	UserID = TEXT("");
+	UserID.Invalidate();
 	bIsLoggedIn = false;
 	SelectedCharacterSlot = -1;
 	SelectedCharacter = FCharacterSaveData();
@@ -69,7 +74,7 @@ void UErosSocialGameInstance::Logout()
 	UE_LOG(LogTemp, Warning, TEXT("ErosSocialGameInstance::Logout - User logged out"));
 }
 
-bool UErosSocialGameInstance::CreateCharacter(const FString& CharacterName, const FString& CharacterGender)
+bool UErosSocialGameInstance::CreateCharacter(const FString& CharacterName, ECharacterGender CharacterGender)
 {
 	if (!bIsLoggedIn || !CharacterManager)
 	{
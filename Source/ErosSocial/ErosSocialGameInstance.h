@@ -7,6 +7,7 @@
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
 #include "CharacterSaveData.h"
+#include "ErosUserId.h"
 #include "ErosSocialGameInstance.generated.h"
 
 class UCharacterManager;
@@ -31,6 +32,7 @@ public:
 
 	/**
 	 * Define usurio logado
+	 * O UserID do login  convertido uma nica vez para FErosUserId
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Authentication")
 	void SetUserLoggedIn(const FString& InUsername, const FString& InUserID);
@@ -51,7 +53,13 @@ public:
 	 * Obtm o UserID atual
 	 */
 	UFUNCTION(BlueprintPure, Category = "Authentication")
-	FString GetUserID() const { return UserID; }
+	FErosUserId GetUserID() const { return UserID; }
+
+	/**
+	 * UserID em texto (32 dgitos hex), para Blueprints que usavam o antigo GetUserID em FString
+	 */
+	UFUNCTION(BlueprintPure, Category = "Authentication")
+	FString GetUserIDString() const { return UserID.ToString(); }
 
 	// ========== GERENCIAMENTO DE PERSONAGENS ==========
 
@@ -59,7 +67,7 @@ public:
 	 * Cria um novo personagem
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Character")
-	bool CreateCharacter(const FString& CharacterName, const FString& CharacterGender);
+	bool CreateCharacter(const FString& CharacterName, ECharacterGender CharacterGender);
 
 	/**
 	 * Carrega todos os personagens do usurio
@@ -161,7 +169,7 @@ protected:
 	FString Username;
 
 	UPROPERTY(VisibleAnywhere, Category = "Authentication")
-	FString UserID;
+	FErosUserId UserID;
 
 	UPROPERTY(VisibleAnywhere, Category = "Authentication")
 	bool bIsLoggedIn;
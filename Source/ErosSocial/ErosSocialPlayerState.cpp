@@ -3,18 +3,20 @@
 #include "ErosSocialPlayerState.h"
 #include "Net/UnrealNetwork.h"
 #include "TimerManager.h"
+#include "GameFramework/Pawn.h"
 
 AErosSocialPlayerState::AErosSocialPlayerState()
 {
     CharacterName = TEXT("");
-    CharacterGender = TEXT("Male");
-    UserID = TEXT("");
+    CharacterGender = ECharacterGender::Male;
     CharacterSlot = -1;
     PlayerStatus = EPlayerStatus::Online;
     bHasPartner = false;
     PartnerPlayerState = nullptr;
-    PartnerName = TEXT("");
     LastActivityTime = 0.0f;
+    IdleDormancyDelay = 60.0f;
+    bNetIdle = false;
+    LastSampledPawnLocation = FVector::ZeroVector;
 }
 
 void AErosSocialPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -30,8 +32,9 @@ void AErosSocialPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty
     DOREPLIFETIME(AErosSocialPlayerState, LastActivityTime);
     DOREPLIFETIME(AErosSocialPlayerState, bHasPartner);
     DOREPLIFETIME(AErosSocialPlayerState, PartnerPlayerState);
-    DOREPLIFETIME(AErosSocialPlayerState, PartnerName);
+    DOREPLIFETIME(AErosSocialPlayerState, PartnerUserID);
     DOREPLIFETIME(AErosSocialPlayerState, FriendsList);
+    DOREPLIFETIME_CONDITION(AErosSocialPlayerState, bNetIdle, COND_OwnerOnly);
 }
 
 void AErosSocialPlayerState::BeginPlay()
@@ -53,20 +56,30 @@ void AErosSocialPlayerState::BeginPlay()
     UpdateActivity();
 }
 
-void AErosSocialPlayerState::InitializeCharacter(const FString& InCharacterName, const FString& InGender, const FString& InUserID)
+void AErosSocialPlayerState::InitializeCharacter(const FString& InCharacterName, ECharacterGender InGender, const FErosUserId& InUserID)
 {
     CharacterName = InCharacterName;
     CharacterGender = InGender;
     UserID = InUserID;
     PlayerStatus = EPlayerStatus::Online;
 
-    UE_LOG(LogTemp, Warning, TEXT("Character initialized: %s (%s)"), *CharacterName, *CharacterGender);
+    UE_LOG(LogTemp, Warning, TEXT("Character initialized: %s (%s)"), *CharacterName, LexToString(CharacterGender));
 }
 
 void AErosSocialPlayerState::SetPlayerStatus(EPlayerStatus NewStatus)
 {
+    const bool bStatusChanged = PlayerStatus != NewStatus;
     PlayerStatus = NewStatus;
 
+    if (NewStatus == EPlayerStatus::AFK)
+    {
+        EnterNetIdle();
+    }
+    else if (bStatusChanged)
+    {
+        WakeFromNetIdle();
+    }
+
     UE_LOG(LogTemp, Log, TEXT("Player %s status changed to: %s"),
         *CharacterName, *GetStatusAsString());
 }
@@ -87,6 +100,8 @@ void AErosSocialPlayerState::UpdateActivity()
 {
     LastActivityTime = GetWorld()->GetTimeSeconds();
 
+    WakeFromNetIdle();
+
     // Se estava AFK e voltou a atividade, muda status
     if (PlayerStatus == EPlayerStatus::AFK)
     {
@@ -98,6 +113,17 @@ void AErosSocialPlayerState::CheckAFK()
 {
     if (!GetWorld()) return;
 
+    // Personagem que andou desde a ltima verificao conta como atividade
+    if (APawn* Pawn = GetPawn())
+    {
+        const FVector PawnLocation = Pawn->GetActorLocation();
+        if (!PawnLocation.Equals(LastSampledPawnLocation, 10.0f))
+        {
+            LastSampledPawnLocation = PawnLocation;
+            UpdateActivity();
+        }
+    }
+
     float CurrentTime = GetWorld()->GetTimeSeconds();
     float TimeSinceLastActivity = CurrentTime - LastActivityTime;
 
@@ -107,19 +133,65 @@ void AErosSocialPlayerState::CheckAFK()
         SetPlayerStatus(EPlayerStatus::AFK);
         UE_LOG(LogTemp, Warning, TEXT("Player %s is now AFK"), *CharacterName);
     }
+
+    // Parado h algum tempo (mesmo sem estar AFK): para de replicar
+    if (TimeSinceLastActivity > IdleDormancyDelay)
+    {
+        EnterNetIdle();
+    }
+}
+
+void AErosSocialPlayerState::EnterNetIdle()
+{
+    if (!HasAuthority() || bNetIdle)
+    {
+        return;
+    }
+
+    // bNetIdle e o ltimo estado so enviados antes do canal fechar
+    bNetIdle = true;
+    ForceNetUpdate();
+    SetNetDormancy(DORM_DormantAll);
+
+    if (APawn* Pawn = GetPawn())
+    {
+        Pawn->SetNetDormancy(DORM_DormantAll);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Player %s is now net idle"), *CharacterName);
+}
+
+void AErosSocialPlayerState::WakeFromNetIdle()
+{
+    if (!HasAuthority() || !bNetIdle)
+    {
+        return;
+    }
+
+    bNetIdle = false;
+    SetNetDormancy(DORM_Awake);
+
+    if (APawn* Pawn = GetPawn())
+    {
+        Pawn->SetNetDormancy(DORM_Awake);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Player %s woke from net idle"), *CharacterName);
 }
 
 void AErosSocialPlayerState::SetPartner(AErosSocialPlayerState* NewPartner)
 {
     if (NewPartner && NewPartner != this)
     {
+        WakeFromNetIdle();
+
         PartnerPlayerState = NewPartner;
-        PartnerName = NewPartner->CharacterName;
+        PartnerUserID = NewPartner->UserID;
         bHasPartner = true;
         SetPlayerStatus(EPlayerStatus::InPartner);
 
         UE_LOG(LogTemp, Warning, TEXT("%s is now partnered with %s"),
-            *CharacterName, *PartnerName);
+            *CharacterName, *NewPartner->CharacterName);
     }
 }
 
@@ -128,34 +200,42 @@ void AErosSocialPlayerState::RemovePartner()
     if (bHasPartner)
     {
         UE_LOG(LogTemp, Warning, TEXT("%s partnership with %s ended"),
-            *CharacterName, *PartnerName);
+            *CharacterName, *GetPartnerName());
+
+        WakeFromNetIdle();
 
         PartnerPlayerState = nullptr;
-        PartnerName = TEXT("");
+        PartnerUserID.Invalidate();
         bHasPartner = false;
         SetPlayerStatus(EPlayerStatus::Online);
     }
 }
 
-void AErosSocialPlayerState::AddFriend(const FString& FriendUserID)
+FString AErosSocialPlayerState::GetPartnerName() const
+{
+    return PartnerPlayerState ? PartnerPlayerState->CharacterName : FString();
+}
+
+void AErosSocialPlayerState::AddFriend(const FErosUserId& FriendUserID)
 {
-    if (!FriendUserID.IsEmpty() && !FriendsList.Contains(FriendUserID))
+    if (FriendUserID.IsValid() && !FriendsList.Contains(FriendUserID))
     {
+        WakeFromNetIdle();
         FriendsList.Add(FriendUserID);
-        UE_LOG(LogTemp, Log, TEXT("%s added friend: %s"), *CharacterName, *FriendUserID);
+        UE_LOG(LogTemp, Log, TEXT("%s added friend: %s"), *CharacterName, *FriendUserID.ToString());
     }
 }
 
-void AErosSocialPlayerState::RemoveFriend(const FString& FriendUserID)
+void AErosSocialPlayerState::RemoveFriend(const FErosUserId& FriendUserID)
 {
-    if (FriendsList.Contains(FriendUserID))
+    if (FriendsList.Remove(FriendUserID) > 0)
     {
-        FriendsList.Remove(FriendUserID);
-        UE_LOG(LogTemp, Log, TEXT("%s removed friend: %s"), *CharacterName, *FriendUserID);
+        WakeFromNetIdle();
+        UE_LOG(LogTemp, Log, TEXT("%s removed friend: %s"), *CharacterName, *FriendUserID.ToString());
     }
 }
 
-bool AErosSocialPlayerState::IsFriend(const FString& FriendUserID) const
+bool AErosSocialPlayerState::IsFriend(const FErosUserId& FriendUserID) const
 {
     return FriendsList.Contains(FriendUserID);
 }
\ No newline at end of file
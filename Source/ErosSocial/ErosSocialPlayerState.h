@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerState.h"
+#include "CharacterSaveData.h"
+#include "ErosUserId.h"
 #include "ErosSocialPlayerState.generated.h"
 
 UENUM(BlueprintType)
@@ -29,10 +31,10 @@ public:
     FString CharacterName;
 
     UPROPERTY(Replicated, BlueprintReadWrite, Category = "Character")
-    FString CharacterGender;
+    ECharacterGender CharacterGender;
 
     UPROPERTY(Replicated, BlueprintReadWrite, Category = "Character")
-    FString UserID;
+    FErosUserId UserID;
 
     // ✅ ADICIONADO: CharacterSlot
     UPROPERTY(Replicated, BlueprintReadWrite, Category = "Character")
@@ -54,18 +56,19 @@ public:
     UPROPERTY(Replicated, BlueprintReadWrite, Category = "Partner")
     AErosSocialPlayerState* PartnerPlayerState;
 
+    // Nome do partner vem de PartnerPlayerState; replicamos só o ID compacto
     UPROPERTY(Replicated, BlueprintReadWrite, Category = "Partner")
-    FString PartnerName;
+    FErosUserId PartnerUserID;
 
     // ========== SISTEMA SOCIAL ==========
 
     UPROPERTY(Replicated, BlueprintReadWrite, Category = "Social")
-    TArray<FString> FriendsList;
+    TArray<FErosUserId> FriendsList;
 
     // ========== FUNÇÕES PÚBLICAS ==========
 
     UFUNCTION(BlueprintCallable, Category = "Character")
-    void InitializeCharacter(const FString& InCharacterName, const FString& InGender, const FString& InUserID);
+    void InitializeCharacter(const FString& InCharacterName, ECharacterGender InGender, const FErosUserId& InUserID);
 
     UFUNCTION(BlueprintCallable, Category = "Status")
     void SetPlayerStatus(EPlayerStatus NewStatus);
@@ -94,19 +97,43 @@ public:
     UFUNCTION(BlueprintPure, Category = "Partner")
     AErosSocialPlayerState* GetPartner() const { return PartnerPlayerState; }
 
+    UFUNCTION(BlueprintPure, Category = "Partner")
+    FString GetPartnerName() const;
+
     UFUNCTION(BlueprintCallable, Category = "Social")
-    void AddFriend(const FString& FriendUserID);
+    void AddFriend(const FErosUserId& FriendUserID);
 
     UFUNCTION(BlueprintCallable, Category = "Social")
-    void RemoveFriend(const FString& FriendUserID);
+    void RemoveFriend(const FErosUserId& FriendUserID);
 
     UFUNCTION(BlueprintPure, Category = "Social")
-    bool IsFriend(const FString& FriendUserID) const;
+    bool IsFriend(const FErosUserId& FriendUserID) const;
+
+    // ========== DORMÊNCIA DE REDE ==========
+
+    // Sem atividade por esse tempo, PlayerState e personagem param de replicar (dormência)
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Network")
+    float IdleDormancyDelay;
+
+    UFUNCTION(BlueprintPure, Category = "Network")
+    bool IsNetIdle() const { return bNetIdle; }
+
+    /** Coloca PlayerState e pawn em dormência (somente servidor) */
+    void EnterNetIdle();
+
+    /** Acorda PlayerState e pawn (somente servidor) */
+    void WakeFromNetIdle();
 
 protected:
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
     virtual void BeginPlay() override;
 
+    // Replicado só para o dono: com o pawn dormente o cliente pede o wake pelo PlayerController
+    UPROPERTY(Replicated)
+    bool bNetIdle;
+
 private:
     FTimerHandle AFKCheckTimer;
+
+    FVector LastSampledPawnLocation;
 };
\ No newline at end of file
@@ -6,13 +6,12 @@
 
 UCharacterManager::UCharacterManager()
 	: SaveGameManager(nullptr)
-	, CurrentUserID(TEXT(""))
 {
 }
 
-void UCharacterManager::Initialize(const FString& InUserID)
+void UCharacterManager::Initialize(const FErosUserId& InUserID)
 {
-	if (InUserID.IsEmpty())
+	if (!InUserID.IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("CharacterManager::Initialize - UserID is empty!"));
 		return;
@@ -31,13 +30,13 @@ void UCharacterManager::Initialize(const FString& InUserID)
 		}
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("CharacterManager::Initialize - Initialized for UserID: %s"), *CurrentUserID);
+	UE_LOG(LogTemp, Warning, TEXT("CharacterManager::Initialize - Initialized for UserID: %s"), *CurrentUserID.ToString());
 }
 
-bool UCharacterManager::CreateCharacter(const FString& CharacterName, const FString& CharacterGender, int32& OutSlotIndex)
+bool UCharacterManager::CreateCharacter(const FString& CharacterName, ECharacterGender CharacterGender, int32& OutSlotIndex)
 {
 	// Validar inicialização
-	if (CurrentUserID.IsEmpty())
+	if (!CurrentUserID.IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("CharacterManager::CreateCharacter - Not initialized!"));
 		return false;
@@ -56,9 +55,9 @@ bool UCharacterManager::CreateCharacter(const FString& CharacterName, const FStr
 		return false;
 	}
 
-	if (CharacterGender != TEXT("Male") && CharacterGender != TEXT("Female"))
+	if (CharacterGender >= ECharacterGender::Count)
 	{
-		UE_LOG(LogTemp, Error, TEXT("CharacterManager::CreateCharacter - Invalid gender: %s"), *CharacterGender);
+		UE_LOG(LogTemp, Error, TEXT("CharacterManager::CreateCharacter - Invalid gender: %d"), (int32)CharacterGender);
 		return false;
 	}
 
@@ -111,7 +110,7 @@ bool UCharacterManager::CreateCharacter(const FString& CharacterName, const FStr
 
 bool UCharacterManager::LoadCharacter(int32 SlotIndex, FCharacterSaveData& OutCharacterData)
 {
-	if (CurrentUserID.IsEmpty() || !SaveGameManager)
+	if (!CurrentUserID.IsValid() || !SaveGameManager)
 	{
 		return false;
 	}
@@ -136,7 +135,7 @@ bool UCharacterManager::LoadCharacter(int32 SlotIndex, FCharacterSaveData& OutCh
 
 bool UCharacterManager::DeleteCharacter(int32 SlotIndex)
 {
-	if (CurrentUserID.IsEmpty() || !SaveGameManager)
+	if (!CurrentUserID.IsValid() || !SaveGameManager)
 	{
 		return false;
 	}
@@ -166,7 +165,7 @@ bool UCharacterManager::DeleteCharacter(int32 SlotIndex)
 
 bool UCharacterManager::LoadAllCharacters(TArray<FCharacterSaveData>& OutCharacters)
 {
-	if (CurrentUserID.IsEmpty() || !SaveGameManager)
+	if (!CurrentUserID.IsValid() || !SaveGameManager)
 	{
 		return false;
 	}
@@ -193,7 +192,7 @@ bool UCharacterManager::LoadAllCharacters(TArray<FCharacterSaveData>& OutCharact
 
 int32 UCharacterManager::GetCreatedCharacterCount()
 {
-	if (CurrentUserID.IsEmpty() || !SaveGameManager)
+	if (!CurrentUserID.IsValid() || !SaveGameManager)
 	{
 		return 0;
 	}
@@ -217,7 +216,7 @@ bool UCharacterManager::CanCreateNewCharacter()
 
 int32 UCharacterManager::GetNextAvailableSlot()
 {
-	if (CurrentUserID.IsEmpty() || !SaveGameManager)
+	if (!CurrentUserID.IsValid() || !SaveGameManager)
 	{
 		return -1;
 	}
@@ -235,7 +234,7 @@ int32 UCharacterManager::GetNextAvailableSlot()
 
 bool UCharacterManager::UpdateCharacter(int32 SlotIndex, const FCharacterSaveData& CharacterData)
 {
-	if (CurrentUserID.IsEmpty() || !SaveGameManager)
+	if (!CurrentUserID.IsValid() || !SaveGameManager)
 	{
 		return false;
 	}
@@ -291,7 +290,7 @@ bool UCharacterManager::ValidateCharacterName(const FString& CharacterName)
 
 bool UCharacterManager::CharacterExists(int32 SlotIndex)
 {
-	if (CurrentUserID.IsEmpty() || !SaveGameManager)
+	if (!CurrentUserID.IsValid() || !SaveGameManager)
 	{
 		return false;
 	}
@@ -299,7 +298,7 @@ bool UCharacterManager::CharacterExists(int32 SlotIndex)
 	return SaveGameManager->CharacterExists(CurrentUserID, SlotIndex);
 }
 
-FString UCharacterManager::GetCurrentUserID() const
+FErosUserId UCharacterManager::GetCurrentUserID() const
 {
 	return CurrentUserID;
 }
@@ -8,6 +8,7 @@
 #include "UObject/NoExportTypes.h"
 #include "CharacterSaveData.h"
 #include "SaveGameManager.h"
+#include "ErosUserId.h"
 #include "CharacterManager.generated.h"
 
 /**
@@ -28,19 +29,19 @@ public:
 	 * Inicializa o gerenciador com um UserID
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Character")
-	void Initialize(const FString& InUserID);
+	void Initialize(const FErosUserId& InUserID);
 
 	// ========== CRIAR PERSONAGEM ==========
 
 	/**
 	 * Cria um novo personagem
 	 * @param CharacterName - Nome do personagem
-	 * @param CharacterGender - Gênero (Male/Female)
+	 * @param CharacterGender - Gênero do personagem
 	 * @param OutSlotIndex - Índice do slot onde foi criado (0 ou 1)
 	 * @return true se criou com sucesso
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Character")
-	bool CreateCharacter(const FString& CharacterName, const FString& CharacterGender, int32& OutSlotIndex);
+	bool CreateCharacter(const FString& CharacterName, ECharacterGender CharacterGender, int32& OutSlotIndex);
 
 	// ========== CARREGAR PERSONAGEM ==========
 
@@ -113,7 +114,7 @@ public:
 	 * Obtém o UserID atual
 	 */
 	UFUNCTION(BlueprintPure, Category = "Character")
-	FString GetCurrentUserID() const;
+	FErosUserId GetCurrentUserID() const;
 
 protected:
 	// Referência ao SaveGameManager
@@ -122,7 +123,7 @@ protected:
 
 	// UserID do usuário atual
 	UPROPERTY(VisibleAnywhere, Category = "Character")
-	FString CurrentUserID;
+	FErosUserId CurrentUserID;
 
 	// ========== CONSTANTES ==========
 	
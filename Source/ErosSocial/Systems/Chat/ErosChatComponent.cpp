@@ -0,0 +1,86 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatComponent.cpp
+
+#include "Systems/Chat/ErosChatComponent.h"
+#include "Systems/Chat/ErosChatSubsystem.h"
+#include "ErosSocialPlayerController.h"
+
+UErosChatComponent::UErosChatComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UErosChatComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		if (UErosChatSubsystem* Chat = UErosChatSubsystem::Get(this))
+		{
+			Chat->RegisterEndpoint(this);
+		}
+	}
+}
+
+void UErosChatComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UErosChatSubsystem* Chat = UErosChatSubsystem::Get(this))
+	{
+		Chat->UnregisterEndpoint(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UErosChatComponent::SendChatMessage(EErosChatChannel Channel, const FString& Text, FErosUserId TargetUserId)
+{
+	if (Text.IsEmpty() || Channel >= EErosChatChannel::MAX)
+	{
+		return;
+	}
+
+	ServerSendChatMessage(Channel, TargetUserId, Text);
+}
+
+void UErosChatComponent::ServerSendChatMessage_Implementation(EErosChatChannel Channel, const FErosUserId& TargetUserId, const FString& Text)
+{
+	// Descartado antes do filtro e do roteamento
+	AErosSocialPlayerController* PlayerController = Cast<AErosSocialPlayerController>(GetOwner());
+	if (PlayerController && !PlayerController->ConsumeRateLimit(EErosRateLimitedAction::ChatMessage))
+	{
+		return;
+	}
+
+	if (UErosChatSubsystem* Chat = UErosChatSubsystem::Get(this))
+	{
+		Chat->RouteMessage(this, Channel, TargetUserId, Text);
+	}
+}
+
+void UErosChatComponent::QueueOutgoing(const FErosChatWireMessage& Message)
+{
+	PendingBatch.Messages.Add(Message);
+}
+
+int32 UErosChatComponent::FlushOutgoing()
+{
+	const int32 NumMessages = PendingBatch.Messages.Num();
+	if (NumMessages == 0)
+	{
+		return 0;
+	}
+
+	ClientReceiveChatBatch(PendingBatch);
+	PendingBatch.Messages.Reset();
+	return NumMessages;
+}
+
+void UErosChatComponent::ClientReceiveChatBatch_Implementation(const FErosChatBatch& Batch)
+{
+	if (UErosChatSubsystem* Chat = UErosChatSubsystem::Get(this))
+	{
+		Chat->ReceiveBatch(Batch);
+	}
+}
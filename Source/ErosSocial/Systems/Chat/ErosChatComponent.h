@@ -0,0 +1,55 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatComponent.h
+// Ponta de rede do chat em cada PlayerController
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Systems/Chat/ErosChatTypes.h"
+#include "ErosChatComponent.generated.h"
+
+/**
+ * Canal de chat de uma conexão
+ * - Cliente -> servidor: ServerSendChatMessage (uma mensagem por RPC, vinda do input do jogador)
+ * - Servidor -> cliente: ClientReceiveChatBatch com todas as mensagens do net tick
+ * O roteamento (quem recebe) fica no UErosChatSubsystem do servidor.
+ */
+UCLASS(ClassGroup = (ErosSocial), meta = (BlueprintSpawnableComponent))
+class EROSSOCIAL_API UErosChatComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UErosChatComponent();
+
+	/**
+	 * Envia uma mensagem do jogador local
+	 * TargetUserId só é usado no canal Private
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Chat")
+	void SendChatMessage(EErosChatChannel Channel, const FString& Text, FErosUserId TargetUserId);
+
+	// ========== SERVIDOR ==========
+
+	/** Enfileira para o próximo flush (chamado pelo roteamento do subsistema) */
+	void QueueOutgoing(const FErosChatWireMessage& Message);
+
+	/** Envia a fila num único RPC; retorna quantas mensagens foram enviadas */
+	int32 FlushOutgoing();
+
+	bool HasPendingOutgoing() const { return PendingBatch.Messages.Num() > 0; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UFUNCTION(Server, Reliable)
+	void ServerSendChatMessage(EErosChatChannel Channel, const FErosUserId& TargetUserId, const FString& Text);
+
+	UFUNCTION(Client, Reliable)
+	void ClientReceiveChatBatch(const FErosChatBatch& Batch);
+
+private:
+	FErosChatBatch PendingBatch;
+};
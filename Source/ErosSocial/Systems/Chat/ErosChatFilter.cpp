@@ -0,0 +1,351 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatFilter.cpp
+
+#include "Systems/Chat/ErosChatFilter.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	struct FNormalizationTable
+	{
+		uint8 Symbols[256];
+
+		FNormalizationTable()
+		{
+			auto Letter = [](ANSICHAR C) { return static_cast<uint8>(C - 'a' + 1); };
+
+			for (int32 Char = 0; Char < 256; ++Char)
+			{
+				Symbols[Char] = FErosChatFilter::IgnoredSymbol;
+			}
+
+			for (int32 Char = 'a'; Char <= 'z'; ++Char)
+			{
+				Symbols[Char] = Letter(static_cast<ANSICHAR>(Char));
+				Symbols[Char - 'a' + 'A'] = Letter(static_cast<ANSICHAR>(Char));
+			}
+
+			// Espaços separam palavras; o resto da pontuação é ignorado
+			const int32 Separators[] = { ' ', '\t', '\n', '\r', 0xA0 };
+			for (const int32 Char : Separators)
+			{
+				Symbols[Char] = FErosChatFilter::SeparatorSymbol;
+			}
+
+			// Leetspeak
+			const struct { ANSICHAR From; ANSICHAR To; } Leet[] =
+			{
+				{ '0', 'o' }, { '1', 'i' }, { '3', 'e' }, { '4', 'a' }, { '5', 's' },
+				{ '7', 't' }, { '8', 'b' }, { '@', 'a' }, { '$', 's' }, { '!', 'i' },
+				{ '|', 'i' }, { '+', 't' }
+			};
+			for (const auto& Mapping : Leet)
+			{
+				Symbols[static_cast<uint8>(Mapping.From)] = Letter(Mapping.To);
+			}
+
+			// Latin-1 acentuado (maiúsculas e minúsculas)
+			const struct { int32 First; int32 Last; ANSICHAR To; } Accents[] =
+			{
+				{ 0xC0, 0xC5, 'a' }, { 0xE0, 0xE5, 'a' },
+				{ 0xC7, 0xC7, 'c' }, { 0xE7, 0xE7, 'c' },
+				{ 0xC8, 0xCB, 'e' }, { 0xE8, 0xEB, 'e' },
+				{ 0xCC, 0xCF, 'i' }, { 0xEC, 0xEF, 'i' },
+				{ 0xD1, 0xD1, 'n' }, { 0xF1, 0xF1, 'n' },
+				{ 0xD2, 0xD6, 'o' }, { 0xF2, 0xF6, 'o' }, { 0xD8, 0xD8, 'o' }, { 0xF8, 0xF8, 'o' },
+				{ 0xD9, 0xDC, 'u' }, { 0xF9, 0xFC, 'u' },
+				{ 0xDD, 0xDD, 'y' }, { 0xFD, 0xFD, 'y' }, { 0xFF, 0xFF, 'y' },
+				{ 0xDF, 0xDF, 's' }
+			};
+			for (const auto& Range : Accents)
+			{
+				for (int32 Char = Range.First; Char <= Range.Last; ++Char)
+				{
+					Symbols[Char] = Letter(Range.To);
+				}
+			}
+		}
+	};
+
+	const FNormalizationTable GNormalizationTable;
+}
+
+FErosChatFilter::FErosChatFilter()
+{
+	Build(TArray<FString>());
+}
+
+uint8 FErosChatFilter::NormalizeChar(TCHAR Char)
+{
+	const uint32 Code = static_cast<uint32>(Char);
+	// Fora do Latin-1 (emoji, outros alfabetos): separador
+	return Code < 256 ? GNormalizationTable.Symbols[Code] : SeparatorSymbol;
+}
+
+void FErosChatFilter::Build(const TArray<FString>& Words)
+{
+	// Trie
+	TArray<int32> Goto;
+	TArray<uint8> Lengths;
+	Goto.Init(INDEX_NONE, AlphabetSize);
+	Lengths.Add(0);
+	NumPatterns = 0;
+
+	for (const FString& Word : Words)
+	{
+		TArray<uint8, TInlineAllocator<64>> Pattern;
+		for (const TCHAR Char : Word)
+		{
+			const uint8 Symbol = NormalizeChar(Char);
+			if (Symbol != IgnoredSymbol && Symbol != SeparatorSymbol)
+			{
+				Pattern.Add(Symbol);
+			}
+		}
+
+		if (Pattern.Num() < 2 || Pattern.Num() > MAX_uint8)
+		{
+			continue;
+		}
+
+		int32 State = 0;
+		for (const uint8 Symbol : Pattern)
+		{
+			int32& Next = Goto[State * AlphabetSize + Symbol];
+			if (Next == INDEX_NONE)
+			{
+				Next = Lengths.Num();
+				Lengths.Add(0);
+				Goto.AddUninitialized(AlphabetSize);
+				FMemory::Memset(Goto.GetData() + Goto.Num() - AlphabetSize, 0xFF, AlphabetSize * sizeof(int32));
+			}
+			State = Goto[State * AlphabetSize + Symbol];
+		}
+
+		Lengths[State] = FMath::Max<uint8>(Lengths[State], static_cast<uint8>(Pattern.Num()));
+		++NumPatterns;
+	}
+
+	// BFS: links de falha e transições completas (DFA)
+	const int32 NumStates = Lengths.Num();
+	TArray<int32> Fail;
+	Fail.Init(0, NumStates);
+
+	TArray<int32> Queue;
+	Queue.Reserve(NumStates);
+
+	for (int32 Symbol = 0; Symbol < AlphabetSize; ++Symbol)
+	{
+		int32& Next = Goto[Symbol];
+		if (Next == INDEX_NONE)
+		{
+			Next = 0;
+		}
+		else
+		{
+			Fail[Next] = 0;
+			Queue.Add(Next);
+		}
+	}
+
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 State = Queue[Head];
+		Lengths[State] = FMath::Max(Lengths[State], Lengths[Fail[State]]);
+
+		for (int32 Symbol = 0; Symbol < AlphabetSize; ++Symbol)
+		{
+			int32& Next = Goto[State * AlphabetSize + Symbol];
+			if (Next == INDEX_NONE)
+			{
+				Next = Goto[Fail[State] * AlphabetSize + Symbol];
+			}
+			else
+			{
+				Fail[Next] = Goto[Fail[State] * AlphabetSize + Symbol];
+				Queue.Add(Next);
+			}
+		}
+	}
+
+	// Símbolo ignorado nunca muda de estado
+	for (int32 State = 0; State < NumStates; ++State)
+	{
+		Goto[State * AlphabetSize + IgnoredSymbol] = State;
+	}
+
+	Transitions = MoveTemp(Goto);
+	MatchLengths = MoveTemp(Lengths);
+}
+
+int32 FErosChatFilter::FindFirstMatch(FStringView Text) const
+{
+	const TCHAR* Chars = Text.GetData();
+	const int32 Num = Text.Len();
+	int32 State = 0;
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		State = GetNextState(State, NormalizeChar(Chars[Index]));
+		if (MatchLengths[State] != 0)
+		{
+			return Index;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+bool FErosChatFilter::Contains(FStringView Text) const
+{
+	return NumPatterns > 0 && FindFirstMatch(Text) != INDEX_NONE;
+}
+
+int32 FErosChatFilter::Censor(FString& InOutText) const
+{
+	if (NumPatterns == 0 || FindFirstMatch(InOutText) == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	// Só mensagens com match chegam aqui: guarda a posição original de cada símbolo
+	TArray<int32, TInlineAllocator<256>> SymbolSource;
+	TArray<TPair<int32, int32>, TInlineAllocator<8>> Ranges;
+
+	int32 State = 0;
+	for (int32 Index = 0; Index < InOutText.Len(); ++Index)
+	{
+		const uint8 Symbol = NormalizeChar(InOutText[Index]);
+		if (Symbol == IgnoredSymbol)
+		{
+			continue;
+		}
+
+		SymbolSource.Add(Index);
+		State = GetNextState(State, Symbol);
+
+		const int32 Length = MatchLengths[State];
+		if (Length != 0)
+		{
+			Ranges.Emplace(SymbolSource[SymbolSource.Num() - Length], Index);
+		}
+	}
+
+	for (const TPair<int32, int32>& Range : Ranges)
+	{
+		for (int32 Index = Range.Key; Index <= Range.Value; ++Index)
+		{
+			if (NormalizeChar(InOutText[Index]) != SeparatorSymbol)
+			{
+				InOutText[Index] = TEXT('*');
+			}
+		}
+	}
+
+	return Ranges.Num();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+
+/**
+ * Throughput do filtro com palavras e mensagens sintéticas
+ * Uso: Eros.Chat.FilterBenchmark [Words=2000] [Messages=200000]
+ */
+static void ErosChatFilterBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumWords = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 2000;
+	const int32 NumMessages = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 200000;
+
+	FRandomStream Random(1337);
+	auto RandomWord = [&Random](int32 MinLength, int32 MaxLength)
+	{
+		FString Word;
+		const int32 Length = Random.RandRange(MinLength, MaxLength);
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			Word.AppendChar(static_cast<TCHAR>('a' + Random.RandRange(0, 25)));
+		}
+		return Word;
+	};
+
+	TArray<FString> Words;
+	for (int32 Index = 0; Index < NumWords; ++Index)
+	{
+		Words.Add(RandomWord(4, 9));
+	}
+
+	// Mensagens de 30-120 caracteres; ~5% com um termo bloqueado disfarçado
+	TArray<FString> Messages;
+	Messages.Reserve(NumMessages);
+	for (int32 Index = 0; Index < NumMessages; ++Index)
+	{
+		FString Message;
+		const int32 TargetLength = Random.RandRange(30, 120);
+		while (Message.Len() < TargetLength)
+		{
+			Message += RandomWord(2, 7);
+			Message.AppendChar(TEXT(' '));
+		}
+
+		if (Random.FRand() < 0.05f)
+		{
+			FString Hidden = Words[Random.RandRange(0, NumWords - 1)].ToUpper().Replace(TEXT("A"), TEXT("4")).Replace(TEXT("E"), TEXT("3"));
+			Message += Hidden;
+		}
+		Messages.Add(MoveTemp(Message));
+	}
+
+	FErosChatFilter Filter;
+	double StartTime = FPlatformTime::Seconds();
+	Filter.Build(Words);
+	const double BuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// Uma thread
+	TArray<FString> Working = Messages;
+	int32 NumCensored = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (FString& Message : Working)
+	{
+		NumCensored += Filter.Censor(Message) > 0 ? 1 : 0;
+	}
+	const double SingleSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// Todas as workers (como o servidor usa)
+	Working = Messages;
+	StartTime = FPlatformTime::Seconds();
+	ParallelFor(Working.Num(), [&Filter, &Working](int32 Index)
+	{
+		Filter.Censor(Working[Index]);
+	});
+	const double ParallelSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// Referência: FString::Contains por palavra (amostra pequena, é lento)
+	const int32 NumNaive = FMath::Min(NumMessages, 2000);
+	int32 NumNaiveHits = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumNaive; ++Index)
+	{
+		for (const FString& Word : Words)
+		{
+			if (Messages[Index].Contains(Word))
+			{
+				++NumNaiveHits;
+				break;
+			}
+		}
+	}
+	const double NaiveSeconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogTemp, Log, TEXT("Eros.Chat.FilterBenchmark - %d words -> %d states, build %.1f ms"),
+		Filter.GetNumPatterns(), Filter.GetNumStates(), BuildSeconds * 1e3);
+	UE_LOG(LogTemp, Log, TEXT("Eros.Chat.FilterBenchmark - 1 thread: %.0f msg/s (%d/%d censored), ParallelFor: %.0f msg/s, naive Contains: %.0f msg/s"),
+		NumMessages / FMath::Max(SingleSeconds, 1e-9), NumCensored, NumMessages,
+		NumMessages / FMath::Max(ParallelSeconds, 1e-9),
+		NumNaive / FMath::Max(NaiveSeconds, 1e-9));
+}
+
+static FAutoConsoleCommand ErosChatFilterBenchmarkCmd(
+	TEXT("Eros.Chat.FilterBenchmark"),
+	TEXT("Mede o throughput do filtro de chat (mensagens/s). Args: [Words=2000] [Messages=200000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ErosChatFilterBenchmark));
@@ -0,0 +1,55 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatFilter.h
+// Filtro de palavras do chat (autômato Aho-Corasick sobre alfabeto normalizado)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Filtro de palavras bloqueadas
+ * - Texto normalizado antes da busca: caixa, acentos Latin-1 (á -> a, ç -> c) e leetspeak (4 -> a, 3 -> e, $ -> s...)
+ * - Pontuação é ignorada ("p.a.l.a.v.r.a" casa com "palavra"); espaço separa palavras
+ * - Autômato determinístico em tabela densa: um lookup por caractere, sem alocação por mensagem
+ * - A passada de censura (mapeamento para o texto original) só roda quando há match
+ *
+ * Imutável depois de Build: seguro para várias threads ao mesmo tempo.
+ */
+class EROSSOCIAL_API FErosChatFilter
+{
+public:
+	// 0 = ignorado, 1..26 = letras, 27 = separador
+	static constexpr int32 AlphabetSize = 28;
+	static constexpr uint8 IgnoredSymbol = 0;
+	static constexpr uint8 SeparatorSymbol = 27;
+
+	FErosChatFilter();
+
+	/** Monta o autômato; palavras que normalizam para menos de 2 letras são descartadas */
+	void Build(const TArray<FString>& Words);
+
+	bool IsEmpty() const { return NumPatterns == 0; }
+	int32 GetNumPatterns() const { return NumPatterns; }
+	int32 GetNumStates() const { return MatchLengths.Num(); }
+
+	/** Algum termo bloqueado no texto */
+	bool Contains(FStringView Text) const;
+
+	/** Troca os caracteres dos termos encontrados por '*'; retorna quantos matches */
+	int32 Censor(FString& InOutText) const;
+
+	static uint8 NormalizeChar(TCHAR Char);
+
+private:
+	int32 GetNextState(int32 State, uint8 Symbol) const { return Transitions[State * AlphabetSize + Symbol]; }
+
+	/** Primeiro match (posição no texto original do último caractere), ou INDEX_NONE */
+	int32 FindFirstMatch(FStringView Text) const;
+
+	TArray<int32> Transitions;
+
+	// Maior padrão (em símbolos) que termina em cada estado, seguindo os links de falha
+	TArray<uint8> MatchLengths;
+
+	int32 NumPatterns = 0;
+};
@@ -0,0 +1,202 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatHistorySubsystem.cpp
+
+#include "Systems/Chat/ErosChatHistorySubsystem.h"
+#include "ErosSocialGameInstance.h"
+#include "SaveGameManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+
+UErosChatHistorySubsystem* UErosChatHistorySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UErosChatHistorySubsystem>() : nullptr;
+}
+
+void UErosChatHistorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Writer = MakeUnique<FErosChatLogWriter>(0.5f);
+}
+
+void UErosChatHistorySubsystem::Deinitialize()
+{
+	// Para a thread e grava o que sobrou na fila
+	Writer.Reset();
+
+	Super::Deinitialize();
+}
+
+FString UErosChatHistorySubsystem::GetConversationPath(const FErosUserId& PeerId) const
+{
+	const UErosSocialGameInstance* GameInstance = Cast<UErosSocialGameInstance>(GetGameInstance());
+	const USaveGameManager* SaveManager = GameInstance ? GameInstance->GetSaveGameManager() : nullptr;
+	if (!SaveManager || !GameInstance->GetUserID().IsValid() || !PeerId.IsValid())
+	{
+		return FString();
+	}
+
+	return SaveManager->GetSaveGamePath(GameInstance->GetUserID()) + TEXT("Chat/") + PeerId.ToString();
+}
+
+void UErosChatHistorySubsystem::RecordPrivateMessage(const FErosUserId& SenderId, const FErosUserId& RecipientId, const FString& SenderName, const FString& Text)
+{
+	const UErosSocialGameInstance* GameInstance = Cast<UErosSocialGameInstance>(GetGameInstance());
+	if (!GameInstance)
+	{
+		return;
+	}
+
+	const bool bOutgoing = SenderId == GameInstance->GetUserID();
+	const FErosUserId& PeerId = bOutgoing ? RecipientId : SenderId;
+
+	FErosChatLogWriter::FRecord Record;
+	Record.ConversationPath = GetConversationPath(PeerId);
+	if (Record.ConversationPath.IsEmpty() || !Writer)
+	{
+		return;
+	}
+
+	Record.Ticks = FDateTime::UtcNow().GetTicks();
+	Record.Flags = bOutgoing ? ErosChatLog::Flag_Outgoing : 0;
+	Record.SenderName = SenderName;
+	Record.Text = Text;
+
+	Writer->Append(MoveTemp(Record));
+}
+
+int32 UErosChatHistorySubsystem::GetMessageCount(FErosUserId PeerId)
+{
+	const FString ConversationPath = GetConversationPath(PeerId);
+	if (ConversationPath.IsEmpty())
+	{
+		return 0;
+	}
+
+	const int64 IndexSize = IFileManager::Get().FileSize(*ErosChatLog::GetIndexPath(ConversationPath));
+	return IndexSize > 0 ? static_cast<int32>(IndexSize / ErosChatLog::IndexEntrySize) : 0;
+}
+
+bool UErosChatHistorySubsystem::ReadMessages(const FErosUserId& PeerId, int32 FirstIndex, int32 Count, TArray<FErosChatLogEntry>& OutEntries)
+{
+	OutEntries.Reset();
+
+	const FString ConversationPath = GetConversationPath(PeerId);
+	if (ConversationPath.IsEmpty())
+	{
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult IndexResult = PlatformFile.OpenMappedEx(*ErosChatLog::GetIndexPath(ConversationPath));
+	FOpenMappedResult LogResult = PlatformFile.OpenMappedEx(*ErosChatLog::GetLogPath(ConversationPath));
+	if (IndexResult.HasError() || LogResult.HasError())
+	{
+		return false;
+	}
+
+	const TUniquePtr<IMappedFileHandle> IndexHandle = IndexResult.StealValue();
+	const TUniquePtr<IMappedFileHandle> LogHandle = LogResult.StealValue();
+
+	const int64 NumMessages = IndexHandle->GetFileSize() / ErosChatLog::IndexEntrySize;
+	const int64 First = FMath::Clamp<int64>(FirstIndex, 0, NumMessages);
+	const int64 Last = FMath::Min<int64>(First + FMath::Max(Count, 0), NumMessages);
+	if (First >= Last)
+	{
+		return true;
+	}
+
+	// Só os offsets da página
+	TUniquePtr<IMappedFileRegion> IndexRegion(IndexHandle->MapRegion(First * ErosChatLog::IndexEntrySize, (Last - First) * ErosChatLog::IndexEntrySize));
+	if (!IndexRegion)
+	{
+		return false;
+	}
+
+	TArray<uint64, TInlineAllocator<64>> Offsets;
+	Offsets.SetNumUninitialized(static_cast<int32>(Last - First));
+	FMemory::Memcpy(Offsets.GetData(), IndexRegion->GetMappedPtr(), Offsets.Num() * ErosChatLog::IndexEntrySize);
+
+	// Registros da página são contíguos: do primeiro offset até o fim do último registro
+	// (o fim do último é o próximo offset, ou o fim do arquivo)
+	const int64 LogSize = LogHandle->GetFileSize();
+	int64 RegionEnd = LogSize;
+	if (Last < NumMessages)
+	{
+		uint64 NextOffset = 0;
+		TUniquePtr<IMappedFileRegion> NextRegion(IndexHandle->MapRegion(Last * ErosChatLog::IndexEntrySize, ErosChatLog::IndexEntrySize));
+		if (NextRegion)
+		{
+			FMemory::Memcpy(&NextOffset, NextRegion->GetMappedPtr(), sizeof(NextOffset));
+			RegionEnd = FMath::Min<int64>(static_cast<int64>(NextOffset), LogSize);
+		}
+	}
+
+	const int64 RegionStart = static_cast<int64>(Offsets[0]);
+	if (RegionStart >= RegionEnd)
+	{
+		return false;
+	}
+
+	TUniquePtr<IMappedFileRegion> LogRegion(LogHandle->MapRegion(RegionStart, RegionEnd - RegionStart));
+	if (!LogRegion)
+	{
+		return false;
+	}
+
+	const uint8* Base = LogRegion->GetMappedPtr();
+	OutEntries.Reserve(Offsets.Num());
+
+	for (const uint64 Offset : Offsets)
+	{
+		const int64 Local = static_cast<int64>(Offset) - RegionStart;
+		if (Local < 0 || Local + ErosChatLog::RecordHeaderSize > RegionEnd - RegionStart)
+		{
+			break;
+		}
+
+		const uint8* Read = Base + Local;
+		int64 Ticks = 0;
+		uint16 NameBytes = 0;
+		uint16 TextBytes = 0;
+		FMemory::Memcpy(&Ticks, Read, sizeof(int64));         Read += sizeof(int64);
+		FMemory::Memcpy(&NameBytes, Read, sizeof(uint16));    Read += sizeof(uint16);
+		FMemory::Memcpy(&TextBytes, Read, sizeof(uint16));    Read += sizeof(uint16);
+		const uint8 Flags = *Read++;
+
+		if (Local + ErosChatLog::RecordHeaderSize + NameBytes + TextBytes > RegionEnd - RegionStart)
+		{
+			// Registro truncado (arquivo corrompido)
+			break;
+		}
+
+		FErosChatLogEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.Timestamp = FDateTime(Ticks);
+		Entry.bOutgoing = (Flags & ErosChatLog::Flag_Outgoing) != 0;
+		Entry.SenderName = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Read), NameBytes));
+		Entry.Text = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Read + NameBytes), TextBytes));
+	}
+
+	return true;
+}
+
+TArray<FErosChatLogEntry> UErosChatHistorySubsystem::ReadHistoryPage(FErosUserId PeerId, int32 PageFromEnd, int32 PageSize)
+{
+	TArray<FErosChatLogEntry> Entries;
+
+	const int32 NumMessages = GetMessageCount(PeerId);
+	const int32 SafePageSize = FMath::Max(PageSize, 1);
+	const int32 Last = NumMessages - FMath::Max(PageFromEnd, 0) * SafePageSize;
+	if (Last <= 0)
+	{
+		return Entries;
+	}
+
+	const int32 First = FMath::Max(0, Last - SafePageSize);
+	ReadMessages(PeerId, First, Last - First, Entries);
+	return Entries;
+}
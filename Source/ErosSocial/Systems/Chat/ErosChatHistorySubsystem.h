@@ -0,0 +1,83 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatHistorySubsystem.h
+// Histórico persistente das conversas privadas
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ErosUserId.h"
+#include "Systems/Chat/ErosChatLogWriter.h"
+#include "ErosChatHistorySubsystem.generated.h"
+
+/**
+ * Uma mensagem lida do log de uma conversa
+ */
+USTRUCT(BlueprintType)
+struct FErosChatLogEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	FString SenderName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	FString Text;
+
+	// UTC
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	FDateTime Timestamp;
+
+	// Enviada pelo usuário local
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	bool bOutgoing = false;
+};
+
+/**
+ * Conversas privadas em disco, uma por par (usuário local, outro usuário)
+ * - Pasta Chat/ dentro do save do usuário (USaveGameManager::GetSaveGamePath)
+ * - Escrita append-only em lote por FErosChatLogWriter (thread própria)
+ * - Leitura por página via memory map: só o trecho do índice e dos registros da página é mapeado,
+ *   e o map é solto no fim da leitura (não segura o arquivo contra os appends do writer)
+ * Mensagens ainda na fila do writer não aparecem na leitura até o próximo flush (~0.5 s);
+ * a conversa ao vivo vem do histórico em memória do UErosChatSubsystem.
+ */
+UCLASS()
+class EROSSOCIAL_API UErosChatHistorySubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosChatHistorySubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Enfileira uma mensagem privada recebida do servidor (inclusive o eco das enviadas)
+	 * A conversa é com quem não for o usuário local
+	 */
+	void RecordPrivateMessage(const FErosUserId& SenderId, const FErosUserId& RecipientId, const FString& SenderName, const FString& Text);
+
+	/** Mensagens já gravadas na conversa (lê só o tamanho do índice) */
+	UFUNCTION(BlueprintCallable, Category = "Chat|History")
+	int32 GetMessageCount(FErosUserId PeerId);
+
+	/**
+	 * Lê Count mensagens a partir de FirstIndex (0 = mais antiga)
+	 * Retorna false se a conversa não existe ou não pôde ser mapeada
+	 */
+	bool ReadMessages(const FErosUserId& PeerId, int32 FirstIndex, int32 Count, TArray<FErosChatLogEntry>& OutEntries);
+
+	/**
+	 * Página de scrollback contada do fim: página 0 = as PageSize mais recentes
+	 * Mensagens em ordem cronológica dentro da página
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Chat|History")
+	TArray<FErosChatLogEntry> ReadHistoryPage(FErosUserId PeerId, int32 PageFromEnd = 0, int32 PageSize = 50);
+
+private:
+	FString GetConversationPath(const FErosUserId& PeerId) const;
+
+	TUniquePtr<FErosChatLogWriter> Writer;
+};
@@ -0,0 +1,230 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatLogWriter.cpp
+
+#include "Systems/Chat/ErosChatLogWriter.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace ErosChatLogWriter
+{
+	// Append completo ou nada: IsError cobre escrita curta, Close cobre o flush final
+	static bool AppendBytes(const FString& Path, TArray<uint8>& Bytes)
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append | FILEWRITE_AllowRead));
+		if (!Writer)
+		{
+			return false;
+		}
+
+		Writer->Serialize(Bytes.GetData(), Bytes.Num());
+		const bool bSerialized = !Writer->IsError();
+		const bool bClosed = Writer->Close();
+		return bSerialized && bClosed;
+	}
+
+	// Desfaz um append parcial para o retry não duplicar registros
+	static void Truncate(const FString& Path, int64 Size)
+	{
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path, true, false));
+		if (!Handle || !Handle->Truncate(Size))
+		{
+			UE_LOG(LogTemp, Error, TEXT("FErosChatLogWriter::AppendConversation - Failed to roll %s back to %lld bytes"), *Path, Size);
+		}
+	}
+}
+
+FErosChatLogWriter::FErosChatLogWriter(float InFlushIntervalSeconds)
+	: FlushIntervalSeconds(FMath::Max(InFlushIntervalSeconds, 0.05f))
+{
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		Thread = FRunnableThread::Create(this, TEXT("ErosChatLogWriter"), 0, TPri_BelowNormal);
+	}
+}
+
+FErosChatLogWriter::~FErosChatLogWriter()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+	}
+
+	// O que chegou depois do último ciclo da thread (e o que ainda aguarda retry)
+	Flush(true);
+}
+
+void FErosChatLogWriter::Append(FRecord&& Record)
+{
+	Pending.Enqueue(MoveTemp(Record));
+
+	if (!Thread)
+	{
+		Flush();
+	}
+}
+
+void FErosChatLogWriter::FlushNow()
+{
+	Flush(true);
+}
+
+uint32 FErosChatLogWriter::Run()
+{
+	const uint32 WaitMs = static_cast<uint32>(FlushIntervalSeconds * 1000.0f);
+
+	while (!bStopping)
+	{
+		WakeEvent->Wait(WaitMs);
+		Flush();
+	}
+
+	return 0;
+}
+
+void FErosChatLogWriter::Stop()
+{
+	bStopping = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FErosChatLogWriter::Flush(bool bIgnoreBackoff)
+{
+	FScopeLock Lock(&FlushLock);
+
+	// Falhas anteriores vão na frente para manter a ordem por conversa
+	TArray<FRecord> Batch = MoveTemp(Retry);
+	Retry.Reset();
+
+	FRecord Record;
+	while (Pending.Dequeue(Record))
+	{
+		Batch.Add(MoveTemp(Record));
+	}
+
+	if (Batch.Num() == 0)
+	{
+		return;
+	}
+
+	// Agrupa por conversa preservando a ordem de chegada
+	TMap<FString, TArray<const FRecord*>> ByConversation;
+	for (const FRecord& Queued : Batch)
+	{
+		ByConversation.FindOrAdd(Queued.ConversationPath).Add(&Queued);
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	for (const TPair<FString, TArray<const FRecord*>>& Conversation : ByConversation)
+	{
+		FRetryState* RetryState = RetryStates.Find(Conversation.Key);
+		if (RetryState && !bIgnoreBackoff && Now < RetryState->NextAttemptTime)
+		{
+			// Ainda em backoff: segura tudo da conversa, inclusive as mensagens novas
+			for (const FRecord* Queued : Conversation.Value)
+			{
+				Retry.Add(*Queued);
+			}
+			continue;
+		}
+
+		if (AppendConversation(Conversation.Key, Conversation.Value))
+		{
+			RetryStates.Remove(Conversation.Key);
+			continue;
+		}
+
+		// AppendConversation já voltou .log/.idx ao tamanho anterior; o retry regrava o lote inteiro
+		FRetryState& State = RetryStates.FindOrAdd(Conversation.Key);
+		++State.Attempts;
+
+		if (State.Attempts > MaxRetryAttempts)
+		{
+			UE_LOG(LogTemp, Error, TEXT("FErosChatLogWriter::Flush - Dropping %d messages for %s after %d failed attempts"), Conversation.Value.Num(), *Conversation.Key, MaxRetryAttempts);
+			RetryStates.Remove(Conversation.Key);
+			continue;
+		}
+
+		const double Delay = FMath::Min(FlushIntervalSeconds * FMath::Pow(2.0, State.Attempts), MaxRetryDelaySeconds);
+		State.NextAttemptTime = Now + Delay;
+
+		UE_LOG(LogTemp, Warning, TEXT("FErosChatLogWriter::Flush - Failed to append %d messages to %s, retrying in %.1fs (attempt %d/%d)"), Conversation.Value.Num(), *Conversation.Key, Delay, State.Attempts, MaxRetryAttempts);
+
+		for (const FRecord* Queued : Conversation.Value)
+		{
+			Retry.Add(*Queued);
+		}
+	}
+}
+
+bool FErosChatLogWriter::AppendConversation(const FString& ConversationPath, const TArray<const FRecord*>& Records)
+{
+	const FString LogPath = ErosChatLog::GetLogPath(ConversationPath);
+	const FString IndexPath = ErosChatLog::GetIndexPath(ConversationPath);
+
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.MakeDirectory(*FPaths::GetPath(LogPath), true);
+
+	const int64 LogSize = FMath::Max<int64>(FileManager.FileSize(*LogPath), 0);
+	const int64 IndexSize = FMath::Max<int64>(FileManager.FileSize(*IndexPath), 0);
+	uint64 Offset = static_cast<uint64>(LogSize);
+
+	TArray<uint8> LogBytes;
+	TArray<uint8> IndexBytes;
+	IndexBytes.Reserve(Records.Num() * ErosChatLog::IndexEntrySize);
+
+	for (const FRecord* Record : Records)
+	{
+		const FTCHARToUTF8 Name(*Record->SenderName);
+		const FTCHARToUTF8 Text(*Record->Text);
+		const uint16 NameBytes = static_cast<uint16>(FMath::Min(Name.Length(), static_cast<int32>(MAX_uint16)));
+		const uint16 TextBytes = static_cast<uint16>(FMath::Min(Text.Length(), static_cast<int32>(MAX_uint16)));
+
+		IndexBytes.Append(reinterpret_cast<const uint8*>(&Offset), sizeof(Offset));
+
+		const int32 RecordStart = LogBytes.AddUninitialized(ErosChatLog::RecordHeaderSize + NameBytes + TextBytes);
+		uint8* Write = LogBytes.GetData() + RecordStart;
+		FMemory::Memcpy(Write, &Record->Ticks, sizeof(int64));       Write += sizeof(int64);
+		FMemory::Memcpy(Write, &NameBytes, sizeof(uint16));          Write += sizeof(uint16);
+		FMemory::Memcpy(Write, &TextBytes, sizeof(uint16));          Write += sizeof(uint16);
+		*Write++ = Record->Flags;
+		FMemory::Memcpy(Write, Name.Get(), NameBytes);               Write += NameBytes;
+		FMemory::Memcpy(Write, Text.Get(), TextBytes);
+
+		Offset += ErosChatLog::RecordHeaderSize + NameBytes + TextBytes;
+	}
+
+	// Registros primeiro, índice depois; qualquer falha desfaz os dois
+	if (!ErosChatLogWriter::AppendBytes(LogPath, LogBytes))
+	{
+		ErosChatLogWriter::Truncate(LogPath, LogSize);
+		return false;
+	}
+
+	if (!ErosChatLogWriter::AppendBytes(IndexPath, IndexBytes))
+	{
+		ErosChatLogWriter::Truncate(IndexPath, IndexSize);
+		ErosChatLogWriter::Truncate(LogPath, LogSize);
+		return false;
+	}
+
+	return true;
+}
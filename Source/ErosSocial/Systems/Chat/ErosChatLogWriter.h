@@ -0,0 +1,98 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatLogWriter.h
+// Thread que grava em lote os logs de conversa (append-only)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Formato em disco de uma conversa (<Peer>.log + <Peer>.idx na pasta Chat do usuário)
+ *
+ * .log: registros concatenados, nunca reescritos
+ *   int64 Ticks (FDateTime UTC) | uint16 NameBytes | uint16 TextBytes | uint8 Flags | nome UTF-8 | texto UTF-8
+ * .idx: um uint64 por mensagem com o offset do registro no .log
+ *
+ * O .idx é gravado depois do .log: qualquer entrada visível no índice já tem o registro completo.
+ */
+namespace ErosChatLog
+{
+	constexpr int32 RecordHeaderSize = sizeof(int64) + sizeof(uint16) + sizeof(uint16) + sizeof(uint8);
+	constexpr int32 IndexEntrySize = sizeof(uint64);
+
+	constexpr uint8 Flag_Outgoing = 1 << 0;
+
+	inline FString GetLogPath(const FString& ConversationPath) { return ConversationPath + TEXT(".log"); }
+	inline FString GetIndexPath(const FString& ConversationPath) { return ConversationPath + TEXT(".idx"); }
+}
+
+/**
+ * Escritor em background
+ * - Append() só enfileira (lock-free, qualquer thread)
+ * - A thread acorda a cada FlushIntervalSeconds, agrupa por conversa e faz um open/append/close por arquivo
+ * - Conversa que falhou (arquivo preso por outro processo etc.) volta para a frente da fila e é
+ *   retentada com backoff exponencial; só é descartada depois de MaxRetryAttempts
+ * - Sem multithreading (servidor dedicado com -nothreading etc.) o flush é síncrono em Append
+ */
+class EROSSOCIAL_API FErosChatLogWriter : public FRunnable
+{
+public:
+	struct FRecord
+	{
+		// Caminho da conversa sem extensão
+		FString ConversationPath;
+		int64 Ticks = 0;
+		uint8 Flags = 0;
+		FString SenderName;
+		FString Text;
+	};
+
+	explicit FErosChatLogWriter(float InFlushIntervalSeconds = 0.5f);
+	virtual ~FErosChatLogWriter() override;
+
+	void Append(FRecord&& Record);
+
+	/** Grava tudo que está na fila (bloqueia a thread chamadora) */
+	void FlushNow();
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FRetryState
+	{
+		int32 Attempts = 0;
+		double NextAttemptTime = 0.0;
+	};
+
+	/** bIgnoreBackoff: FlushNow/destrutor tentam mesmo as conversas em espera */
+	void Flush(bool bIgnoreBackoff = false);
+
+	static bool AppendConversation(const FString& ConversationPath, const TArray<const FRecord*>& Records);
+
+	float FlushIntervalSeconds;
+
+	TQueue<FRecord, EQueueMode::Mpsc> Pending;
+
+	// ========== Retry (protegido por FlushLock) ==========
+
+	static constexpr int32 MaxRetryAttempts = 8;
+	static constexpr double MaxRetryDelaySeconds = 30.0;
+
+	// Registros que falharam, na ordem original; entram antes de Pending no próximo Flush
+	TArray<FRecord> Retry;
+	TMap<FString, FRetryState> RetryStates;
+
+	// Flush() pode ser chamado pela thread e por FlushNow
+	FCriticalSection FlushLock;
+
+	FEvent* WakeEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+	TAtomic<bool> bStopping { false };
+};
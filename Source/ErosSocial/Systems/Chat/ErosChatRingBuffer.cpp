@@ -0,0 +1,81 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatRingBuffer.cpp
+
+#include "Systems/Chat/ErosChatRingBuffer.h"
+
+FErosChatRingBuffer::FErosChatRingBuffer(int32 InMaxMessages, int32 InTextCapacity)
+{
+	Entries.SetNum(FMath::Max(InMaxMessages, 1));
+	Storage.SetNumUninitialized(FMath::Max(InTextCapacity, 256));
+}
+
+void FErosChatRingBuffer::Reset()
+{
+	Oldest = 0;
+	Count = 0;
+	WritePosition = 0;
+}
+
+void FErosChatRingBuffer::RemoveOldest()
+{
+	Oldest = (Oldest + 1) % Entries.Num();
+	--Count;
+}
+
+void FErosChatRingBuffer::Add(const FErosUserId& SenderId, FStringView SenderName, FStringView Text, float Timestamp)
+{
+	const int64 Capacity = Storage.Num();
+
+	// Mensagem maior que o buffer inteiro: guarda só o começo
+	const int32 NameLength = static_cast<int32>(FMath::Min<int64>(SenderName.Len(), Capacity / 4));
+	const int32 TextLength = static_cast<int32>(FMath::Min<int64>(Text.Len(), Capacity - NameLength));
+	const int32 Length = NameLength + TextLength;
+
+	// Sempre contíguo: se não cabe até o fim do buffer, pula para o início da próxima volta
+	int64 Start = WritePosition;
+	if ((Start % Capacity) + Length > Capacity)
+	{
+		Start = (Start / Capacity + 1) * Capacity;
+	}
+
+	// Tudo que começou antes de End - Capacity seria sobrescrito
+	const int64 End = Start + Length;
+	while (Count > 0 && Entries[Oldest].TextStart < End - Capacity)
+	{
+		RemoveOldest();
+	}
+
+	if (Count == Entries.Num())
+	{
+		RemoveOldest();
+	}
+
+	TCHAR* Destination = Storage.GetData() + (Start % Capacity);
+	FMemory::Memcpy(Destination, SenderName.GetData(), NameLength * sizeof(TCHAR));
+	FMemory::Memcpy(Destination + NameLength, Text.GetData(), TextLength * sizeof(TCHAR));
+
+	FEntry& Entry = Entries[(Oldest + Count) % Entries.Num()];
+	Entry.SenderId = SenderId;
+	Entry.TextStart = Start;
+	Entry.NameLength = NameLength;
+	Entry.TextLength = TextLength;
+	Entry.Timestamp = Timestamp;
+	++Count;
+
+	WritePosition = End;
+}
+
+FErosChatMessageView FErosChatRingBuffer::Get(int32 Index) const
+{
+	check(Index >= 0 && Index < Count);
+
+	const FEntry& Entry = Entries[(Oldest + Index) % Entries.Num()];
+	const TCHAR* Source = Storage.GetData() + (Entry.TextStart % Storage.Num());
+
+	FErosChatMessageView View;
+	View.SenderId = Entry.SenderId;
+	View.SenderName = FStringView(Source, Entry.NameLength);
+	View.Text = FStringView(Source + Entry.NameLength, Entry.TextLength);
+	View.Timestamp = Entry.Timestamp;
+	return View;
+}
@@ -0,0 +1,59 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatRingBuffer.h
+// Histórico de um canal: anel de mensagens com texto num buffer de caracteres compartilhado
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ErosUserId.h"
+
+/**
+ * Mensagem lida do anel; as views apontam para o buffer e valem até o próximo Add
+ */
+struct FErosChatMessageView
+{
+	FErosUserId SenderId;
+	FStringView SenderName;
+	FStringView Text;
+	float Timestamp = 0.0f;
+};
+
+/**
+ * Anel de mensagens de capacidade fixa
+ * - Nome e texto ficam num único buffer de TCHAR alocado uma vez (sem FString por mensagem)
+ * - Quando falta espaço (mensagens ou caracteres) as mais antigas são descartadas
+ * - Posições lógicas de 64 bits: o índice físico é Posição % Capacidade
+ */
+class EROSSOCIAL_API FErosChatRingBuffer
+{
+public:
+	FErosChatRingBuffer(int32 InMaxMessages = 200, int32 InTextCapacity = 32 * 1024);
+
+	void Add(const FErosUserId& SenderId, FStringView SenderName, FStringView Text, float Timestamp);
+
+	void Reset();
+
+	int32 Num() const { return Count; }
+
+	/** 0 = mais antiga, Num() - 1 = mais recente */
+	FErosChatMessageView Get(int32 Index) const;
+
+private:
+	struct FEntry
+	{
+		FErosUserId SenderId;
+		int64 TextStart = 0;
+		int32 NameLength = 0;
+		int32 TextLength = 0;
+		float Timestamp = 0.0f;
+	};
+
+	void RemoveOldest();
+
+	TArray<FEntry> Entries;
+	int32 Oldest = 0;
+	int32 Count = 0;
+
+	TArray<TCHAR> Storage;
+	int64 WritePosition = 0;
+};
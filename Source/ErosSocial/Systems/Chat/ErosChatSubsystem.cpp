@@ -0,0 +1,371 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatSubsystem.cpp
+
+#include "Systems/Chat/ErosChatSubsystem.h"
+#include "Systems/Chat/ErosChatComponent.h"
+#include "Systems/Chat/ErosChatFilter.h"
+#include "Systems/Chat/ErosChatHistorySubsystem.h"
+#include "Systems/Network/ErosNetStats.h"
+#include "Systems/Network/ErosNetUpdateRateManager.h"
+#include "Systems/Proximity/ErosProximitySubsystem.h"
+#include "ErosSocialCharacter.h"
+#include "ErosSocialPlayerState.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Chat Route"), STAT_ErosChat_Route, STATGROUP_ErosNet);
+DECLARE_CYCLE_STAT(TEXT("Chat Filter (worker)"), STAT_ErosChat_Filter, STATGROUP_ErosNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Chat Messages Censored"), STAT_ErosChat_Censored, STATGROUP_ErosNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Chat Messages Delivered"), STAT_ErosChat_Delivered, STATGROUP_ErosNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Chat Batches Sent"), STAT_ErosChat_Batches, STATGROUP_ErosNet);
+
+UErosChatSubsystem* UErosChatSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosChatSubsystem>() : nullptr;
+}
+
+void UErosChatSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Histories.Reset(static_cast<int32>(EErosChatChannel::MAX));
+	for (int32 Channel = 0; Channel < static_cast<int32>(EErosChatChannel::MAX); ++Channel)
+	{
+		Histories.Emplace(HistoryMessagesPerChannel, HistoryTextCapacity);
+	}
+
+	SetFilterWords(FilterWords);
+}
+
+void UErosChatSubsystem::Deinitialize()
+{
+	// Nenhum job pode sobreviver ao subsystem
+	for (const TSharedRef<FFilterJob, ESPMode::ThreadSafe>& Job : FilterJobs)
+	{
+		Job->Task.Wait();
+	}
+	FilterJobs.Reset();
+	InboundMessages.Reset();
+
+	Super::Deinitialize();
+}
+
+void UErosChatSubsystem::SetFilterWords(const TArray<FString>& Words)
+{
+	TSharedRef<FErosChatFilter, ESPMode::ThreadSafe> NewFilter = MakeShared<FErosChatFilter, ESPMode::ThreadSafe>();
+	NewFilter->Build(Words);
+	Filter = NewFilter;
+
+	UE_LOG(LogTemp, Log, TEXT("UErosChatSubsystem::SetFilterWords - %d terms, %d states"), NewFilter->GetNumPatterns(), NewFilter->GetNumStates());
+}
+
+bool UErosChatSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UErosChatSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UErosChatSubsystem, STATGROUP_Tickables);
+}
+
+void UErosChatSubsystem::Tick(float DeltaTime)
+{
+	DrainFilterJobs();
+	LaunchFilterJob();
+
+	if (PendingEndpoints.Num() == 0)
+	{
+		return;
+	}
+
+	// Um RPC por conexão com tudo que foi roteado neste frame
+	for (const TWeakObjectPtr<UErosChatComponent>& Endpoint : PendingEndpoints)
+	{
+		if (UErosChatComponent* Component = Endpoint.Get())
+		{
+			const int32 NumSent = Component->FlushOutgoing();
+			INC_DWORD_STAT_BY(STAT_ErosChat_Delivered, NumSent);
+			INC_DWORD_STAT(STAT_ErosChat_Batches);
+		}
+	}
+
+	PendingEndpoints.Reset();
+}
+
+// ========== SERVIDOR ==========
+
+void UErosChatSubsystem::RegisterEndpoint(UErosChatComponent* Endpoint)
+{
+	Endpoints.AddUnique(Endpoint);
+}
+
+void UErosChatSubsystem::UnregisterEndpoint(UErosChatComponent* Endpoint)
+{
+	Endpoints.RemoveSwap(Endpoint);
+	PendingEndpoints.RemoveSwap(Endpoint);
+}
+
+UErosChatComponent* UErosChatSubsystem::GetEndpointForController(AController* Controller)
+{
+	APlayerController* PlayerController = Cast<APlayerController>(Controller);
+	return PlayerController ? PlayerController->FindComponentByClass<UErosChatComponent>() : nullptr;
+}
+
+AErosSocialPlayerState* UErosChatSubsystem::GetEndpointPlayerState(const UErosChatComponent* Endpoint)
+{
+	const APlayerController* PlayerController = Endpoint ? Cast<APlayerController>(Endpoint->GetOwner()) : nullptr;
+	return PlayerController ? PlayerController->GetPlayerState<AErosSocialPlayerState>() : nullptr;
+}
+
+UErosChatComponent* UErosChatSubsystem::FindEndpointByUserId(const FErosUserId& UserId)
+{
+	if (!UserId.IsValid())
+	{
+		return nullptr;
+	}
+
+	auto IsMatch = [&UserId](const UErosChatComponent* Endpoint)
+	{
+		const AErosSocialPlayerState* PlayerState = GetEndpointPlayerState(Endpoint);
+		return PlayerState && PlayerState->UserID == UserId;
+	};
+
+	if (const TWeakObjectPtr<UErosChatComponent>* Cached = EndpointsByUserId.Find(UserId))
+	{
+		if (IsMatch(Cached->Get()))
+		{
+			return Cached->Get();
+		}
+	}
+
+	// Cache velho ou jogador novo: reconstrói a partir dos endpoints registrados
+	EndpointsByUserId.Reset();
+	for (const TWeakObjectPtr<UErosChatComponent>& Endpoint : Endpoints)
+	{
+		const AErosSocialPlayerState* PlayerState = GetEndpointPlayerState(Endpoint.Get());
+		if (PlayerState && PlayerState->UserID.IsValid())
+		{
+			EndpointsByUserId.Add(PlayerState->UserID, Endpoint);
+		}
+	}
+
+	const TWeakObjectPtr<UErosChatComponent>* Found = EndpointsByUserId.Find(UserId);
+	return Found ? Found->Get() : nullptr;
+}
+
+void UErosChatSubsystem::RouteMessage(UErosChatComponent* Sender, EErosChatChannel Channel, const FErosUserId& TargetUserId, const FString& Text)
+{
+	FInboundMessage& Inbound = InboundMessages.AddDefaulted_GetRef();
+	Inbound.Sender = Sender;
+	Inbound.Channel = Channel;
+	Inbound.TargetUserId = TargetUserId;
+	Inbound.Text = Text.Left(FMath::Max(MaxMessageLength, 1)).TrimStartAndEnd();
+}
+
+void UErosChatSubsystem::LaunchFilterJob()
+{
+	if (InboundMessages.Num() == 0)
+	{
+		return;
+	}
+
+	TSharedRef<FFilterJob, ESPMode::ThreadSafe> Job = MakeShared<FFilterJob, ESPMode::ThreadSafe>();
+	Job->Messages = MoveTemp(InboundMessages);
+	InboundMessages.Reset();
+
+	if (!Filter.IsValid() || Filter->IsEmpty())
+	{
+		// Nada a filtrar: o job já nasce pronto (FTask vazio conta como completo)
+		FilterJobs.Add(Job);
+		return;
+	}
+
+	// A task só mexe no Text das mensagens do job; o resto é lido de volta na game thread
+	Job->Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job, JobFilter = Filter]()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ErosChat_Filter);
+
+		TArray<FInboundMessage>& Messages = Job->Messages;
+		ParallelFor(TEXT("ErosChatFilter"), Messages.Num(), 32, [&Messages, &JobFilter](int32 Index)
+		{
+			if (JobFilter->Censor(Messages[Index].Text) > 0)
+			{
+				INC_DWORD_STAT(STAT_ErosChat_Censored);
+			}
+		});
+	});
+
+	FilterJobs.Add(Job);
+}
+
+void UErosChatSubsystem::DrainFilterJobs()
+{
+	int32 NumDone = 0;
+	for (const TSharedRef<FFilterJob, ESPMode::ThreadSafe>& Job : FilterJobs)
+	{
+		if (!Job->Task.IsCompleted())
+		{
+			break;
+		}
+
+		for (const FInboundMessage& Inbound : Job->Messages)
+		{
+			if (UErosChatComponent* Sender = Inbound.Sender.Get())
+			{
+				DeliverMessage(Sender, Inbound.Channel, Inbound.TargetUserId, Inbound.Text);
+			}
+		}
+		++NumDone;
+	}
+
+	FilterJobs.RemoveAt(0, NumDone, EAllowShrinking::No);
+}
+
+void UErosChatSubsystem::DeliverMessage(UErosChatComponent* Sender, EErosChatChannel Channel, const FErosUserId& TargetUserId, const FString& Text)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosChat_Route);
+
+	AErosSocialPlayerState* SenderPS = GetEndpointPlayerState(Sender);
+	if (!SenderPS || Text.IsEmpty())
+	{
+		return;
+	}
+
+	FErosChatWireMessage Message;
+	Message.Channel = Channel;
+	Message.SenderId = SenderPS->UserID;
+	Message.SenderName = SenderPS->CharacterName;
+	Message.Text = Text;
+
+	RecipientScratch.Reset();
+	RecipientScratch.Add(Sender);
+
+	switch (Channel)
+	{
+	case EErosChatChannel::Proximity:
+	{
+		UErosProximitySubsystem* Proximity = UErosProximitySubsystem::Get(this);
+		const APawn* SenderPawn = SenderPS->GetPawn();
+		if (Proximity && SenderPawn)
+		{
+			Proximity->QueryRadius(SenderPawn->GetActorLocation(), ProximityRadius, ProximityScratch, SenderPawn);
+			for (const AErosSocialCharacter* Character : ProximityScratch)
+			{
+				if (UErosChatComponent* Recipient = GetEndpointForController(Character->GetController()))
+				{
+					RecipientScratch.AddUnique(Recipient);
+				}
+			}
+		}
+		break;
+	}
+
+	case EErosChatChannel::Private:
+	{
+		UErosChatComponent* Recipient = FindEndpointByUserId(TargetUserId);
+		if (!Recipient)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("UErosChatSubsystem::DeliverMessage - Private target %s is offline"), *TargetUserId.ToString());
+			return;
+		}
+		RecipientScratch.AddUnique(Recipient);
+		Message.RecipientId = TargetUserId;
+
+		// Conversa privada: os dois em taxa cheia
+		if (UErosNetUpdateRateManager* RateManager = UErosNetUpdateRateManager::Get(this))
+		{
+			RateManager->NotifyInteraction(SenderPS, GetEndpointPlayerState(Recipient));
+		}
+		break;
+	}
+
+	case EErosChatChannel::Partner:
+	{
+		const AErosSocialPlayerState* PartnerPS = SenderPS->GetPartner();
+		UErosChatComponent* Recipient = PartnerPS ? GetEndpointForController(PartnerPS->GetOwningController()) : nullptr;
+		if (!Recipient)
+		{
+			return;
+		}
+		RecipientScratch.AddUnique(Recipient);
+		break;
+	}
+
+	default:
+		return;
+	}
+
+	for (UErosChatComponent* Recipient : RecipientScratch)
+	{
+		if (!Recipient->HasPendingOutgoing())
+		{
+			PendingEndpoints.Add(Recipient);
+		}
+		Recipient->QueueOutgoing(Message);
+	}
+}
+
+// ========== CLIENTE ==========
+
+void UErosChatSubsystem::ReceiveBatch(const FErosChatBatch& Batch)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	UErosChatHistorySubsystem* PrivateHistory = UErosChatHistorySubsystem::Get(this);
+
+	for (const FErosChatWireMessage& Wire : Batch.Messages)
+	{
+		if (Wire.Channel >= EErosChatChannel::MAX)
+		{
+			continue;
+		}
+
+		Histories[static_cast<int32>(Wire.Channel)].Add(Wire.SenderId, Wire.SenderName, Wire.Text, Now);
+
+		// Conversas privadas também vão para o log em disco (sobrevive a relog)
+		if (Wire.Channel == EErosChatChannel::Private && PrivateHistory)
+		{
+			PrivateHistory->RecordPrivateMessage(Wire.SenderId, Wire.RecipientId, Wire.SenderName, Wire.Text);
+		}
+
+		if (OnChatMessageReceived.IsBound())
+		{
+			FErosChatMessage Message;
+			Message.Channel = Wire.Channel;
+			Message.SenderId = Wire.SenderId;
+			Message.SenderName = Wire.SenderName;
+			Message.Text = Wire.Text;
+			Message.Timestamp = Now;
+			OnChatMessageReceived.Broadcast(Message);
+		}
+	}
+}
+
+TArray<FErosChatMessage> UErosChatSubsystem::GetRecentMessages(EErosChatChannel Channel, int32 MaxMessages) const
+{
+	TArray<FErosChatMessage> Messages;
+	if (Channel >= EErosChatChannel::MAX)
+	{
+		return Messages;
+	}
+
+	const FErosChatRingBuffer& History = GetHistory(Channel);
+	const int32 First = FMath::Max(0, History.Num() - FMath::Max(MaxMessages, 0));
+
+	Messages.Reserve(History.Num() - First);
+	for (int32 Index = First; Index < History.Num(); ++Index)
+	{
+		const FErosChatMessageView View = History.Get(Index);
+
+		FErosChatMessage& Message = Messages.AddDefaulted_GetRef();
+		Message.Channel = Channel;
+		Message.SenderId = View.SenderId;
+		Message.SenderName = FString(View.SenderName);
+		Message.Text = FString(View.Text);
+		Message.Timestamp = View.Timestamp;
+	}
+
+	return Messages;
+}
@@ -0,0 +1,147 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatSubsystem.h
+// Roteamento (servidor) e histórico (cliente) do chat
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "Systems/Chat/ErosChatTypes.h"
+#include "Systems/Chat/ErosChatRingBuffer.h"
+#include "ErosChatSubsystem.generated.h"
+
+class AErosSocialCharacter;
+class AErosSocialPlayerState;
+class FErosChatFilter;
+class UErosChatComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FErosOnChatMessageReceived, const FErosChatMessage&, Message);
+
+/**
+ * Chat nativo
+ *
+ * Servidor:
+ * - O texto passa pelo FErosChatFilter em worker threads: as mensagens de um frame viram um job,
+ *   e os jobs são roteados na ordem em que chegaram assim que terminam (normalmente no frame seguinte)
+ * - Cada mensagem vai só para o conjunto de interesse do canal (o remetente sempre recebe o eco)
+ *   Proximity: personagens a até ProximityRadius (UErosProximitySubsystem)
+ *   Private: o dono do TargetUserId
+ *   Partner: o partner atual do remetente
+ * - As mensagens ficam na fila do UErosChatComponent de cada destinatário e saem num único RPC por conexão no Tick
+ *
+ * Cliente:
+ * - Histórico por canal em FErosChatRingBuffer (memória fixa, sem FString por mensagem)
+ */
+UCLASS(config = Game)
+class EROSSOCIAL_API UErosChatSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosChatSubsystem* Get(const UObject* WorldContextObject);
+
+	// USubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ========== SERVIDOR ==========
+
+	void RegisterEndpoint(UErosChatComponent* Endpoint);
+	void UnregisterEndpoint(UErosChatComponent* Endpoint);
+
+	/** Enfileira para filtragem; o roteamento acontece quando o job do frame termina */
+	void RouteMessage(UErosChatComponent* Sender, EErosChatChannel Channel, const FErosUserId& TargetUserId, const FString& Text);
+
+	/** Troca a lista de palavras do filtro (jobs em andamento terminam com a lista antiga) */
+	void SetFilterWords(const TArray<FString>& Words);
+
+	// ========== CLIENTE ==========
+
+	void ReceiveBatch(const FErosChatBatch& Batch);
+
+	const FErosChatRingBuffer& GetHistory(EErosChatChannel Channel) const { return Histories[static_cast<int32>(Channel)]; }
+
+	/** Até MaxMessages mensagens mais recentes do canal, da mais antiga para a mais nova */
+	UFUNCTION(BlueprintCallable, Category = "Chat")
+	TArray<FErosChatMessage> GetRecentMessages(EErosChatChannel Channel, int32 MaxMessages = 50) const;
+
+	UPROPERTY(BlueprintAssignable, Category = "Chat")
+	FErosOnChatMessageReceived OnChatMessageReceived;
+
+	// ========== CONFIGURAÇÃO (DefaultGame.ini) ==========
+
+	UPROPERTY(Config)
+	float ProximityRadius = 2000.0f;
+
+	// Mensagens maiores são cortadas no servidor
+	UPROPERTY(Config)
+	int32 MaxMessageLength = 256;
+
+	UPROPERTY(Config)
+	int32 HistoryMessagesPerChannel = 200;
+
+	// Caracteres (nome + texto) por canal
+	UPROPERTY(Config)
+	int32 HistoryTextCapacity = 32768;
+
+	// Termos bloqueados (um por entrada: +FilterWords=...)
+	UPROPERTY(Config)
+	TArray<FString> FilterWords;
+
+private:
+	struct FInboundMessage
+	{
+		TWeakObjectPtr<UErosChatComponent> Sender;
+		EErosChatChannel Channel = EErosChatChannel::Proximity;
+		FErosUserId TargetUserId;
+		FString Text;
+	};
+
+	struct FFilterJob
+	{
+		TArray<FInboundMessage> Messages;
+		UE::Tasks::FTask Task;
+	};
+
+	/** Manda as mensagens do frame para as workers */
+	void LaunchFilterJob();
+
+	/** Roteia os jobs prontos, sem pular nenhum (mantém a ordem das mensagens) */
+	void DrainFilterJobs();
+
+	void DeliverMessage(UErosChatComponent* Sender, EErosChatChannel Channel, const FErosUserId& TargetUserId, const FString& Text);
+
+	UErosChatComponent* FindEndpointByUserId(const FErosUserId& UserId);
+
+	static UErosChatComponent* GetEndpointForController(AController* Controller);
+	static AErosSocialPlayerState* GetEndpointPlayerState(const UErosChatComponent* Endpoint);
+
+	TArray<TWeakObjectPtr<UErosChatComponent>> Endpoints;
+
+	// Reconstruído sob demanda: o UserID só chega no PlayerState depois do login
+	TMap<FErosUserId, TWeakObjectPtr<UErosChatComponent>> EndpointsByUserId;
+
+	// Endpoints com fila para o próximo flush
+	TArray<TWeakObjectPtr<UErosChatComponent>> PendingEndpoints;
+
+	TArray<FErosChatRingBuffer> Histories;
+
+	// Compartilhado com os jobs: trocar a lista não afeta os que já estão rodando
+	TSharedPtr<const FErosChatFilter, ESPMode::ThreadSafe> Filter;
+
+	// Recebidas neste frame (ainda não filtradas)
+	TArray<FInboundMessage> InboundMessages;
+
+	// Em ordem de criação
+	TArray<TSharedRef<FFilterJob, ESPMode::ThreadSafe>> FilterJobs;
+
+	// Reaproveitados pelo roteamento
+	TArray<AErosSocialCharacter*> ProximityScratch;
+	TArray<UErosChatComponent*> RecipientScratch;
+};
@@ -0,0 +1,81 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosChatTypes.h
+// Tipos compartilhados do chat (canais, mensagens de rede e de Blueprint)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ErosUserId.h"
+#include "ErosChatTypes.generated.h"
+
+UENUM(BlueprintType)
+enum class EErosChatChannel : uint8
+{
+	Proximity   UMETA(DisplayName = "Proximity"),
+	Private     UMETA(DisplayName = "Private"),
+	Partner     UMETA(DisplayName = "Partner"),
+	MAX         UMETA(Hidden)
+};
+
+/**
+ * Mensagem como trafega na rede (dentro de um FErosChatBatch)
+ */
+USTRUCT()
+struct FErosChatWireMessage
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EErosChatChannel Channel = EErosChatChannel::Proximity;
+
+	UPROPERTY()
+	FErosUserId SenderId;
+
+	// Só no canal Private (identifica a conversa no eco para o remetente)
+	UPROPERTY()
+	FErosUserId RecipientId;
+
+	// O PlayerState do remetente pode não ser relevante para quem recebe
+	UPROPERTY()
+	FString SenderName;
+
+	UPROPERTY()
+	FString Text;
+};
+
+/**
+ * Todas as mensagens de um net tick para uma conexão (um único RPC)
+ */
+USTRUCT()
+struct FErosChatBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FErosChatWireMessage> Messages;
+};
+
+/**
+ * Cópia de uma mensagem do histórico para Blueprint/UI
+ */
+USTRUCT(BlueprintType)
+struct FErosChatMessage
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	EErosChatChannel Channel = EErosChatChannel::Proximity;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	FErosUserId SenderId;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	FString SenderName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	FString Text;
+
+	// GetTimeSeconds do mundo local no recebimento
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	float Timestamp = 0.0f;
+};
@@ -5,6 +5,28 @@
 #include "GameFramework/Pawn.h"
 #include "GameFramework/Character.h"
 #include "SaveSystem/SaveGameManager.h"
+#include "Systems/Profiling/ErosSpawnProfiler.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+namespace
+{
+	// Mesma ordem de EClothingSlot (nomes usados no save)
+	const TCHAR* const ClothingSlotNames[] =
+	{
+		TEXT("Top"), TEXT("Bottom"), TEXT("Shoes"), TEXT("Hat"),
+		TEXT("Accessories"), TEXT("Underwear"), TEXT("Socks"), TEXT("Gloves")
+	};
+	static_assert(UE_ARRAY_COUNT(ClothingSlotNames) == NumClothingSlots, "Um nome por EClothingSlot");
+
+	// Mesma peça (só a cor pode mudar sem recriar)
+	bool IsSameClothingPiece(const FEquippedClothingItem& A, const FEquippedClothingItem& B)
+	{
+		return A.ItemID == B.ItemID
+			&& A.MeshPath == B.MeshPath
+			&& A.MaterialPath == B.MaterialPath;
+	}
+}
 
 UClothingSystem::UClothingSystem()
 	: TargetCharacter(nullptr)
@@ -14,6 +36,8 @@ UClothingSystem::UClothingSystem()
 
 void UClothingSystem::Initialize(APawn* InTargetCharacter)
 {
+	EROS_SPAWN_STAGE_SCOPE(ClothingInit);
+
 	if (!InTargetCharacter)
 	{
 		UE_LOG(LogTemp, Error, TEXT("ClothingSystem::Initialize - TargetCharacter is null!"));
@@ -41,19 +65,25 @@ bool UClothingSystem::EquipClothing(const FEquippedClothingItem& ClothingItem)
 		return false;
 	}
 
+	if (!IsValidSlot(ClothingItem.SlotType))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ClothingSystem::EquipClothing - Invalid slot %d"), (int32)ClothingItem.SlotType);
+		return false;
+	}
+
 	// Se já tem roupa nesse slot, remover antes
-	if (EquippedItems.Contains(ClothingItem.SlotType))
+	if (IsSlotEquipped(ClothingItem.SlotType))
 	{
 		UnequipClothing(ClothingItem.SlotType);
 	}
 
-	// Adicionar ao mapa
-	EquippedItems.Add(ClothingItem.SlotType, ClothingItem);
+	EquippedItems[static_cast<int32>(ClothingItem.SlotType)] = ClothingItem;
+	EquippedSlotMask |= SlotBit(ClothingItem.SlotType);
 
 	// Aplicar material (implementar depois com mesh)
 	ApplyMaterialToClothing(ClothingItem);
 
-	UE_LOG(LogTemp, Warning, TEXT("ClothingSystem::EquipClothing - Equipped %s in slot %d"), 
+	UE_LOG(LogTemp, Verbose, TEXT("ClothingSystem::EquipClothing - Equipped %s in slot %d"), 
 		   *ClothingItem.ItemName, (int32)ClothingItem.SlotType);
 
 	return true;
@@ -61,38 +91,40 @@ bool UClothingSystem::EquipClothing(const FEquippedClothingItem& ClothingItem)
 
 bool UClothingSystem::UnequipClothing(EClothingSlot SlotType)
 {
-	if (!EquippedItems.Contains(SlotType))
+	if (!IsSlotEquipped(SlotType))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("ClothingSystem::UnequipClothing - No item equipped in slot %d"), (int32)SlotType);
 		return false;
 	}
 
 	RemoveMaterialFromClothing(SlotType);
-	EquippedItems.Remove(SlotType);
+	EquippedItems[static_cast<int32>(SlotType)] = FEquippedClothingItem();
+	EquippedSlotMask &= ~SlotBit(SlotType);
 
-	UE_LOG(LogTemp, Warning, TEXT("ClothingSystem::UnequipClothing - Unequipped slot %d"), (int32)SlotType);
+	UE_LOG(LogTemp, Verbose, TEXT("ClothingSystem::UnequipClothing - Unequipped slot %d"), (int32)SlotType);
 
 	return true;
 }
 
 void UClothingSystem::UnequipAll()
 {
-	TArray<EClothingSlot> SlotsToRemove;
-	EquippedItems.GetKeys(SlotsToRemove);
-
-	for (EClothingSlot Slot : SlotsToRemove)
+	for (int32 SlotIndex = 0; SlotIndex < NumClothingSlots; ++SlotIndex)
 	{
-		UnequipClothing(Slot);
+		const EClothingSlot Slot = static_cast<EClothingSlot>(SlotIndex);
+		if (IsSlotEquipped(Slot))
+		{
+			UnequipClothing(Slot);
+		}
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("ClothingSystem::UnequipAll - Unequipped all items"));
+	UE_LOG(LogTemp, Verbose, TEXT("ClothingSystem::UnequipAll - Unequipped all items"));
 }
 
 bool UClothingSystem::GetEquippedItem(EClothingSlot SlotType, FEquippedClothingItem& OutItem) const
 {
-	if (EquippedItems.Contains(SlotType))
+	if (IsSlotEquipped(SlotType))
 	{
-		OutItem = EquippedItems[SlotType];
+		OutItem = EquippedItems[static_cast<int32>(SlotType)];
 		return true;
 	}
 
@@ -101,17 +133,24 @@ bool UClothingSystem::GetEquippedItem(EClothingSlot SlotType, FEquippedClothingI
 
 bool UClothingSystem::IsSlotEquipped(EClothingSlot SlotType) const
 {
-	return EquippedItems.Contains(SlotType);
+	return IsValidSlot(SlotType) && (EquippedSlotMask & SlotBit(SlotType)) != 0;
 }
 
 void UClothingSystem::GetAllEquippedItems(TArray<FEquippedClothingItem>& OutItems) const
 {
-	EquippedItems.GenerateValueArray(OutItems);
+	OutItems.Reset(GetEquippedItemCount());
+	for (int32 SlotIndex = 0; SlotIndex < NumClothingSlots; ++SlotIndex)
+	{
+		if (IsSlotEquipped(static_cast<EClothingSlot>(SlotIndex)))
+		{
+			OutItems.Add(EquippedItems[SlotIndex]);
+		}
+	}
 }
 
-bool UClothingSystem::SaveCurrentOutfit(const FString& OutfitName, const FString& UserID)
+bool UClothingSystem::SaveCurrentOutfit(const FString& OutfitName, const FErosUserId& UserID)
 {
-	if (!SaveGameManager || OutfitName.IsEmpty() || UserID.IsEmpty())
+	if (!SaveGameManager || OutfitName.IsEmpty() || !UserID.IsValid())
 	{
 		return false;
 	}
@@ -123,9 +162,9 @@ bool UClothingSystem::SaveCurrentOutfit(const FString& OutfitName, const FString
 	return SaveGameManager->SaveOutfit(OutfitData, UserID, OutfitName);
 }
 
-bool UClothingSystem::LoadOutfit(const FString& OutfitName, const FString& UserID)
+bool UClothingSystem::LoadOutfit(const FString& OutfitName, const FErosUserId& UserID)
 {
-	if (!SaveGameManager || OutfitName.IsEmpty() || UserID.IsEmpty())
+	if (!SaveGameManager || OutfitName.IsEmpty() || !UserID.IsValid())
 	{
 		return false;
 	}
@@ -143,10 +182,16 @@ FOutfitData UClothingSystem::GetCurrentOutfitData() const
 {
 	FOutfitData OutfitData;
 
-	for (const auto& Pair : EquippedItems)
+	OutfitData.ClothingItems.Reserve(GetEquippedItemCount());
+	for (int32 SlotIndex = 0; SlotIndex < NumClothingSlots; ++SlotIndex)
 	{
-		const FEquippedClothingItem& Item = Pair.Value;
-		
+		if (!IsSlotEquipped(static_cast<EClothingSlot>(SlotIndex)))
+		{
+			continue;
+		}
+
+		const FEquippedClothingItem& Item = EquippedItems[SlotIndex];
+
 		FClothingItemData ItemData;
 		ItemData.ItemID = Item.ItemID;
 		ItemData.SlotType = SlotToString(Item.SlotType);
@@ -163,24 +208,74 @@ FOutfitData UClothingSystem::GetCurrentOutfitData() const
 
 bool UClothingSystem::ApplyOutfitData(const FOutfitData& OutfitData)
 {
-	UnequipAll();
+	EROS_SPAWN_STAGE_SCOPE(Outfit);
+
+	// Estado desejado por slot (a última peça de um slot vence, como antes)
+	FEquippedClothingItem Target[NumClothingSlots];
+	uint32 TargetSlotMask = 0;
 
 	for (const FClothingItemData& ItemData : OutfitData.ClothingItems)
 	{
-		FEquippedClothingItem EquippedItem;
-		EquippedItem.SlotType = StringToSlot(ItemData.SlotType);
+		EClothingSlot SlotType;
+		if (!StringToSlot(ItemData.SlotType, SlotType))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ClothingSystem::ApplyOutfitData - Unknown slot '%s' for item: %s"), *ItemData.SlotType, *ItemData.ItemID);
+			continue;
+		}
+
+		FEquippedClothingItem& EquippedItem = Target[static_cast<int32>(SlotType)];
+		EquippedItem.SlotType = SlotType;
 		EquippedItem.ItemID = ItemData.ItemID;
 		EquippedItem.MeshPath = ItemData.MeshPath;
 		EquippedItem.MaterialPath = ItemData.MaterialPath;
 		EquippedItem.Color = ItemData.Color;
 		EquippedItem.ItemName = ItemData.ItemID;
+		TargetSlotMask |= SlotBit(SlotType);
+	}
+
+	// Diff por slot: iguais ficam como estão
+	int32 NumChanged = 0;
+	for (int32 SlotIndex = 0; SlotIndex < NumClothingSlots; ++SlotIndex)
+	{
+		const EClothingSlot SlotType = static_cast<EClothingSlot>(SlotIndex);
+		const bool bWanted = (TargetSlotMask & SlotBit(SlotType)) != 0;
+		const bool bEquipped = IsSlotEquipped(SlotType);
+
+		if (!bWanted)
+		{
+			if (bEquipped)
+			{
+				UnequipClothing(SlotType);
+				++NumChanged;
+			}
+			continue;
+		}
+
+		FEquippedClothingItem& Current = EquippedItems[SlotIndex];
+		const FEquippedClothingItem& Wanted = Target[SlotIndex];
+
+		if (bEquipped && IsSameClothingPiece(Current, Wanted))
+		{
+			// Mesma peça: no máximo troca a cor
+			if (Current.Color != Wanted.Color)
+			{
+				Current.Color = Wanted.Color;
+				ApplyMaterialToClothing(Current);
+				++NumChanged;
+			}
+			continue;
+		}
 
-		if (!EquipClothing(EquippedItem))
+		if (!EquipClothing(Wanted))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("ClothingSystem::ApplyOutfitData - Failed to equip item: %s"), *ItemData.ItemID);
+			UE_LOG(LogTemp, Warning, TEXT("ClothingSystem::ApplyOutfitData - Failed to equip item: %s"), *Wanted.ItemID);
+			continue;
 		}
+		++NumChanged;
 	}
 
+	UE_LOG(LogTemp, Verbose, TEXT("ClothingSystem::ApplyOutfitData - %d slots changed"), NumChanged);
+
 	return true;
 }
 
@@ -201,7 +296,7 @@ int32 UClothingSystem::GetTotalSlots() const
 
 int32 UClothingSystem::GetEquippedItemCount() const
 {
-	return EquippedItems.Num();
+	return FMath::CountBits(EquippedSlotMask);
 }
 
 void UClothingSystem::InitializeSocketMap()
@@ -224,43 +319,127 @@ bool UClothingSystem::ApplyMaterialToClothing(const FEquippedClothingItem& Item)
 {
 	// Implementação será feita quando integrar com Character Pawn
 	// Por enquanto, apenas log
-	UE_LOG(LogTemp, Log, TEXT("ClothingSystem::ApplyMaterialToClothing - Applied material to: %s"), *Item.ItemName);
+	UE_LOG(LogTemp, Verbose, TEXT("ClothingSystem::ApplyMaterialToClothing - Applied material to: %s"), *Item.ItemName);
 	return true;
 }
 
 bool UClothingSystem::RemoveMaterialFromClothing(EClothingSlot SlotType)
 {
 	// Implementação será feita quando integrar com Character Pawn
-	UE_LOG(LogTemp, Log, TEXT("ClothingSystem::RemoveMaterialFromClothing - Removed material from slot: %d"), (int32)SlotType);
+	UE_LOG(LogTemp, Verbose, TEXT("ClothingSystem::RemoveMaterialFromClothing - Removed material from slot: %d"), (int32)SlotType);
 	return true;
 }
 
 FString UClothingSystem::SlotToString(EClothingSlot SlotType) const
 {
-	switch (SlotType)
+	return IsValidSlot(SlotType) ? ClothingSlotNames[static_cast<int32>(SlotType)] : TEXT("Unknown");
+}
+
+bool UClothingSystem::StringToSlot(const FString& SlotString, EClothingSlot& OutSlot) const
+{
+	for (int32 SlotIndex = 0; SlotIndex < NumClothingSlots; ++SlotIndex)
 	{
-		case EClothingSlot::Top: return TEXT("Top");
-		case EClothingSlot::Bottom: return TEXT("Bottom");
-		case EClothingSlot::Shoes: return TEXT("Shoes");
-		case EClothingSlot::Hat: return TEXT("Hat");
-		case EClothingSlot::Accessories: return TEXT("Accessories");
-		case EClothingSlot::Underwear: return TEXT("Underwear");
-		case EClothingSlot::Socks: return TEXT("Socks");
-		case EClothingSlot::Gloves: return TEXT("Gloves");
-		default: return TEXT("Unknown");
+		if (SlotString.Equals(ClothingSlotNames[SlotIndex], ESearchCase::IgnoreCase))
+		{
+			OutSlot = static_cast<EClothingSlot>(SlotIndex);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Benchmark
+
+namespace
+{
+	// Seed fixa: resultados comparáveis entre builds
+	FOutfitData MakeBenchmarkOutfit(FRandomStream& Random, const FOutfitData* Previous, int32 ChangedSlots)
+	{
+		if (!Previous)
+		{
+			FOutfitData Outfit;
+			for (const TCHAR* SlotName : ClothingSlotNames)
+			{
+				FClothingItemData& Item = Outfit.ClothingItems.AddDefaulted_GetRef();
+				Item.ItemID = FString::Printf(TEXT("bench_%s_%d"), SlotName, Random.RandRange(0, 9));
+				Item.SlotType = SlotName;
+				Item.MeshPath = FString::Printf(TEXT("/Game/Clothing/%s/SK_%s"), SlotName, *Item.ItemID);
+				Item.Color = FLinearColor(Random.FRand(), Random.FRand(), Random.FRand());
+			}
+			return Outfit;
+		}
+
+		// Troca ChangedSlots peças (ex: só o sapato) e mantém o resto
+		FOutfitData Outfit = *Previous;
+		for (int32 Change = 0; Change < ChangedSlots; ++Change)
+		{
+			FClothingItemData& Item = Outfit.ClothingItems[Random.RandRange(0, Outfit.ClothingItems.Num() - 1)];
+			Item.ItemID = FString::Printf(TEXT("bench_%s_%d"), *Item.SlotType, Random.RandRange(0, 9));
+			Item.MeshPath = FString::Printf(TEXT("/Game/Clothing/%s/SK_%s"), *Item.SlotType, *Item.ItemID);
+		}
+		return Outfit;
 	}
 }
 
-EClothingSlot UClothingSystem::StringToSlot(const FString& SlotString) const
+static void ErosOutfitSwapBenchmark(const TArray<FString>& Args, UWorld* World)
 {
-	if (SlotString == TEXT("Top")) return EClothingSlot::Top;
-	if (SlotString == TEXT("Bottom")) return EClothingSlot::Bottom;
-	if (SlotString == TEXT("Shoes")) return EClothingSlot::Shoes;
-	if (SlotString == TEXT("Hat")) return EClothingSlot::Hat;
-	if (SlotString == TEXT("Accessories")) return EClothingSlot::Accessories;
-	if (SlotString == TEXT("Underwear")) return EClothingSlot::Underwear;
-	if (SlotString == TEXT("Socks")) return EClothingSlot::Socks;
-	if (SlotString == TEXT("Gloves")) return EClothingSlot::Gloves;
-
-	return EClothingSlot::Top;
-}
\ No newline at end of file
+	const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	if (!Pawn)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Eros.Clothing.OutfitSwapBenchmark - Needs a local pawn"));
+		return;
+	}
+
+	const int32 NumSwaps = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+	const int32 ChangedSlots = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, NumClothingSlots) : 1;
+
+	// Sequência de outfits gerada antes: só a aplicação entra no tempo
+	FRandomStream Random(1337);
+	TArray<FOutfitData> Outfits;
+	Outfits.Reserve(NumSwaps + 1);
+	Outfits.Add(MakeBenchmarkOutfit(Random, nullptr, ChangedSlots));
+	for (int32 Index = 0; Index < NumSwaps; ++Index)
+	{
+		Outfits.Add(MakeBenchmarkOutfit(Random, &Outfits.Last(), ChangedSlots));
+	}
+
+	// Sistema separado: não mexe nas roupas do personagem
+	UClothingSystem* Clothing = NewObject<UClothingSystem>(GetTransientPackage());
+	Clothing->Initialize(Pawn);
+
+	// Diff (caminho normal) contra recriar tudo (UnequipAll + equipar de novo, comportamento antigo)
+	auto RunPass = [&Outfits, Clothing](bool bFullRebuild)
+	{
+		Clothing->UnequipAll();
+		Clothing->ApplyOutfitData(Outfits[0]);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 1; Index < Outfits.Num(); ++Index)
+		{
+			if (bFullRebuild)
+			{
+				Clothing->UnequipAll();
+			}
+			Clothing->ApplyOutfitData(Outfits[Index]);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	const double DiffSeconds = RunPass(false);
+	const double RebuildSeconds = RunPass(true);
+
+	UE_LOG(LogTemp, Log, TEXT("Eros.Clothing.OutfitSwapBenchmark - %d swaps, %d changed slot(s) per swap (slot bookkeeping only; mesh/material equip are stubs)"), NumSwaps, ChangedSlots);
+	UE_LOG(LogTemp, Log, TEXT("  Diff:         %.2f ms total, %.0f swaps/s"), DiffSeconds * 1000.0, NumSwaps / FMath::Max(DiffSeconds, UE_DOUBLE_SMALL_NUMBER));
+	UE_LOG(LogTemp, Log, TEXT("  Full rebuild: %.2f ms total, %.0f swaps/s"), RebuildSeconds * 1000.0, NumSwaps / FMath::Max(RebuildSeconds, UE_DOUBLE_SMALL_NUMBER));
+
+	Clothing->MarkAsGarbage();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ErosOutfitSwapBenchmarkCmd(
+	TEXT("Eros.Clothing.OutfitSwapBenchmark"),
+	TEXT("Mede trocas de outfit por segundo (diff por slot vs recriar tudo). Args: [Swaps=10000] [ChangedSlots=1]. ")
+	TEXT("Só a contabilidade dos slots: equipar mesh e aplicar material ainda são stubs, então swaps/s não é o custo real de equipar"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ErosOutfitSwapBenchmark));
@@ -7,6 +7,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "CharacterSaveData.h"
+#include "ErosUserId.h"
 #include "ClothingSystem.generated.h"
 
 /**
@@ -26,6 +27,8 @@ enum class EClothingSlot : uint8
 	Count		UMETA(Hidden)
 };
 
+static constexpr int32 NumClothingSlots = static_cast<int32>(EClothingSlot::Count);
+
 /**
  * Estrutura para uma peça de roupa em uso
  */
@@ -122,13 +125,13 @@ public:
 	 * Salva o outfit atual como um arquivo .finesse
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Clothing")
-	bool SaveCurrentOutfit(const FString& OutfitName, const FString& UserID);
+	bool SaveCurrentOutfit(const FString& OutfitName, const FErosUserId& UserID);
 
 	/**
 	 * Carrega um outfit de um arquivo .finesse
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Clothing")
-	bool LoadOutfit(const FString& OutfitName, const FString& UserID);
+	bool LoadOutfit(const FString& OutfitName, const FErosUserId& UserID);
 
 	/**
 	 * Converte roupas equipadas para FOutfitData
@@ -138,6 +141,7 @@ public:
 
 	/**
 	 * Carrega um outfit a partir de FOutfitData
+	 * Só os slots que mudaram são tocados (peça nova, peça removida ou só a cor)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Clothing")
 	bool ApplyOutfitData(const FOutfitData& OutfitData);
@@ -167,9 +171,14 @@ protected:
 	UPROPERTY()
 	class APawn* TargetCharacter;
 
-	// Mapa de roupas equipadas por slot
-	UPROPERTY(VisibleAnywhere, Category = "Clothing")
-	TMap<EClothingSlot, FEquippedClothingItem> EquippedItems;
+	// Roupas equipadas, indexadas por EClothingSlot (válidas só com o bit do slot em EquippedSlotMask)
+	UPROPERTY(VisibleAnywhere, Category = "Clothing", meta = (ArraySizeEnum = "EClothingSlot"))
+	FEquippedClothingItem EquippedItems[NumClothingSlots];
+
+	// Bit (1 << slot) por slot ocupado
+	uint32 EquippedSlotMask = 0;
+
+	static_assert(NumClothingSlots <= 32, "EquippedSlotMask tem um bit por slot");
 
 	// Referência ao SaveGameManager
 	UPROPERTY()
@@ -204,7 +213,11 @@ protected:
 	FString SlotToString(EClothingSlot SlotType) const;
 
 	/**
-	 * Converte string para enum
+	 * Converte string para enum (false se o nome não é de nenhum slot)
 	 */
-	EClothingSlot StringToSlot(const FString& SlotString) const;
+	bool StringToSlot(const FString& SlotString, EClothingSlot& OutSlot) const;
+
+	static uint32 SlotBit(EClothingSlot SlotType) { return 1u << static_cast<uint32>(SlotType); }
+
+	static bool IsValidSlot(EClothingSlot SlotType) { return static_cast<int32>(SlotType) < NumClothingSlots; }
 };
\ No newline at end of file
@@ -0,0 +1,224 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosAppearanceColors.cpp
+
+#include "Systems/Customization/ErosAppearanceColors.h"
+#include "Systems/Customization/ErosCustomizationStats.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "Hash/xxhash.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Appearance MIDs"), STAT_ErosAppearance_CachedMIDs, STATGROUP_ErosCustomization);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Appearance CPD Updates"), STAT_ErosAppearance_PrimitiveDataUpdates, STATGROUP_ErosCustomization);
+
+namespace
+{
+	const FName SkinColorParam(TEXT("SkinColor"));
+	const FName HairColorParam(TEXT("HairColor"));
+	const FName EyeColorParam(TEXT("EyeColor"));
+	const FName MakeupColorParam(TEXT("MakeupColor"));
+	const FName BodyHairDensityParam(TEXT("BodyHairDensity"));
+
+	void WriteColor(float* Out, const FLinearColor& Color, float W)
+	{
+		Out[0] = Color.R;
+		Out[1] = Color.G;
+		Out[2] = Color.B;
+		Out[3] = W;
+	}
+
+	FLinearColor ReadColor(const float* In)
+	{
+		return FLinearColor(In[0], In[1], In[2], In[3]);
+	}
+}
+
+FErosAppearancePrimitiveData FErosAppearancePrimitiveData::Pack(const FAppearanceCustomization& Appearance)
+{
+	FErosAppearancePrimitiveData Data;
+	WriteColor(Data.Values + SkinIndex, Appearance.SkinColor, Appearance.bHasBodyHair ? FMath::Clamp(Appearance.BodyHairDensity, 0.0f, 1.0f) : 0.0f);
+	WriteColor(Data.Values + HairIndex, Appearance.HairColor, 1.0f);
+	WriteColor(Data.Values + EyeIndex, Appearance.EyeColor, 1.0f);
+	WriteColor(Data.Values + MakeupIndex, Appearance.MakeupColor, Appearance.bHasMakeup ? Appearance.MakeupColor.A : 0.0f);
+	return Data;
+}
+
+void FErosAppearancePrimitiveData::Quantize(uint8 OutBytes[NumFloats]) const
+{
+	for (int32 Index = 0; Index < NumFloats; ++Index)
+	{
+		OutBytes[Index] = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Values[Index] * 255.0f), 0, 255));
+	}
+}
+
+void FErosAppearancePrimitiveData::ApplyToComponent(UPrimitiveComponent& Component) const
+{
+	// Cada Set* manda uma atualização para o render thread: só os vec4 que mudaram
+	const TArray<float>& Current = Component.GetCustomPrimitiveData().Data;
+	int32 NumUpdates = 0;
+	for (int32 Index = 0; Index < NumFloats; Index += 4)
+	{
+		const bool bChanged = Current.Num() < Index + 4
+			|| FMemory::Memcmp(Current.GetData() + Index, Values + Index, 4 * sizeof(float)) != 0;
+		if (bChanged)
+		{
+			Component.SetCustomPrimitiveDataVector4(Index, FVector4(GetVector(Index)));
+			++NumUpdates;
+		}
+	}
+	INC_DWORD_STAT_BY(STAT_ErosAppearance_PrimitiveDataUpdates, NumUpdates);
+
+	UErosAppearanceMaterialCache* MaterialCache = UErosAppearanceMaterialCache::Get(&Component);
+	if (!MaterialCache || MaterialCache->MIDFallbackMaterials.Num() == 0)
+	{
+		return;
+	}
+
+	for (int32 MaterialIndex = 0; MaterialIndex < Component.GetNumMaterials(); ++MaterialIndex)
+	{
+		UMaterialInterface* Source = MaterialCache->GetSourceMaterial(Component.GetMaterial(MaterialIndex));
+		if (Source && MaterialCache->NeedsFallback(Source))
+		{
+			UMaterialInstanceDynamic* Instance = MaterialCache->GetOrCreate(Source, *this);
+			if (Component.GetMaterial(MaterialIndex) != Instance)
+			{
+				Component.SetMaterial(MaterialIndex, Instance);
+			}
+		}
+	}
+}
+
+// ========== CACHE DE MIDS ==========
+
+UErosAppearanceMaterialCache* UErosAppearanceMaterialCache::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosAppearanceMaterialCache>() : nullptr;
+}
+
+bool UErosAppearanceMaterialCache::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Servidor dedicado não renderiza
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UErosAppearanceMaterialCache::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UErosAppearanceMaterialCache::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FallbackPaths.Reset();
+	for (const FSoftObjectPath& Path : MIDFallbackMaterials)
+	{
+		if (Path.IsValid())
+		{
+			FallbackPaths.Add(Path);
+		}
+	}
+}
+
+void UErosAppearanceMaterialCache::Deinitialize()
+{
+	Entries.Reset();
+	SET_DWORD_STAT(STAT_ErosAppearance_CachedMIDs, 0);
+
+	Super::Deinitialize();
+}
+
+void UErosAppearanceMaterialCache::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	UErosAppearanceMaterialCache* This = CastChecked<UErosAppearanceMaterialCache>(InThis);
+	for (TPair<uint64, FEntry>& Pair : This->Entries)
+	{
+		Collector.AddReferencedObject(Pair.Value.Material, This);
+	}
+}
+
+UMaterialInterface* UErosAppearanceMaterialCache::GetSourceMaterial(UMaterialInterface* Material) const
+{
+	const UMaterialInstanceDynamic* Instance = Cast<UMaterialInstanceDynamic>(Material);
+	if (Instance && Instance->GetOuter() == this)
+	{
+		return Instance->Parent;
+	}
+	return Material;
+}
+
+bool UErosAppearanceMaterialCache::NeedsFallback(const UMaterialInterface* Material) const
+{
+	for (const UMaterialInterface* Current = Material; Current; )
+	{
+		if (FallbackPaths.Contains(FSoftObjectPath(Current)))
+		{
+			return true;
+		}
+
+		const UMaterialInstance* Instance = Cast<UMaterialInstance>(Current);
+		Current = Instance ? Instance->Parent.Get() : nullptr;
+	}
+	return false;
+}
+
+UMaterialInstanceDynamic* UErosAppearanceMaterialCache::GetOrCreate(UMaterialInterface* Parent, const FErosAppearancePrimitiveData& Data)
+{
+	uint8 Quantized[FErosAppearancePrimitiveData::NumFloats];
+	Data.Quantize(Quantized);
+
+	FXxHash64Builder Builder;
+	Builder.Update(&Parent, sizeof(Parent));
+	Builder.Update(Quantized, sizeof(Quantized));
+	const uint64 Key = Builder.Finalize().Hash;
+
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		Entry->LastUsedFrame = GFrameCounter;
+		return Entry->Material;
+	}
+
+	// Os valores quantizados: a mesma chave sempre gera o mesmo material
+	FErosAppearancePrimitiveData Stored;
+	for (int32 Index = 0; Index < FErosAppearancePrimitiveData::NumFloats; ++Index)
+	{
+		Stored.Values[Index] = Quantized[Index] / 255.0f;
+	}
+
+	UMaterialInstanceDynamic* Instance = UMaterialInstanceDynamic::Create(Parent, this);
+	Instance->SetVectorParameterValue(SkinColorParam, ReadColor(Stored.Values + FErosAppearancePrimitiveData::SkinIndex));
+	Instance->SetVectorParameterValue(HairColorParam, ReadColor(Stored.Values + FErosAppearancePrimitiveData::HairIndex));
+	Instance->SetVectorParameterValue(EyeColorParam, ReadColor(Stored.Values + FErosAppearancePrimitiveData::EyeIndex));
+	Instance->SetVectorParameterValue(MakeupColorParam, ReadColor(Stored.Values + FErosAppearancePrimitiveData::MakeupIndex));
+	Instance->SetScalarParameterValue(BodyHairDensityParam, Stored.Values[FErosAppearancePrimitiveData::SkinIndex + 3]);
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Material = Instance;
+	Entry.LastUsedFrame = GFrameCounter;
+
+	TrimOldest(Key);
+	return Instance;
+}
+
+void UErosAppearanceMaterialCache::TrimOldest(uint64 KeepKey)
+{
+	if (Entries.Num() > FMath::Max(MaxCachedMaterials, 1))
+	{
+		uint64 OldestKey = 0;
+		uint64 OldestFrame = MAX_uint64;
+		for (const TPair<uint64, FEntry>& Pair : Entries)
+		{
+			if (Pair.Key != KeepKey && Pair.Value.LastUsedFrame < OldestFrame)
+			{
+				OldestKey = Pair.Key;
+				OldestFrame = Pair.Value.LastUsedFrame;
+			}
+		}
+		Entries.Remove(OldestKey);
+	}
+
+	SET_DWORD_STAT(STAT_ErosAppearance_CachedMIDs, Entries.Num());
+}
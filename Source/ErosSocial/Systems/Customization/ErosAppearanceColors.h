@@ -0,0 +1,102 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosAppearanceColors.h
+// Cores da aparência via custom primitive data (materiais compartilhados entre avatares)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CharacterSaveData.h"
+#include "ErosAppearanceColors.generated.h"
+
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UPrimitiveComponent;
+
+/**
+ * Layout do custom primitive data da aparência (índices para o nó "Custom Primitive Data" do material)
+ *  0-3   SkinColor.rgb, BodyHairDensity (0 sem pelos)
+ *  4-7   HairColor.rgb, 1
+ *  8-11  EyeColor.rgb, 1
+ *  12-15 MakeupColor.rgb, intensidade (MakeupColor.a, 0 sem maquiagem)
+ */
+struct EROSSOCIAL_API FErosAppearancePrimitiveData
+{
+	static constexpr int32 SkinIndex = 0;
+	static constexpr int32 HairIndex = 4;
+	static constexpr int32 EyeIndex = 8;
+	static constexpr int32 MakeupIndex = 12;
+	static constexpr int32 NumFloats = 16;
+
+	float Values[NumFloats] = {};
+
+	static FErosAppearancePrimitiveData Pack(const FAppearanceCustomization& Appearance);
+
+	FVector4f GetVector(int32 Index) const { return FVector4f(Values[Index], Values[Index + 1], Values[Index + 2], Values[Index + 3]); }
+
+	/** Mesmo dado em 8 bits por canal (chave do cache de MIDs) */
+	void Quantize(uint8 OutBytes[NumFloats]) const;
+
+	/**
+	 * Escreve no custom primitive data do componente (só os vec4 que mudaram)
+	 * e troca por MID cacheado os materiais que não leem custom primitive data (MIDFallbackMaterials)
+	 */
+	void ApplyToComponent(UPrimitiveComponent& Component) const;
+};
+
+/**
+ * Cache de MIDs para materiais que ainda não leem custom primitive data
+ * - Chave: material pai + cores quantizadas em 8 bits -> avatares com as mesmas cores dividem o MID
+ * - Parâmetros: SkinColor, HairColor, EyeColor, MakeupColor (vetor), BodyHairDensity (escalar)
+ * - Sem entradas em MIDFallbackMaterials nenhum MID é criado
+ */
+UCLASS(config = Game)
+class EROSSOCIAL_API UErosAppearanceMaterialCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosAppearanceMaterialCache* Get(const UObject* WorldContextObject);
+
+	// USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	/** Material pai do slot (desfaz os MIDs criados pelo cache) */
+	UMaterialInterface* GetSourceMaterial(UMaterialInterface* Material) const;
+
+	/** O material (ou um dos pais) está em MIDFallbackMaterials */
+	bool NeedsFallback(const UMaterialInterface* Material) const;
+
+	UMaterialInstanceDynamic* GetOrCreate(UMaterialInterface* Parent, const FErosAppearancePrimitiveData& Data);
+
+	int32 GetNumCachedMaterials() const { return Entries.Num(); }
+
+	// ========== CONFIGURAÇÃO (DefaultGame.ini) ==========
+
+	// Materiais (ou pais) que usam parâmetros em vez de custom primitive data
+	UPROPERTY(Config)
+	TArray<FSoftObjectPath> MIDFallbackMaterials;
+
+	// MIDs guardados; os mais antigos saem do cache (quem já usa continua com o seu)
+	UPROPERTY(Config)
+	int32 MaxCachedMaterials = 256;
+
+private:
+	struct FEntry
+	{
+		TObjectPtr<UMaterialInstanceDynamic> Material;
+		uint64 LastUsedFrame = 0;
+	};
+
+	void TrimOldest(uint64 KeepKey);
+
+	TMap<uint64, FEntry> Entries;
+
+	// Resolvido no Initialize
+	TSet<FSoftObjectPath> FallbackPaths;
+};
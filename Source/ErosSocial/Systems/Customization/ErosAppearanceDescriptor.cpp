@@ -0,0 +1,200 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosAppearanceDescriptor.cpp
+
+#include "Systems/Customization/ErosAppearanceDescriptor.h"
+#include "Systems/Customization/ErosMorphTable.h"
+#include "Hash/xxhash.h"
+
+namespace
+{
+	uint8 QuantizeUnit(float Value)
+	{
+		return static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Value, 0.0f, 1.0f) * 255.0f));
+	}
+
+	float DequantizeUnit(uint8 Value)
+	{
+		return Value / 255.0f;
+	}
+
+	uint8 QuantizeRange(float Value, float Min, float Max)
+	{
+		return Max > Min ? QuantizeUnit((Value - Min) / (Max - Min)) : 0;
+	}
+
+	float DequantizeRange(uint8 Value, float Min, float Max)
+	{
+		return FMath::Lerp(Min, Max, DequantizeUnit(Value));
+	}
+}
+
+// ========== COR 24 BITS ==========
+
+FErosNetColor24::FErosNetColor24(const FLinearColor& Color)
+{
+	const FColor SRGB = Color.ToFColorSRGB();
+	R = SRGB.R;
+	G = SRGB.G;
+	B = SRGB.B;
+}
+
+FLinearColor FErosNetColor24::ToLinearColor() const
+{
+	return FLinearColor(FColor(R, G, B));
+}
+
+bool FErosNetColor24::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << R;
+	Ar << G;
+	Ar << B;
+
+	bOutSuccess = true;
+	return true;
+}
+
+// ========== DESCRITOR ==========
+
+FErosAppearanceDescriptor FErosAppearanceDescriptor::Pack(const FBodyCustomization& Body, const FAppearanceCustomization& Appearance, const UErosMorphTable* Table)
+{
+	FErosAppearanceDescriptor Descriptor;
+
+	// Mesma ordem de GetBodyMorphNames
+	const float BodyValues[] = { Body.BreastSize, Body.ButtSize, Body.Height, Body.Weight, Body.Muscle };
+	static_assert(UE_ARRAY_COUNT(BodyValues) == NumBodyMorphs, "Um byte por slider do corpo");
+	for (int32 Index = 0; Index < NumBodyMorphs; ++Index)
+	{
+		Descriptor.BodyMorphs[Index] = QuantizeUnit(BodyValues[Index]);
+	}
+
+	Descriptor.SkinColor = FErosNetColor24(Appearance.SkinColor);
+	Descriptor.HairColor = FErosNetColor24(Appearance.HairColor);
+	Descriptor.EyeColor = FErosNetColor24(Appearance.EyeColor);
+	Descriptor.MakeupColor = FErosNetColor24(Appearance.MakeupColor);
+	Descriptor.MakeupIntensity = QuantizeUnit(Appearance.MakeupColor.A);
+	Descriptor.BodyHairDensity = QuantizeUnit(Appearance.BodyHairDensity);
+	Descriptor.bHasMakeup = Appearance.bHasMakeup;
+	Descriptor.bHasBodyHair = Appearance.bHasBodyHair;
+
+	if (Table)
+	{
+		const int32 FacePresetIndex = Table->FindFacePresetIndex(Appearance.FacePresetID);
+		Descriptor.FacePreset = FacePresetIndex >= 0 && FacePresetIndex < InvalidIndex ? static_cast<uint8>(FacePresetIndex) : InvalidIndex;
+
+		const int32 HairStyleIndex = Table->HairStyles.IndexOfByKey(Appearance.HairStyle);
+		Descriptor.HairStyle = HairStyleIndex >= 0 && HairStyleIndex < InvalidIndex ? static_cast<uint8>(HairStyleIndex) : InvalidIndex;
+
+		Descriptor.FaceOverrides.Reserve(Appearance.FaceMorphOverrides.Num());
+		for (const TPair<FName, float>& Pair : Appearance.FaceMorphOverrides)
+		{
+			const int32 Slot = Table->FindSlot(Pair.Key);
+			if (Slot == INDEX_NONE || Slot > MAX_uint16)
+			{
+				continue;
+			}
+
+			const FErosMorphDefinition& Definition = Table->Morphs[Slot];
+			FErosQuantizedMorph& Override = Descriptor.FaceOverrides.AddDefaulted_GetRef();
+			Override.Slot = static_cast<uint16>(Slot);
+			Override.Weight = QuantizeRange(Pair.Value, Definition.MinWeight, Definition.MaxWeight);
+		}
+
+		// Ordem estável: o mesmo conjunto de overrides gera o mesmo array (delta e hash)
+		Descriptor.FaceOverrides.Sort([](const FErosQuantizedMorph& A, const FErosQuantizedMorph& B) { return A.Slot < B.Slot; });
+	}
+
+	Descriptor.bValid = true;
+	Descriptor.UpdateHash();
+	return Descriptor;
+}
+
+void FErosAppearanceDescriptor::Unpack(FBodyCustomization& OutBody, FAppearanceCustomization& OutAppearance, const UErosMorphTable* Table) const
+{
+	OutBody.BreastSize = DequantizeUnit(BodyMorphs[0]);
+	OutBody.ButtSize = DequantizeUnit(BodyMorphs[1]);
+	OutBody.Height = DequantizeUnit(BodyMorphs[2]);
+	OutBody.Weight = DequantizeUnit(BodyMorphs[3]);
+	OutBody.Muscle = DequantizeUnit(BodyMorphs[4]);
+
+	OutAppearance.SkinColor = SkinColor.ToLinearColor();
+	OutAppearance.HairColor = HairColor.ToLinearColor();
+	OutAppearance.EyeColor = EyeColor.ToLinearColor();
+	OutAppearance.MakeupColor = MakeupColor.ToLinearColor();
+	OutAppearance.MakeupColor.A = DequantizeUnit(MakeupIntensity);
+	OutAppearance.BodyHairDensity = DequantizeUnit(BodyHairDensity);
+	OutAppearance.bHasMakeup = bHasMakeup;
+	OutAppearance.bHasBodyHair = bHasBodyHair;
+
+	OutAppearance.FacePresetID.Reset();
+	OutAppearance.HairStyle.Reset();
+	OutAppearance.FaceMorphOverrides.Reset();
+
+	if (!Table)
+	{
+		return;
+	}
+
+	if (Table->FacePresets.IsValidIndex(FacePreset))
+	{
+		OutAppearance.FacePresetID = Table->FacePresets[FacePreset].PresetID;
+	}
+
+	if (Table->HairStyles.IsValidIndex(HairStyle))
+	{
+		OutAppearance.HairStyle = Table->HairStyles[HairStyle];
+	}
+
+	for (const FErosQuantizedMorph& Override : FaceOverrides)
+	{
+		if (Table->Morphs.IsValidIndex(Override.Slot))
+		{
+			const FErosMorphDefinition& Definition = Table->Morphs[Override.Slot];
+			OutAppearance.FaceMorphOverrides.Add(Definition.MorphName, DequantizeRange(Override.Weight, Definition.MinWeight, Definition.MaxWeight));
+		}
+	}
+}
+
+void FErosAppearanceDescriptor::UpdateHash()
+{
+	const uint8 Flags = (bHasMakeup ? 1 : 0) | (bHasBodyHair ? 2 : 0) | (bValid ? 4 : 0);
+	const FErosNetColor24 Colors[] = { SkinColor, HairColor, EyeColor, MakeupColor };
+
+	FXxHash64Builder Builder;
+	Builder.Update(BodyMorphs, sizeof(BodyMorphs));
+	Builder.Update(&FacePreset, sizeof(FacePreset));
+	Builder.Update(&HairStyle, sizeof(HairStyle));
+	for (const FErosNetColor24& Color : Colors)
+	{
+		const uint8 RGB[] = { Color.R, Color.G, Color.B };
+		Builder.Update(RGB, sizeof(RGB));
+	}
+	Builder.Update(&MakeupIntensity, sizeof(MakeupIntensity));
+	Builder.Update(&BodyHairDensity, sizeof(BodyHairDensity));
+	Builder.Update(&Flags, sizeof(Flags));
+	for (const FErosQuantizedMorph& Override : FaceOverrides)
+	{
+		Builder.Update(&Override.Slot, sizeof(Override.Slot));
+		Builder.Update(&Override.Weight, sizeof(Override.Weight));
+	}
+
+	Hash = static_cast<uint32>(Builder.Finalize().Hash);
+}
+
+bool FErosAppearanceDescriptor::HasSameMorphs(const FErosAppearanceDescriptor& Other) const
+{
+	return FMemory::Memcmp(BodyMorphs, Other.BodyMorphs, sizeof(BodyMorphs)) == 0
+		&& FacePreset == Other.FacePreset
+		&& FaceOverrides == Other.FaceOverrides;
+}
+
+bool FErosAppearanceDescriptor::HasSameColors(const FErosAppearanceDescriptor& Other) const
+{
+	return SkinColor == Other.SkinColor
+		&& HairColor == Other.HairColor
+		&& EyeColor == Other.EyeColor
+		&& MakeupColor == Other.MakeupColor
+		&& MakeupIntensity == Other.MakeupIntensity
+		&& BodyHairDensity == Other.BodyHairDensity
+		&& bHasMakeup == Other.bHasMakeup
+		&& bHasBodyHair == Other.bHasBodyHair;
+}
@@ -0,0 +1,157 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosAppearanceDescriptor.h
+// Aparência quantizada replicada para os avatares remotos
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CharacterSaveData.h"
+#include "ErosAppearanceDescriptor.generated.h"
+
+class UErosMorphTable;
+
+/**
+ * Cor em 24 bits (sRGB 8 bits por canal, sem alpha)
+ */
+USTRUCT()
+struct EROSSOCIAL_API FErosNetColor24
+{
+	GENERATED_BODY()
+
+	FErosNetColor24() = default;
+
+	explicit FErosNetColor24(const FLinearColor& Color);
+
+	FLinearColor ToLinearColor() const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FErosNetColor24& Other) const { return R == Other.R && G == Other.G && B == Other.B; }
+	bool operator!=(const FErosNetColor24& Other) const { return !(*this == Other); }
+
+	UPROPERTY()
+	uint8 R = 0;
+
+	UPROPERTY()
+	uint8 G = 0;
+
+	UPROPERTY()
+	uint8 B = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FErosNetColor24> : public TStructOpsTypeTraitsBase2<FErosNetColor24>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+/**
+ * Override de morph do rosto: slot da tabela e peso em 8 bits (entre MinWeight e MaxWeight do slot)
+ */
+USTRUCT()
+struct EROSSOCIAL_API FErosQuantizedMorph
+{
+	GENERATED_BODY()
+
+	bool operator==(const FErosQuantizedMorph& Other) const { return Slot == Other.Slot && Weight == Other.Weight; }
+
+	UPROPERTY()
+	uint16 Slot = 0;
+
+	UPROPERTY()
+	uint8 Weight = 0;
+};
+
+/**
+ * Descritor compacto de corpo e aparência (FBodyCustomization + FAppearanceCustomization)
+ * - Sliders em 8 bits, cores em 24 bits, preset de rosto e penteado como índice na UErosMorphTable
+ * - Replicado como propriedade normal: a entrada manda tudo, depois só os membros que mudaram
+ * - Hash do conteúdo quantizado (não replicado) para caches e para ignorar reaplicações iguais
+ *
+ * Servidor e clientes precisam da mesma tabela (mesmo Blueprint do personagem); IDs fora da tabela
+ * viram "sem preset" e overrides de morphs que a tabela não tem são descartados.
+ */
+USTRUCT()
+struct EROSSOCIAL_API FErosAppearanceDescriptor
+{
+	GENERATED_BODY()
+
+	static constexpr int32 NumBodyMorphs = 5;
+	static constexpr uint8 InvalidIndex = MAX_uint8;
+
+	/** Quantiza os dados do personagem (servidor) */
+	static FErosAppearanceDescriptor Pack(const FBodyCustomization& Body, const FAppearanceCustomization& Appearance, const UErosMorphTable* Table);
+
+	/** Reconstrói os structs de customização (clientes) */
+	void Unpack(FBodyCustomization& OutBody, FAppearanceCustomization& OutAppearance, const UErosMorphTable* Table) const;
+
+	/** Recalcula Hash a partir dos campos replicados (chamado depois de receber) */
+	void UpdateHash();
+
+	bool IsValid() const { return bValid; }
+	uint32 GetHash() const { return Hash; }
+
+	/** Sliders, preset ou overrides diferentes (morphs precisam ser recalculados) */
+	bool HasSameMorphs(const FErosAppearanceDescriptor& Other) const;
+
+	/** Cores, maquiagem ou pelos diferentes */
+	bool HasSameColors(const FErosAppearanceDescriptor& Other) const;
+
+	// BreastSize, ButtSize, Height, Weight, Muscle (0..1)
+	UPROPERTY()
+	uint8 BodyMorphs[NumBodyMorphs] = {};
+
+	UPROPERTY()
+	uint8 FacePreset = InvalidIndex;
+
+	UPROPERTY()
+	uint8 HairStyle = InvalidIndex;
+
+	UPROPERTY()
+	FErosNetColor24 SkinColor;
+
+	UPROPERTY()
+	FErosNetColor24 HairColor;
+
+	UPROPERTY()
+	FErosNetColor24 EyeColor;
+
+	UPROPERTY()
+	FErosNetColor24 MakeupColor;
+
+	// MakeupColor.A do dono (intensidade usada pelo material, ver FErosAppearancePrimitiveData)
+	UPROPERTY()
+	uint8 MakeupIntensity = MAX_uint8;
+
+	UPROPERTY()
+	uint8 BodyHairDensity = 0;
+
+	UPROPERTY()
+	uint8 bHasMakeup : 1;
+
+	UPROPERTY()
+	uint8 bHasBodyHair : 1;
+
+	// Falso até o servidor empacotar (clientes não aplicam o descritor padrão)
+	UPROPERTY()
+	uint8 bValid : 1;
+
+	UPROPERTY()
+	TArray<FErosQuantizedMorph> FaceOverrides;
+
+	FErosAppearanceDescriptor()
+		: bHasMakeup(false)
+		, bHasBodyHair(false)
+		, bValid(false)
+	{
+	}
+
+private:
+	UPROPERTY(NotReplicated)
+	uint32 Hash = 0;
+};
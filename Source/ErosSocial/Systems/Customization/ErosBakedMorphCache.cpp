@@ -0,0 +1,282 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosBakedMorphCache.cpp
+
+#include "Systems/Customization/ErosBakedMorphCache.h"
+#include "Systems/Customization/ErosCustomizationStats.h"
+#include "Animation/MorphTarget.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "Hash/xxhash.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "RenderingThread.h"
+
+DECLARE_CYCLE_STAT(TEXT("Morph Bake"), STAT_ErosMorph_Bake, STATGROUP_ErosCustomization);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Baked Meshes"), STAT_ErosMorph_BakedMeshes, STATGROUP_ErosCustomization);
+
+UErosBakedMorphCache* UErosBakedMorphCache::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosBakedMorphCache>() : nullptr;
+}
+
+bool UErosBakedMorphCache::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Servidor dedicado não renderiza
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UErosBakedMorphCache::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UErosBakedMorphCache::Deinitialize()
+{
+	Entries.Reset();
+	UnbakeableMeshes.Reset();
+
+	Super::Deinitialize();
+}
+
+void UErosBakedMorphCache::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	UErosBakedMorphCache* This = CastChecked<UErosBakedMorphCache>(InThis);
+	for (TPair<uint64, FEntry>& Pair : This->Entries)
+	{
+		Collector.AddReferencedObject(Pair.Value.Mesh, This);
+	}
+}
+
+bool UErosBakedMorphCache::CanBake(const USkeletalMesh* SourceMesh) const
+{
+	return bEnabled && SourceMesh && !UnbakeableMeshes.Contains(SourceMesh);
+}
+
+uint64 UErosBakedMorphCache::ComputeKey(const USkeletalMesh* SourceMesh, TConstArrayView<float> Weights)
+{
+	// Passos de 1/255: diferenças menores que isso não aparecem no avatar
+	TArray<int16, TInlineAllocator<256>> Quantized;
+	Quantized.SetNumUninitialized(Weights.Num());
+	for (int32 Slot = 0; Slot < Weights.Num(); ++Slot)
+	{
+		Quantized[Slot] = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Weights[Slot] * 255.0f), -32768, 32767));
+	}
+
+	FXxHash64Builder Builder;
+	Builder.Update(&SourceMesh, sizeof(SourceMesh));
+	Builder.Update(Quantized.GetData(), Quantized.Num() * sizeof(int16));
+	return Builder.Finalize().Hash;
+}
+
+USkeletalMesh* UErosBakedMorphCache::AcquireBakedMesh(USkeletalMesh* SourceMesh, TConstArrayView<FName> MorphNames, TConstArrayView<float> Weights, uint64& OutKey)
+{
+	OutKey = 0;
+	if (!bEnabled || !SourceMesh || MorphNames.Num() != Weights.Num() || UnbakeableMeshes.Contains(SourceMesh))
+	{
+		return nullptr;
+	}
+
+	const uint64 Key = ComputeKey(SourceMesh, Weights);
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		++Entry->NumUsers;
+		Entry->LastUsedFrame = GFrameCounter;
+		OutKey = Key;
+		return Entry->Mesh;
+	}
+
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		BakesThisFrame = 0;
+	}
+	if (BakesThisFrame >= MaxBakesPerFrame)
+	{
+		return nullptr;
+	}
+	++BakesThisFrame;
+
+	USkeletalMesh* Baked = nullptr;
+	const EBakeResult Result = BakeMesh(SourceMesh, MorphNames, Weights, Baked);
+	if (Result == EBakeResult::NoCPUAccess)
+	{
+		// Só isso é permanente: o resto pode dar certo numa próxima tentativa
+		UnbakeableMeshes.Add(SourceMesh);
+		UE_LOG(LogTemp, Warning, TEXT("UErosBakedMorphCache::AcquireBakedMesh - %s has no CPU-accessible render data (enable bAllowCPUAccess on its LODs); using live morphs"),
+			*SourceMesh->GetName());
+		return nullptr;
+	}
+	if (Result != EBakeResult::Baked)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UErosBakedMorphCache::AcquireBakedMesh - Bake of %s failed (%s); using live morphs for now"),
+			*SourceMesh->GetName(), LexToString(Result));
+		return nullptr;
+	}
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Mesh = Baked;
+	Entry.NumUsers = 1;
+	Entry.LastUsedFrame = GFrameCounter;
+	OutKey = Key;
+
+	SET_DWORD_STAT(STAT_ErosMorph_BakedMeshes, Entries.Num());
+	TrimUnused();
+	return Baked;
+}
+
+void UErosBakedMorphCache::ReleaseBakedMesh(uint64 Key)
+{
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		Entry->NumUsers = FMath::Max(0, Entry->NumUsers - 1);
+		Entry->LastUsedFrame = GFrameCounter;
+		TrimUnused();
+	}
+}
+
+void UErosBakedMorphCache::TrimUnused()
+{
+	while (Entries.Num() > FMath::Max(MaxCachedMeshes, 0))
+	{
+		// O sem usuário usado há mais tempo
+		bool bFoundUnused = false;
+		uint64 OldestKey = 0;
+		uint64 OldestFrame = MAX_uint64;
+		for (const TPair<uint64, FEntry>& Pair : Entries)
+		{
+			if (Pair.Value.NumUsers == 0 && Pair.Value.LastUsedFrame < OldestFrame)
+			{
+				bFoundUnused = true;
+				OldestKey = Pair.Key;
+				OldestFrame = Pair.Value.LastUsedFrame;
+			}
+		}
+
+		if (!bFoundUnused)
+		{
+			// Todos em uso: o cache passa do limite até alguém soltar
+			break;
+		}
+
+		Entries.Remove(OldestKey);
+	}
+
+	SET_DWORD_STAT(STAT_ErosMorph_BakedMeshes, Entries.Num());
+}
+
+const TCHAR* UErosBakedMorphCache::LexToString(EBakeResult Result)
+{
+	switch (Result)
+	{
+	case EBakeResult::Baked:           return TEXT("Baked");
+	case EBakeResult::NoRenderData:    return TEXT("render data not ready");
+	case EBakeResult::NoCPUAccess:     return TEXT("no CPU-accessible vertex data");
+	case EBakeResult::DuplicateFailed: return TEXT("mesh duplicate failed");
+	}
+	return TEXT("Unknown");
+}
+
+UErosBakedMorphCache::EBakeResult UErosBakedMorphCache::BakeMesh(USkeletalMesh* SourceMesh, TConstArrayView<FName> MorphNames, TConstArrayView<float> Weights, USkeletalMesh*& OutBaked) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosMorph_Bake);
+
+	OutBaked = nullptr;
+
+	FSkeletalMeshRenderData* SourceRenderData = SourceMesh->GetResourceForRendering();
+	if (!SourceRenderData || SourceRenderData->LODRenderData.Num() == 0)
+	{
+		return EBakeResult::NoRenderData;
+	}
+
+	// Sem cópia na CPU (bAllowCPUAccess desligado) não há o que modificar
+	for (const FSkeletalMeshLODRenderData& LODData : SourceRenderData->LODRenderData)
+	{
+		if (!LODData.StaticVertexBuffers.PositionVertexBuffer.GetVertexData()
+			|| !LODData.StaticVertexBuffers.StaticMeshVertexBuffer.GetTangentData())
+		{
+			return EBakeResult::NoCPUAccess;
+		}
+	}
+
+	USkeletalMesh* Baked = DuplicateObject<USkeletalMesh>(SourceMesh, GetTransientPackage(),
+		MakeUniqueObjectName(GetTransientPackage(), USkeletalMesh::StaticClass(), *FString::Printf(TEXT("%s_Baked"), *SourceMesh->GetName())));
+	FSkeletalMeshRenderData* BakedRenderData = Baked ? Baked->GetResourceForRendering() : nullptr;
+	if (!BakedRenderData || BakedRenderData->LODRenderData.Num() != SourceRenderData->LODRenderData.Num())
+	{
+		return EBakeResult::DuplicateFailed;
+	}
+
+	Baked->ReleaseResources();
+	FlushRenderingCommands();
+
+	TArray<FVector3f> NormalDeltas;
+	TBitArray<> TouchedNormals;
+
+	for (int32 LODIndex = 0; LODIndex < BakedRenderData->LODRenderData.Num(); ++LODIndex)
+	{
+		FStaticMeshVertexBuffers& VertexBuffers = BakedRenderData->LODRenderData[LODIndex].StaticVertexBuffers;
+		FPositionVertexBuffer& Positions = VertexBuffers.PositionVertexBuffer;
+		FStaticMeshVertexBuffer& Tangents = VertexBuffers.StaticMeshVertexBuffer;
+		const uint32 NumVertices = Positions.GetNumVertices();
+
+		NormalDeltas.SetNumZeroed(NumVertices);
+		TouchedNormals.Init(false, NumVertices);
+
+		for (int32 Slot = 0; Slot < MorphNames.Num(); ++Slot)
+		{
+			const float Weight = Weights[Slot];
+			if (FMath::IsNearlyZero(Weight))
+			{
+				continue;
+			}
+
+			int32 MorphIndex = INDEX_NONE;
+			const UMorphTarget* MorphTarget = SourceMesh->FindMorphTargetAndIndex(MorphNames[Slot], MorphIndex);
+			if (!MorphTarget)
+			{
+				continue;
+			}
+
+			int32 NumDeltas = 0;
+			const FMorphTargetDelta* Deltas = MorphTarget->GetMorphTargetDelta(LODIndex, NumDeltas);
+			for (int32 DeltaIndex = 0; DeltaIndex < NumDeltas; ++DeltaIndex)
+			{
+				const FMorphTargetDelta& Delta = Deltas[DeltaIndex];
+				if (Delta.SourceIdx < NumVertices)
+				{
+					Positions.VertexPosition(Delta.SourceIdx) += Delta.PositionDelta * Weight;
+					NormalDeltas[Delta.SourceIdx] += Delta.TangentZDelta * Weight;
+					TouchedNormals[Delta.SourceIdx] = true;
+				}
+			}
+		}
+
+		// Mesmo resultado do morph na GPU: normal somada e renormalizada, tangente reortogonalizada
+		for (TConstSetBitIterator<> It(TouchedNormals); It; ++It)
+		{
+			const uint32 VertexIndex = It.GetIndex();
+			const FVector4f OldTangentZ = Tangents.VertexTangentZ(VertexIndex);
+
+			const FVector3f TangentZ = (FVector3f(OldTangentZ) + NormalDeltas[VertexIndex]).GetSafeNormal();
+			const FVector3f OldTangentX = FVector3f(Tangents.VertexTangentX(VertexIndex));
+			const FVector3f TangentX = (OldTangentX - TangentZ * (OldTangentX | TangentZ)).GetSafeNormal();
+			if (TangentZ.IsNearlyZero() || TangentX.IsNearlyZero())
+			{
+				continue;
+			}
+
+			const FVector3f TangentY = (TangentZ ^ TangentX) * OldTangentZ.W;
+
+			Tangents.SetVertexTangents(VertexIndex, TangentX, TangentY, TangentZ);
+		}
+	}
+
+	Baked->InitResources();
+
+	UE_LOG(LogTemp, Log, TEXT("UErosBakedMorphCache::BakeMesh - Baked %s (%d morphs, %d LODs)"),
+		*Baked->GetName(), MorphNames.Num(), BakedRenderData->LODRenderData.Num());
+	OutBaked = Baked;
+	return EBakeResult::Baked;
+}
@@ -0,0 +1,99 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosBakedMorphCache.h
+// Cache de skeletal meshes com os morphs já aplicados (avatares remotos)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ErosBakedMorphCache.generated.h"
+
+class USkeletalMesh;
+
+/**
+ * Meshes "assados": cópia do skeletal mesh com os deltas dos morphs somados nas posições e normais
+ * - Chave: mesh original + pesos finais quantizados em 8 bits (corpo + rosto) -> aparências iguais dividem o mesh
+ * - Quem usa o mesh assado não tem morph ativo: sem custo de morph por frame na CPU/GPU
+ * - Opcional (bEnabled) e só para avatares remotos; jogador local e tela de customização ficam no caminho ao vivo
+ *
+ * Requer LODs com bAllowCPUAccess no mesh original (posições, tangentes e deltas legíveis na CPU).
+ * Sem isso o bake falha uma vez por mesh e o componente segue com os morphs ao vivo.
+ * Outras falhas (render data ainda não pronta, cópia falhou) não bloqueiam o mesh: tenta de novo depois.
+ */
+UCLASS(config = Game)
+class EROSSOCIAL_API UErosBakedMorphCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosBakedMorphCache* Get(const UObject* WorldContextObject);
+
+	// USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	bool IsEnabled() const { return bEnabled; }
+
+	/** Ligado e o mesh ainda não falhou no bake */
+	bool CanBake(const USkeletalMesh* SourceMesh) const;
+
+	/** Chave de cache para o mesh e os pesos (quantizados) */
+	static uint64 ComputeKey(const USkeletalMesh* SourceMesh, TConstArrayView<float> Weights);
+
+	/**
+	 * Mesh assado para os pesos (Weights alinhado com MorphNames), criando se preciso
+	 * nullptr: bake impossível para o mesh ou orçamento do frame esgotado (tentar de novo depois)
+	 * Cada Acquire bem-sucedido precisa de um Release com a mesma chave
+	 */
+	USkeletalMesh* AcquireBakedMesh(USkeletalMesh* SourceMesh, TConstArrayView<FName> MorphNames, TConstArrayView<float> Weights, uint64& OutKey);
+
+	void ReleaseBakedMesh(uint64 Key);
+
+	int32 GetNumCachedMeshes() const { return Entries.Num(); }
+
+	// ========== CONFIGURAÇÃO (DefaultGame.ini) ==========
+
+	UPROPERTY(Config)
+	bool bEnabled = false;
+
+	// Meshes sem usuário ficam no cache até passar desse número
+	UPROPERTY(Config)
+	int32 MaxCachedMeshes = 64;
+
+	// Bakes novos por frame (cada um copia o mesh inteiro)
+	UPROPERTY(Config)
+	int32 MaxBakesPerFrame = 2;
+
+private:
+	enum class EBakeResult : uint8
+	{
+		Baked,
+		NoRenderData,
+		NoCPUAccess,
+		DuplicateFailed
+	};
+
+	static const TCHAR* LexToString(EBakeResult Result);
+
+	struct FEntry
+	{
+		TObjectPtr<USkeletalMesh> Mesh;
+		int32 NumUsers = 0;
+		uint64 LastUsedFrame = 0;
+	};
+
+	EBakeResult BakeMesh(USkeletalMesh* SourceMesh, TConstArrayView<FName> MorphNames, TConstArrayView<float> Weights, USkeletalMesh*& OutBaked) const;
+	void TrimUnused();
+
+	TMap<uint64, FEntry> Entries;
+
+	// Meshes sem dados na CPU (não adianta tentar de novo)
+	TSet<TObjectKey<USkeletalMesh>> UnbakeableMeshes;
+
+	uint64 BudgetFrame = 0;
+	int32 BakesThisFrame = 0;
+};
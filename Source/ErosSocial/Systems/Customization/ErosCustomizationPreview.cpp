@@ -0,0 +1,219 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosCustomizationPreview.cpp
+
+#include "Systems/Customization/ErosCustomizationPreview.h"
+#include "Systems/Customization/ErosCustomizationStats.h"
+#include "ErosSocialCharacter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Preview Flush"), STAT_ErosPreview_Flush, STATGROUP_ErosCustomization);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Preview Changes"), STAT_ErosPreview_Changes, STATGROUP_ErosCustomization);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Preview Flushes"), STAT_ErosPreview_Flushes, STATGROUP_ErosCustomization);
+
+namespace
+{
+	bool IsSameBody(const FBodyCustomization& A, const FBodyCustomization& B)
+	{
+		return A.BreastSize == B.BreastSize
+			&& A.ButtSize == B.ButtSize
+			&& A.Height == B.Height
+			&& A.Weight == B.Weight
+			&& A.Muscle == B.Muscle;
+	}
+
+	bool IsSameFace(const FAppearanceCustomization& A, const FAppearanceCustomization& B)
+	{
+		return A.FacePresetID == B.FacePresetID
+			&& A.FaceMorphOverrides.OrderIndependentCompareEqual(B.FaceMorphOverrides);
+	}
+
+	bool IsSameColors(const FAppearanceCustomization& A, const FAppearanceCustomization& B)
+	{
+		return A.SkinColor == B.SkinColor
+			&& A.HairColor == B.HairColor
+			&& A.EyeColor == B.EyeColor
+			&& A.bHasMakeup == B.bHasMakeup
+			&& A.MakeupColor == B.MakeupColor
+			&& A.bHasBodyHair == B.bHasBodyHair
+			&& A.BodyHairDensity == B.BodyHairDensity;
+	}
+}
+
+UErosCustomizationPreview::UErosCustomizationPreview()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UErosCustomizationPreview::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Character = Cast<AErosSocialCharacter>(GetOwner());
+	if (!Character)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UErosCustomizationPreview::BeginPlay - Owner %s is not an AErosSocialCharacter"), *GetNameSafe(GetOwner()));
+		return;
+	}
+
+	ResetFromCharacter();
+}
+
+void UErosCustomizationPreview::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushPreview();
+}
+
+void UErosCustomizationPreview::SetBodyCustomization(const FBodyCustomization& BodyCustomization)
+{
+	if (!IsSameBody(PendingBody, BodyCustomization))
+	{
+		PendingBody = BodyCustomization;
+		MarkDirty(EErosCustomizationDirty::Body);
+	}
+}
+
+void UErosCustomizationPreview::SetAppearanceCustomization(const FAppearanceCustomization& AppearanceCustomization)
+{
+	EErosCustomizationDirty Changed = EErosCustomizationDirty::None;
+	if (!IsSameFace(PendingAppearance, AppearanceCustomization))
+	{
+		Changed |= EErosCustomizationDirty::Face;
+	}
+	if (!IsSameColors(PendingAppearance, AppearanceCustomization))
+	{
+		Changed |= EErosCustomizationDirty::Colors;
+	}
+	if (PendingAppearance.HairStyle != AppearanceCustomization.HairStyle)
+	{
+		Changed |= EErosCustomizationDirty::HairStyle;
+	}
+
+	if (Changed != EErosCustomizationDirty::None)
+	{
+		PendingAppearance = AppearanceCustomization;
+		MarkDirty(Changed);
+	}
+}
+
+void UErosCustomizationPreview::SetFacePreset(const FString& FacePresetID)
+{
+	if (PendingAppearance.FacePresetID != FacePresetID)
+	{
+		PendingAppearance.FacePresetID = FacePresetID;
+		MarkDirty(EErosCustomizationDirty::Face);
+	}
+}
+
+void UErosCustomizationPreview::SetFaceMorphOverride(FName MorphName, float Weight)
+{
+	float& Current = PendingAppearance.FaceMorphOverrides.FindOrAdd(MorphName, MAX_flt);
+	if (Current != Weight)
+	{
+		Current = Weight;
+		MarkDirty(EErosCustomizationDirty::Face);
+	}
+}
+
+void UErosCustomizationPreview::SetSkinColor(const FLinearColor& Color)
+{
+	if (PendingAppearance.SkinColor != Color)
+	{
+		PendingAppearance.SkinColor = Color;
+		MarkDirty(EErosCustomizationDirty::Colors);
+	}
+}
+
+void UErosCustomizationPreview::SetHairColor(const FLinearColor& Color)
+{
+	if (PendingAppearance.HairColor != Color)
+	{
+		PendingAppearance.HairColor = Color;
+		MarkDirty(EErosCustomizationDirty::Colors);
+	}
+}
+
+void UErosCustomizationPreview::SetEyeColor(const FLinearColor& Color)
+{
+	if (PendingAppearance.EyeColor != Color)
+	{
+		PendingAppearance.EyeColor = Color;
+		MarkDirty(EErosCustomizationDirty::Colors);
+	}
+}
+
+void UErosCustomizationPreview::SetMakeup(bool bHasMakeup, const FLinearColor& Color)
+{
+	if (PendingAppearance.bHasMakeup != bHasMakeup || PendingAppearance.MakeupColor != Color)
+	{
+		PendingAppearance.bHasMakeup = bHasMakeup;
+		PendingAppearance.MakeupColor = Color;
+		MarkDirty(EErosCustomizationDirty::Colors);
+	}
+}
+
+void UErosCustomizationPreview::SetBodyHair(bool bHasBodyHair, float Density)
+{
+	if (PendingAppearance.bHasBodyHair != bHasBodyHair || PendingAppearance.BodyHairDensity != Density)
+	{
+		PendingAppearance.bHasBodyHair = bHasBodyHair;
+		PendingAppearance.BodyHairDensity = Density;
+		MarkDirty(EErosCustomizationDirty::Colors);
+	}
+}
+
+void UErosCustomizationPreview::SetHairStyle(const FString& HairStyle)
+{
+	if (PendingAppearance.HairStyle != HairStyle)
+	{
+		PendingAppearance.HairStyle = HairStyle;
+		MarkDirty(EErosCustomizationDirty::HairStyle);
+	}
+}
+
+void UErosCustomizationPreview::FlushPreview()
+{
+	SetComponentTickEnabled(false);
+
+	if (!Character || DirtyFlags == EErosCustomizationDirty::None)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ErosPreview_Flush);
+	INC_DWORD_STAT(STAT_ErosPreview_Flushes);
+
+	Character->ApplyCustomizationChanges(PendingBody, PendingAppearance,
+		EnumHasAnyFlags(DirtyFlags, EErosCustomizationDirty::Morphs),
+		EnumHasAnyFlags(DirtyFlags, EErosCustomizationDirty::Colors));
+
+	DirtyFlags = EErosCustomizationDirty::None;
+}
+
+void UErosCustomizationPreview::ResetFromCharacter()
+{
+	if (!Character)
+	{
+		return;
+	}
+
+	const FCharacterSaveData CharacterData = Character->GetCharacterData();
+	PendingBody = CharacterData.BodyCustomization;
+	PendingAppearance = CharacterData.AppearanceCustomization;
+
+	DirtyFlags = EErosCustomizationDirty::None;
+	SetComponentTickEnabled(false);
+}
+
+void UErosCustomizationPreview::MarkDirty(EErosCustomizationDirty Flags)
+{
+	INC_DWORD_STAT(STAT_ErosPreview_Changes);
+
+	if (DirtyFlags == EErosCustomizationDirty::None)
+	{
+		SetComponentTickEnabled(true);
+	}
+	DirtyFlags |= Flags;
+}
@@ -0,0 +1,108 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosCustomizationPreview.h
+// Preview da tela de customização: mudanças acumuladas e aplicadas uma vez por frame
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CharacterSaveData.h"
+#include "ErosCustomizationPreview.generated.h"
+
+class AErosSocialCharacter;
+
+/**
+ * O que mudou desde o último flush
+ */
+enum class EErosCustomizationDirty : uint8
+{
+	None		= 0,
+	Body		= 1 << 0,	// sliders do corpo (morphs)
+	Face		= 1 << 1,	// preset de rosto e overrides (morphs)
+	Colors		= 1 << 2,	// pele, cabelo, olhos, maquiagem, pelos (custom primitive data)
+	HairStyle	= 1 << 3,
+
+	Morphs		= Body | Face
+};
+ENUM_CLASS_FLAGS(EErosCustomizationDirty);
+
+/**
+ * Controlador do preview de customização (MAP_CharacterCustomization)
+ * - Os sliders chamam os Set*; valores iguais aos pendentes não sujam nada
+ * - No tick (só ligado com mudanças pendentes) aplica tudo de uma vez no AErosSocialCharacter dono
+ * - Morphs só são recalculados se corpo/rosto mudaram (e o blend só envia os pesos que mudaram);
+ *   cores só se alguma cor mudou (e só os vec4 que mudaram vão para o render thread)
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class EROSSOCIAL_API UErosCustomizationPreview : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UErosCustomizationPreview();
+
+	// UActorComponent
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// ========== CORPO ==========
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetBodyCustomization(const FBodyCustomization& BodyCustomization);
+
+	// ========== APARÊNCIA ==========
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetAppearanceCustomization(const FAppearanceCustomization& AppearanceCustomization);
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetFacePreset(const FString& FacePresetID);
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetFaceMorphOverride(FName MorphName, float Weight);
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetSkinColor(const FLinearColor& Color);
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetHairColor(const FLinearColor& Color);
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetEyeColor(const FLinearColor& Color);
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetMakeup(bool bHasMakeup, const FLinearColor& Color);
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetBodyHair(bool bHasBodyHair, float Density);
+
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void SetHairStyle(const FString& HairStyle);
+
+	// ========== ESTADO ==========
+
+	/** Aplica agora o que estiver pendente (normalmente no próximo tick) */
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void FlushPreview();
+
+	/** Descarta o pendente e volta aos dados atuais do personagem */
+	UFUNCTION(BlueprintCallable, Category = "Customization|Preview")
+	void ResetFromCharacter();
+
+	UFUNCTION(BlueprintPure, Category = "Customization|Preview")
+	bool HasPendingChanges() const { return DirtyFlags != EErosCustomizationDirty::None; }
+
+	const FBodyCustomization& GetPendingBody() const { return PendingBody; }
+	const FAppearanceCustomization& GetPendingAppearance() const { return PendingAppearance; }
+
+private:
+	void MarkDirty(EErosCustomizationDirty Flags);
+
+	UPROPERTY(Transient)
+	TObjectPtr<AErosSocialCharacter> Character;
+
+	FBodyCustomization PendingBody;
+	FAppearanceCustomization PendingAppearance;
+
+	EErosCustomizationDirty DirtyFlags = EErosCustomizationDirty::None;
+};
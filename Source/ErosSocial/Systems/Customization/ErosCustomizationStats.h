@@ -0,0 +1,10 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosCustomizationStats.h
+// Grupo de stats de customização do ErosSocial ("stat ErosCustomization")
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("ErosSocial Customization"), STATGROUP_ErosCustomization, STATCAT_Advanced);
@@ -0,0 +1,326 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosMorphBlend.cpp
+
+#include "Systems/Customization/ErosMorphBlend.h"
+#include "Systems/Customization/ErosMorphComponent.h"
+#include "Systems/Customization/ErosMorphTable.h"
+#include "Systems/Customization/ErosCustomizationStats.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Morph Blend Batch"), STAT_ErosMorph_BlendBatch, STATGROUP_ErosCustomization);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Morph Blends"), STAT_ErosMorph_Blends, STATGROUP_ErosCustomization);
+
+// Abaixo disso o ParallelFor custa mais que o blend
+static constexpr int32 MinBlendsPerWorker = 8;
+
+// ========== CAMADAS ==========
+
+void FErosMorphLayer::Init(int32 NumSlots)
+{
+	Values.Init(0.0f, NumSlots);
+	Mask.Init(0.0f, NumSlots);
+}
+
+void FErosMorphLayer::Set(int32 Slot, float Value)
+{
+	if (Values.IsValidIndex(Slot))
+	{
+		Values[Slot] = Value;
+		Mask[Slot] = 1.0f;
+	}
+}
+
+void FErosMorphLayer::SetFromMap(const UErosMorphTable& Table, const TMap<FName, float>& Source)
+{
+	Init(Table.Num());
+	for (const TPair<FName, float>& Pair : Source)
+	{
+		Set(Table.FindSlot(Pair.Key), Pair.Value);
+	}
+}
+
+// ========== KERNELS ==========
+
+void ErosMorphBlend::BlendLayer(float* RESTRICT Out, const float* RESTRICT Values, const float* RESTRICT Mask, float Alpha, int32 Num)
+{
+	const VectorRegister4Float AlphaVec = VectorSetFloat1(Alpha);
+
+	int32 Slot = 0;
+	for (; Slot + 4 <= Num; Slot += 4)
+	{
+		const VectorRegister4Float Current = VectorLoad(Out + Slot);
+		const VectorRegister4Float Delta = VectorSubtract(VectorLoad(Values + Slot), Current);
+		const VectorRegister4Float Factor = VectorMultiply(VectorLoad(Mask + Slot), AlphaVec);
+		VectorStore(VectorMultiplyAdd(Delta, Factor, Current), Out + Slot);
+	}
+
+	for (; Slot < Num; ++Slot)
+	{
+		Out[Slot] += (Values[Slot] - Out[Slot]) * Mask[Slot] * Alpha;
+	}
+}
+
+int32 ErosMorphBlend::ClampAndDiff(float* RESTRICT Blended, const float* RESTRICT MinWeights, const float* RESTRICT MaxWeights,
+	float* RESTRICT Current, uint32* RESTRICT DirtyWords, int32 Num)
+{
+	int32 NumChanged = 0;
+
+	int32 Slot = 0;
+	for (; Slot + 4 <= Num; Slot += 4)
+	{
+		const VectorRegister4Float Clamped = VectorMax(VectorMin(VectorLoad(Blended + Slot), VectorLoad(MaxWeights + Slot)), VectorLoad(MinWeights + Slot));
+		const uint32 ChangedBits = static_cast<uint32>(VectorMaskBits(VectorCompareNE(Clamped, VectorLoad(Current + Slot))));
+		if (ChangedBits != 0)
+		{
+			VectorStore(Clamped, Current + Slot);
+
+			// Grupos de 4 começam em múltiplos de 4: nunca atravessam uma palavra de 32 bits
+			DirtyWords[Slot >> 5] |= ChangedBits << (Slot & 31);
+			NumChanged += FMath::CountBits(ChangedBits);
+		}
+	}
+
+	for (; Slot < Num; ++Slot)
+	{
+		const float Clamped = FMath::Clamp(Blended[Slot], MinWeights[Slot], MaxWeights[Slot]);
+		if (Clamped != Current[Slot])
+		{
+			Current[Slot] = Clamped;
+			DirtyWords[Slot >> 5] |= 1u << (Slot & 31);
+			++NumChanged;
+		}
+	}
+
+	return NumChanged;
+}
+
+int32 ErosMorphBlend::Evaluate(const FErosMorphTableArrays& Table, const FErosMorphBlendLayers& Input,
+	TArray<float>& Scratch, float* Current, uint32* DirtyWords)
+{
+	const int32 Num = Table.Num();
+	Scratch.SetNumUninitialized(Num, EAllowShrinking::No);
+	FMemory::Memcpy(Scratch.GetData(), Table.Defaults.GetData(), Num * sizeof(float));
+
+	for (const TPair<TSharedPtr<const FErosMorphLayer, ESPMode::ThreadSafe>, float>& Layer : Input.Layers)
+	{
+		if (Layer.Key.IsValid() && Layer.Key->Num() == Num && Layer.Value > 0.0f)
+		{
+			BlendLayer(Scratch.GetData(), Layer.Key->Values.GetData(), Layer.Key->Mask.GetData(), Layer.Value, Num);
+		}
+	}
+
+	return ClampAndDiff(Scratch.GetData(), Table.MinWeights.GetData(), Table.MaxWeights.GetData(), Current, DirtyWords, Num);
+}
+
+// ========== SUBSYSTEM ==========
+
+UErosMorphBlendSubsystem* UErosMorphBlendSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosMorphBlendSubsystem>() : nullptr;
+}
+
+bool UErosMorphBlendSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UErosMorphBlendSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UErosMorphBlendSubsystem, STATGROUP_Tickables);
+}
+
+void UErosMorphBlendSubsystem::Tick(float DeltaTime)
+{
+	FlushPendingBlends();
+}
+
+void UErosMorphBlendSubsystem::RequestBlend(UErosMorphComponent* Component)
+{
+	PendingComponents.Add(Component);
+}
+
+void UErosMorphBlendSubsystem::FlushPendingBlends()
+{
+	if (PendingComponents.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ErosMorph_BlendBatch);
+
+	// Game thread: captura tabela e camadas de cada componente
+	BatchScratch.Reset();
+	for (const TWeakObjectPtr<UErosMorphComponent>& Pending : PendingComponents)
+	{
+		UErosMorphComponent* Component = Pending.Get();
+		if (Component && Component->PrepareBlend())
+		{
+			BatchScratch.Add(Component);
+		}
+	}
+	PendingComponents.Reset();
+
+	// Cada componente só escreve nos próprios arrays
+	ParallelFor(TEXT("ErosMorphBlend"), BatchScratch.Num(), MinBlendsPerWorker, [this](int32 Index)
+	{
+		BatchScratch[Index]->EvaluateBlend();
+	});
+
+	for (UErosMorphComponent* Component : BatchScratch)
+	{
+		Component->FinishBlend();
+	}
+
+	INC_DWORD_STAT_BY(STAT_ErosMorph_Blends, BatchScratch.Num());
+	BatchScratch.Reset();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+
+/**
+ * Blend de uma multidão: caminho por TMap<FName, float> vs. arrays densos
+ * Uso: Eros.Morph.BlendBenchmark [Characters=200] [Morphs=300] [Iterations=20]
+ */
+static void ErosMorphBlendBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumCharacters = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+	const int32 NumMorphs = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 300;
+	const int32 NumIterations = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 20;
+
+	FRandomStream Random(4242);
+
+	UErosMorphTable* Table = NewObject<UErosMorphTable>(GetTransientPackage());
+	for (int32 Slot = 0; Slot < NumMorphs; ++Slot)
+	{
+		Table->AddMorph(FName(*FString::Printf(TEXT("Morph_%03d"), Slot)), 0.5f);
+	}
+	const TSharedPtr<const FErosMorphTableArrays, ESPMode::ThreadSafe> TableArrays = Table->GetDenseArrays();
+
+	// Por personagem: dois presets (todos os morphs do rosto), corpo (10%) e overrides (5%)
+	struct FCharacterSources
+	{
+		TMap<FName, float> PresetA;
+		TMap<FName, float> PresetB;
+		TMap<FName, float> Body;
+		TMap<FName, float> Overrides;
+		float PresetBlend = 0.5f;
+
+		FErosMorphBlendLayers Layers;
+		TArray<float> Current;
+		TArray<float> Scratch;
+		TBitArray<> Dirty;
+	};
+
+	TArray<FCharacterSources> Characters;
+	Characters.SetNum(NumCharacters);
+	for (FCharacterSources& Character : Characters)
+	{
+		for (int32 Slot = 0; Slot < NumMorphs; ++Slot)
+		{
+			const FName MorphName = Table->Morphs[Slot].MorphName;
+			Character.PresetA.Add(MorphName, Random.FRand());
+			Character.PresetB.Add(MorphName, Random.FRand());
+			if (Random.FRand() < 0.1f)
+			{
+				Character.Body.Add(MorphName, Random.FRand());
+			}
+			if (Random.FRand() < 0.05f)
+			{
+				Character.Overrides.Add(MorphName, Random.FRand());
+			}
+		}
+		Character.PresetBlend = Random.FRand();
+
+		auto MakeLayer = [Table](const TMap<FName, float>& Source)
+		{
+			TSharedRef<FErosMorphLayer, ESPMode::ThreadSafe> Layer = MakeShared<FErosMorphLayer, ESPMode::ThreadSafe>();
+			Layer->SetFromMap(*Table, Source);
+			return Layer;
+		};
+		Character.Layers.Layers.Emplace(MakeLayer(Character.PresetA), 1.0f);
+		Character.Layers.Layers.Emplace(MakeLayer(Character.PresetB), Character.PresetBlend);
+		Character.Layers.Layers.Emplace(MakeLayer(Character.Body), 1.0f);
+		Character.Layers.Layers.Emplace(MakeLayer(Character.Overrides), 1.0f);
+		Character.Current.Init(-1.0f, NumMorphs);
+		Character.Dirty.Init(false, NumMorphs);
+	}
+
+	// Caminho por mapa: hash por morph por fonte
+	TArray<TArray<float>> MapCurrent;
+	MapCurrent.SetNum(NumCharacters);
+	for (TArray<float>& Current : MapCurrent)
+	{
+		Current.Init(-1.0f, NumMorphs);
+	}
+
+	int64 NumMapChanged = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 CharacterIndex = 0; CharacterIndex < NumCharacters; ++CharacterIndex)
+		{
+			const FCharacterSources& Character = Characters[CharacterIndex];
+			TArray<float>& Current = MapCurrent[CharacterIndex];
+
+			for (int32 Slot = 0; Slot < NumMorphs; ++Slot)
+			{
+				const FErosMorphDefinition& Definition = Table->Morphs[Slot];
+				float Weight = Definition.DefaultWeight;
+				if (const float* Value = Character.PresetA.Find(Definition.MorphName)) { Weight = *Value; }
+				if (const float* Value = Character.PresetB.Find(Definition.MorphName)) { Weight += (*Value - Weight) * Character.PresetBlend; }
+				if (const float* Value = Character.Body.Find(Definition.MorphName)) { Weight = *Value; }
+				if (const float* Value = Character.Overrides.Find(Definition.MorphName)) { Weight = *Value; }
+
+				Weight = FMath::Clamp(Weight, Definition.MinWeight, Definition.MaxWeight);
+				if (Weight != Current[Slot])
+				{
+					Current[Slot] = Weight;
+					++NumMapChanged;
+				}
+			}
+		}
+	}
+	const double MapSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// Denso, uma thread
+	int64 NumDenseChanged = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (FCharacterSources& Character : Characters)
+		{
+			NumDenseChanged += ErosMorphBlend::Evaluate(*TableArrays, Character.Layers, Character.Scratch, Character.Current.GetData(), Character.Dirty.GetData());
+		}
+	}
+	const double DenseSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// Denso, a multidão num lote (como o subsystem faz)
+	for (FCharacterSources& Character : Characters)
+	{
+		Character.Current.Init(-1.0f, NumMorphs);
+	}
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		ParallelFor(TEXT("ErosMorphBlendBenchmark"), Characters.Num(), MinBlendsPerWorker, [&Characters, &TableArrays](int32 Index)
+		{
+			FCharacterSources& Character = Characters[Index];
+			ErosMorphBlend::Evaluate(*TableArrays, Character.Layers, Character.Scratch, Character.Current.GetData(), Character.Dirty.GetData());
+		});
+	}
+	const double BatchSeconds = FPlatformTime::Seconds() - StartTime;
+
+	const double NumBlends = static_cast<double>(NumCharacters) * NumIterations;
+	UE_LOG(LogTemp, Log, TEXT("Eros.Morph.BlendBenchmark - %d characters x %d morphs x %d iterations"), NumCharacters, NumMorphs, NumIterations);
+	UE_LOG(LogTemp, Log, TEXT("Eros.Morph.BlendBenchmark - TMap: %.2f us/character | dense: %.2f us/character | dense batch: %.2f us/character (changed %lld vs %lld)"),
+		MapSeconds * 1e6 / NumBlends, DenseSeconds * 1e6 / NumBlends, BatchSeconds * 1e6 / NumBlends, NumMapChanged, NumDenseChanged);
+}
+
+static FAutoConsoleCommand ErosMorphBlendBenchmarkCmd(
+	TEXT("Eros.Morph.BlendBenchmark"),
+	TEXT("Compara o blend de morphs por TMap com o kernel denso (uma thread e em lote). Args: [Characters=200] [Morphs=300] [Iterations=20]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ErosMorphBlendBenchmark));
@@ -0,0 +1,99 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosMorphBlend.h
+// Blend vetorizado dos pesos de morph (presets, corpo, overrides) em lote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ErosMorphBlend.generated.h"
+
+class UErosMorphComponent;
+class UErosMorphTable;
+
+/**
+ * Uma fonte de pesos em arrays densos alinhados com os slots da UErosMorphTable
+ * Mask = 1 nos slots que a fonte define, 0 nos outros (a fonte não mexe neles)
+ */
+struct EROSSOCIAL_API FErosMorphLayer
+{
+	TArray<float> Values;
+	TArray<float> Mask;
+
+	void Init(int32 NumSlots);
+	void Set(int32 Slot, float Value);
+
+	/** Converte um mapa nome -> peso (presets, overrides); nomes fora da tabela são ignorados */
+	void SetFromMap(const UErosMorphTable& Table, const TMap<FName, float>& Source);
+
+	int32 Num() const { return Values.Num(); }
+};
+
+/**
+ * Limites e padrões da tabela em arrays densos
+ */
+struct EROSSOCIAL_API FErosMorphTableArrays
+{
+	TArray<FName> Names;
+	TArray<float> Defaults;
+	TArray<float> MinWeights;
+	TArray<float> MaxWeights;
+
+	int32 Num() const { return Defaults.Num(); }
+};
+
+/**
+ * Entrada do blend de um personagem: camadas aplicadas em ordem, cada uma com seu peso
+ * Resultado = padrões da tabela, e para cada camada Out += (Values - Out) * Mask * Alpha
+ */
+struct FErosMorphBlendLayers
+{
+	TArray<TPair<TSharedPtr<const FErosMorphLayer, ESPMode::ThreadSafe>, float>, TInlineAllocator<4>> Layers;
+};
+
+namespace ErosMorphBlend
+{
+	/** Out += (Values - Out) * Mask * Alpha (4 slots por instrução) */
+	EROSSOCIAL_API void BlendLayer(float* RESTRICT Out, const float* RESTRICT Values, const float* RESTRICT Mask, float Alpha, int32 Num);
+
+	/**
+	 * Clamp de Blended em [Min, Max], comparação com Current e cópia para Current
+	 * Slots que mudaram ganham bit em DirtyWords (1 bit por slot, palavras de 32); retorna quantos mudaram
+	 */
+	EROSSOCIAL_API int32 ClampAndDiff(float* RESTRICT Blended, const float* RESTRICT MinWeights, const float* RESTRICT MaxWeights,
+		float* RESTRICT Current, uint32* RESTRICT DirtyWords, int32 Num);
+
+	/** Blend completo de um personagem (padrões, camadas, clamp, diff) */
+	EROSSOCIAL_API int32 Evaluate(const FErosMorphTableArrays& Table, const FErosMorphBlendLayers& Input,
+		TArray<float>& Scratch, float* Current, uint32* DirtyWords);
+}
+
+/**
+ * Roda os blends pedidos no frame de todos os personagens juntos
+ * - UErosMorphComponent::SetBlendLayers só agenda; o blend acontece no Tick, em paralelo entre personagens
+ * - Os slots que mudaram ficam sujos no componente e vão para o mesh no próximo tick dele
+ */
+UCLASS()
+class EROSSOCIAL_API UErosMorphBlendSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosMorphBlendSubsystem* Get(const UObject* WorldContextObject);
+
+	// USubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RequestBlend(UErosMorphComponent* Component);
+
+	/** Roda agora os blends pendentes */
+	void FlushPendingBlends();
+
+private:
+	TArray<TWeakObjectPtr<UErosMorphComponent>> PendingComponents;
+	TArray<UErosMorphComponent*> BatchScratch;
+};
@@ -0,0 +1,322 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosMorphComponent.cpp
+
+#include "Systems/Customization/ErosMorphComponent.h"
+#include "Systems/Customization/ErosMorphTable.h"
+#include "Systems/Customization/ErosBakedMorphCache.h"
+#include "Systems/Customization/ErosCustomizationStats.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+
+DECLARE_CYCLE_STAT(TEXT("Morph Flush"), STAT_ErosMorph_Flush, STATGROUP_ErosCustomization);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Morph Weights Pushed"), STAT_ErosMorph_Pushed, STATGROUP_ErosCustomization);
+
+UErosMorphComponent::UErosMorphComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UErosMorphComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// Tabela definida no Blueprint
+	if (MorphTable && Weights.Num() != MorphTable->Num())
+	{
+		ResetToDefaults();
+	}
+}
+
+void UErosMorphComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (BakedMeshKey != 0)
+	{
+		if (UErosBakedMorphCache* BakedCache = UErosBakedMorphCache::Get(this))
+		{
+			BakedCache->ReleaseBakedMesh(BakedMeshKey);
+		}
+		BakedMeshKey = 0;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UErosMorphComponent::SetMorphTable(UErosMorphTable* NewTable)
+{
+	MorphTable = NewTable;
+	ResolvedMesh.Reset();
+	ResetToDefaults();
+}
+
+void UErosMorphComponent::SetTargetMesh(USkeletalMeshComponent* NewTargetMesh)
+{
+	if (USkeletalMeshComponent* OldTargetMesh = TargetMesh.Get())
+	{
+		OldTargetMesh->PrimaryComponentTick.RemovePrerequisite(this, PrimaryComponentTick);
+	}
+
+	TargetMesh = NewTargetMesh;
+	ResolvedMesh.Reset();
+
+	// Pesos chegam antes da avaliação da animação no mesmo frame
+	if (NewTargetMesh)
+	{
+		NewTargetMesh->PrimaryComponentTick.AddPrerequisite(this, PrimaryComponentTick);
+	}
+
+	MarkAllDirty();
+}
+
+int32 UErosMorphComponent::FindSlot(FName MorphName) const
+{
+	return MorphTable ? MorphTable->FindSlot(MorphName) : INDEX_NONE;
+}
+
+void UErosMorphComponent::SetWeight(int32 Slot, float Weight)
+{
+	if (!Weights.IsValidIndex(Slot))
+	{
+		return;
+	}
+
+	const FErosMorphDefinition& Definition = MorphTable->Morphs[Slot];
+	const float Clamped = FMath::Clamp(Weight, Definition.MinWeight, Definition.MaxWeight);
+	if (Weights[Slot] != Clamped)
+	{
+		Weights[Slot] = Clamped;
+		MarkDirty(Slot);
+	}
+}
+
+void UErosMorphComponent::SetMorphWeight(FName MorphName, float Weight)
+{
+	SetWeight(FindSlot(MorphName), Weight);
+}
+
+float UErosMorphComponent::GetMorphWeight(FName MorphName) const
+{
+	return GetWeight(FindSlot(MorphName));
+}
+
+void UErosMorphComponent::SetUseBakedMesh(bool bEnable)
+{
+	if (bUseBakedMesh != bEnable)
+	{
+		bUseBakedMesh = bEnable;
+		bBakeRetry = false;
+
+		// Reavalia no próximo flush (assa ou volta para os morphs ao vivo)
+		MarkAllDirty();
+	}
+}
+
+void UErosMorphComponent::SetBlendLayers(FErosMorphBlendLayers&& NewLayers)
+{
+	BlendLayers = MoveTemp(NewLayers);
+	if (bBlendPending)
+	{
+		return;
+	}
+
+	bBlendPending = true;
+	if (UErosMorphBlendSubsystem* BlendSubsystem = UErosMorphBlendSubsystem::Get(this))
+	{
+		BlendSubsystem->RequestBlend(this);
+	}
+	else if (PrepareBlend())
+	{
+		EvaluateBlend();
+		FinishBlend();
+	}
+}
+
+bool UErosMorphComponent::PrepareBlend()
+{
+	bBlendPending = false;
+	if (!MorphTable || Weights.Num() != MorphTable->Num())
+	{
+		return false;
+	}
+
+	BlendTableArrays = MorphTable->GetDenseArrays();
+	return true;
+}
+
+void UErosMorphComponent::EvaluateBlend()
+{
+	ErosMorphBlend::Evaluate(*BlendTableArrays, BlendLayers, BlendScratch, Weights.GetData(), DirtySlots.GetData());
+}
+
+void UErosMorphComponent::FinishBlend()
+{
+	BlendTableArrays.Reset();
+
+	NumDirty = DirtySlots.CountSetBits();
+	if (NumDirty > 0)
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UErosMorphComponent::ResetToDefaults()
+{
+	if (!MorphTable)
+	{
+		Weights.Reset();
+		DirtySlots.Reset();
+		NumDirty = 0;
+		return;
+	}
+
+	MorphTable->GetDefaultWeights(Weights);
+	MarkAllDirty();
+}
+
+void UErosMorphComponent::MarkDirty(int32 Slot)
+{
+	if (!DirtySlots[Slot])
+	{
+		DirtySlots[Slot] = true;
+		++NumDirty;
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UErosMorphComponent::MarkAllDirty()
+{
+	DirtySlots.Init(true, Weights.Num());
+	NumDirty = Weights.Num();
+	SetComponentTickEnabled(NumDirty > 0);
+}
+
+void UErosMorphComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushToMesh();
+}
+
+void UErosMorphComponent::FlushToMesh()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosMorph_Flush);
+
+	USkeletalMeshComponent* MeshComponent = TargetMesh.Get();
+
+	// Com o assado aplicado, os slots continuam resolvidos contra o mesh original
+	USkeletalMesh* MeshAsset = nullptr;
+	if (MeshComponent)
+	{
+		MeshAsset = BakedMeshKey != 0 ? LiveMesh.Get() : MeshComponent->GetSkeletalMeshAsset();
+	}
+	if (!MorphTable || !MeshAsset)
+	{
+		// Sem mesh ainda: os slots continuam sujos até o mesh aparecer
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	if (ResolvedMesh.Get() != MeshAsset)
+	{
+		ResolvedMesh = MeshAsset;
+		MarkAllDirty();
+	}
+
+	if (bUseBakedMesh && (NumDirty > 0 || bBakeRetry))
+	{
+		if (ApplyBakedMesh(*MeshComponent, *MeshAsset))
+		{
+			DirtySlots.Init(false, Weights.Num());
+			NumDirty = 0;
+			SetComponentTickEnabled(false);
+			return;
+		}
+	}
+
+	if (BakedMeshKey != 0 && NumDirty > 0)
+	{
+		RestoreLiveMesh(*MeshComponent);
+	}
+
+	if (NumDirty > 0)
+	{
+		const FErosResolvedMorphs& Resolved = MorphTable->ResolveForMesh(MeshAsset);
+
+		int32 NumPushed = 0;
+		for (TConstSetBitIterator<> It(DirtySlots); It; ++It)
+		{
+			const int32 Slot = It.GetIndex();
+			if (Resolved.MeshMorphIndices[Slot] != INDEX_NONE)
+			{
+				MeshComponent->SetMorphTarget(MorphTable->Morphs[Slot].MorphName, Weights[Slot], false);
+				++NumPushed;
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_ErosMorph_Pushed, NumPushed);
+
+		DirtySlots.Init(false, Weights.Num());
+		NumDirty = 0;
+	}
+
+	// Bake adiado: os morphs ao vivo cobrem até sobrar orçamento
+	SetComponentTickEnabled(bBakeRetry);
+}
+
+bool UErosMorphComponent::ApplyBakedMesh(USkeletalMeshComponent& MeshComponent, USkeletalMesh& LiveAsset)
+{
+	UErosBakedMorphCache* BakedCache = UErosBakedMorphCache::Get(this);
+	if (!BakedCache || !BakedCache->CanBake(&LiveAsset))
+	{
+		bBakeRetry = false;
+		return false;
+	}
+
+	uint64 NewKey = 0;
+	USkeletalMesh* BakedMesh = BakedCache->AcquireBakedMesh(&LiveAsset, MorphTable->GetDenseArrays()->Names, Weights, NewKey);
+	if (!BakedMesh)
+	{
+		// Orçamento do frame esgotado (tenta de novo) ou o mesh não aceita bake (fica ao vivo)
+		bBakeRetry = BakedCache->CanBake(&LiveAsset);
+		return false;
+	}
+
+	if (BakedMeshKey != 0)
+	{
+		BakedCache->ReleaseBakedMesh(BakedMeshKey);
+	}
+	else
+	{
+		LiveMesh = &LiveAsset;
+	}
+	BakedMeshKey = NewKey;
+	bBakeRetry = false;
+
+	if (MeshComponent.GetSkeletalMeshAsset() != BakedMesh)
+	{
+		MeshComponent.SetSkeletalMeshAsset(BakedMesh);
+	}
+
+	// Os deltas já estão nas posições
+	MeshComponent.ClearMorphTargets();
+	return true;
+}
+
+void UErosMorphComponent::RestoreLiveMesh(USkeletalMeshComponent& MeshComponent)
+{
+	if (UErosBakedMorphCache* BakedCache = UErosBakedMorphCache::Get(this))
+	{
+		BakedCache->ReleaseBakedMesh(BakedMeshKey);
+	}
+	BakedMeshKey = 0;
+
+	if (USkeletalMesh* LiveAsset = LiveMesh.Get())
+	{
+		MeshComponent.SetSkeletalMeshAsset(LiveAsset);
+	}
+	LiveMesh.Reset();
+
+	// ClearMorphTargets zerou tudo no mesh
+	MarkAllDirty();
+}
@@ -0,0 +1,116 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosMorphComponent.h
+// Pesos de morph do personagem (array denso + envio só do que mudou)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Systems/Customization/ErosMorphBlend.h"
+#include "ErosMorphComponent.generated.h"
+
+class UErosMorphBlendSubsystem;
+class UErosMorphTable;
+class USkeletalMesh;
+class USkeletalMeshComponent;
+
+/**
+ * Pesos de morph de um personagem
+ * - Um float por slot da UErosMorphTable; escrever um valor igual não suja nada
+ * - Slots alterados são marcados e enviados ao skeletal mesh juntos, uma vez por frame (o tick só liga quando há algo sujo)
+ * - Slots que o mesh atual não tem são ignorados no envio
+ * - SetBlendLayers recalcula todos os pesos a partir de camadas densas, em lote com os outros personagens
+ *   (UErosMorphBlendSubsystem); SetWeight direto vale até o próximo blend
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class EROSSOCIAL_API UErosMorphComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UErosMorphComponent();
+
+	virtual void OnRegister() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Troca a tabela (pesos voltam aos padrões da nova tabela) */
+	void SetMorphTable(UErosMorphTable* NewTable);
+	UErosMorphTable* GetMorphTable() const { return MorphTable; }
+
+	/** Mesh que recebe os pesos (normalmente o GetMesh do personagem) */
+	void SetTargetMesh(USkeletalMeshComponent* NewTargetMesh);
+
+	int32 FindSlot(FName MorphName) const;
+
+	void SetWeight(int32 Slot, float Weight);
+	float GetWeight(int32 Slot) const { return Weights.IsValidIndex(Slot) ? Weights[Slot] : 0.0f; }
+
+	/** Todos os pesos na ordem dos slots (para blend em lote) */
+	TConstArrayView<float> GetWeights() const { return Weights; }
+
+	UFUNCTION(BlueprintCallable, Category = "Character|Morphs")
+	void SetMorphWeight(FName MorphName, float Weight);
+
+	UFUNCTION(BlueprintPure, Category = "Character|Morphs")
+	float GetMorphWeight(FName MorphName) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Character|Morphs")
+	void ResetToDefaults();
+
+	/** Envia agora o que está sujo (normalmente espera o tick) */
+	UFUNCTION(BlueprintCallable, Category = "Character|Morphs")
+	void FlushToMesh();
+
+	bool HasPendingChanges() const { return NumDirty > 0; }
+
+	/**
+	 * Troca o mesh por uma cópia com os morphs assados quando possível (UErosBakedMorphCache)
+	 * Para avatares remotos; o jogador local e a tela de customização ficam nos morphs ao vivo
+	 */
+	void SetUseBakedMesh(bool bEnable);
+	bool IsUsingBakedMesh() const { return BakedMeshKey != 0; }
+
+	/** Agenda o blend das camadas (roda no lote do frame; fora de jogo roda na hora) */
+	void SetBlendLayers(FErosMorphBlendLayers&& NewLayers);
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Morphs")
+	TObjectPtr<UErosMorphTable> MorphTable;
+
+private:
+	friend UErosMorphBlendSubsystem;
+
+	// Passos do blend em lote: Prepare e Finish na game thread, Evaluate numa worker
+	bool PrepareBlend();
+	void EvaluateBlend();
+	void FinishBlend();
+
+	void MarkDirty(int32 Slot);
+	void MarkAllDirty();
+
+	bool ApplyBakedMesh(USkeletalMeshComponent& MeshComponent, USkeletalMesh& LiveAsset);
+	void RestoreLiveMesh(USkeletalMeshComponent& MeshComponent);
+
+	TWeakObjectPtr<USkeletalMeshComponent> TargetMesh;
+
+	// Mesh para o qual os slots foram resolvidos (troca de mesh reenvia tudo)
+	TWeakObjectPtr<const USkeletalMesh> ResolvedMesh;
+
+	// Mesh original enquanto o assado está aplicado
+	TWeakObjectPtr<USkeletalMesh> LiveMesh;
+	uint64 BakedMeshKey = 0;
+	bool bUseBakedMesh = false;
+
+	// Bake adiado pelo orçamento do frame: tenta de novo no próximo tick
+	bool bBakeRetry = false;
+
+	TArray<float> Weights;
+	TBitArray<> DirtySlots;
+	int32 NumDirty = 0;
+
+	FErosMorphBlendLayers BlendLayers;
+	TSharedPtr<const FErosMorphTableArrays, ESPMode::ThreadSafe> BlendTableArrays;
+	TArray<float> BlendScratch;
+	bool bBlendPending = false;
+};
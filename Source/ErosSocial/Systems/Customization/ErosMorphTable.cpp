@@ -0,0 +1,160 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosMorphTable.cpp
+
+#include "Systems/Customization/ErosMorphTable.h"
+#include "Systems/Customization/ErosMorphBlend.h"
+#include "Engine/SkeletalMesh.h"
+
+int32 UErosMorphTable::FindSlot(FName MorphName) const
+{
+	if (SlotsByName.Num() != Morphs.Num())
+	{
+		SlotsByName.Reset();
+		for (int32 Slot = 0; Slot < Morphs.Num(); ++Slot)
+		{
+			SlotsByName.FindOrAdd(Morphs[Slot].MorphName, Slot);
+		}
+	}
+
+	const int32* Slot = SlotsByName.Find(MorphName);
+	return Slot ? *Slot : INDEX_NONE;
+}
+
+int32 UErosMorphTable::AddMorph(FName MorphName, float DefaultWeight, float MinWeight, float MaxWeight)
+{
+	const int32 ExistingSlot = FindSlot(MorphName);
+	if (ExistingSlot != INDEX_NONE)
+	{
+		return ExistingSlot;
+	}
+
+	FErosMorphDefinition& Definition = Morphs.AddDefaulted_GetRef();
+	Definition.MorphName = MorphName;
+	Definition.DefaultWeight = DefaultWeight;
+	Definition.MinWeight = MinWeight;
+	Definition.MaxWeight = MaxWeight;
+
+	InvalidateCaches();
+	return Morphs.Num() - 1;
+}
+
+int32 UErosMorphTable::FindFacePresetIndex(const FString& PresetID) const
+{
+	return FacePresets.IndexOfByPredicate([&PresetID](const FFacePresetData& Preset)
+	{
+		return Preset.PresetID == PresetID;
+	});
+}
+
+const FFacePresetData* UErosMorphTable::FindFacePreset(const FString& PresetID) const
+{
+	return FacePresets.FindByPredicate([&PresetID](const FFacePresetData& Preset)
+	{
+		return Preset.PresetID == PresetID;
+	});
+}
+
+const FErosResolvedMorphs& UErosMorphTable::ResolveForMesh(const USkeletalMesh* Mesh) const
+{
+	const TObjectKey<USkeletalMesh> MeshKey(Mesh);
+	if (const FErosResolvedMorphs* Cached = ResolvedMeshes.Find(MeshKey))
+	{
+		if (Cached->MeshMorphIndices.Num() == Morphs.Num())
+		{
+			return *Cached;
+		}
+	}
+
+	FErosResolvedMorphs& Resolved = ResolvedMeshes.FindOrAdd(MeshKey);
+	Resolved.MeshMorphIndices.Init(INDEX_NONE, Morphs.Num());
+	Resolved.NumResolved = 0;
+
+	if (Mesh)
+	{
+		for (int32 Slot = 0; Slot < Morphs.Num(); ++Slot)
+		{
+			int32 MeshIndex = INDEX_NONE;
+			if (Mesh->FindMorphTargetAndIndex(Morphs[Slot].MorphName, MeshIndex))
+			{
+				Resolved.MeshMorphIndices[Slot] = MeshIndex;
+				++Resolved.NumResolved;
+			}
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("UErosMorphTable::ResolveForMesh - %s: %d/%d morphs found on %s"),
+			*GetName(), Resolved.NumResolved, Morphs.Num(), *Mesh->GetName());
+	}
+
+	return Resolved;
+}
+
+void UErosMorphTable::GetDefaultWeights(TArray<float>& OutWeights) const
+{
+	OutWeights.SetNumUninitialized(Morphs.Num());
+	for (int32 Slot = 0; Slot < Morphs.Num(); ++Slot)
+	{
+		OutWeights[Slot] = Morphs[Slot].DefaultWeight;
+	}
+}
+
+TSharedPtr<const FErosMorphTableArrays, ESPMode::ThreadSafe> UErosMorphTable::GetDenseArrays() const
+{
+	if (!DenseArrays.IsValid() || DenseArrays->Num() != Morphs.Num())
+	{
+		TSharedRef<FErosMorphTableArrays, ESPMode::ThreadSafe> Arrays = MakeShared<FErosMorphTableArrays, ESPMode::ThreadSafe>();
+		Arrays->Names.SetNumUninitialized(Morphs.Num());
+		Arrays->Defaults.SetNumUninitialized(Morphs.Num());
+		Arrays->MinWeights.SetNumUninitialized(Morphs.Num());
+		Arrays->MaxWeights.SetNumUninitialized(Morphs.Num());
+		for (int32 Slot = 0; Slot < Morphs.Num(); ++Slot)
+		{
+			Arrays->Names[Slot] = Morphs[Slot].MorphName;
+			Arrays->Defaults[Slot] = Morphs[Slot].DefaultWeight;
+			Arrays->MinWeights[Slot] = Morphs[Slot].MinWeight;
+			Arrays->MaxWeights[Slot] = Morphs[Slot].MaxWeight;
+		}
+		DenseArrays = Arrays;
+	}
+
+	return DenseArrays;
+}
+
+TSharedPtr<const FErosMorphLayer, ESPMode::ThreadSafe> UErosMorphTable::GetFacePresetLayer(const FString& PresetID) const
+{
+	if (const TSharedPtr<const FErosMorphLayer, ESPMode::ThreadSafe>* Cached = FacePresetLayers.Find(PresetID))
+	{
+		if ((*Cached)->Num() == Morphs.Num())
+		{
+			return *Cached;
+		}
+	}
+
+	const FFacePresetData* Preset = FindFacePreset(PresetID);
+	if (!Preset)
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FErosMorphLayer, ESPMode::ThreadSafe> Layer = MakeShared<FErosMorphLayer, ESPMode::ThreadSafe>();
+	Layer->SetFromMap(*this, Preset->MorphValues);
+	FacePresetLayers.Add(PresetID, Layer);
+	return Layer;
+}
+
+void UErosMorphTable::InvalidateCaches()
+{
+	SlotsByName.Reset();
+	ResolvedMeshes.Reset();
+
+	// Quem já tem os ponteiros (blends em voo) continua com a versão antiga
+	DenseArrays.Reset();
+	FacePresetLayers.Reset();
+}
+
+#if WITH_EDITOR
+void UErosMorphTable::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateCaches();
+}
+#endif
@@ -0,0 +1,110 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosMorphTable.h
+// Tabela de morphs (corpo e rosto) e presets de rosto
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "UObject/ObjectKey.h"
+#include "CharacterSaveData.h"
+#include "ErosMorphTable.generated.h"
+
+class USkeletalMesh;
+struct FErosMorphLayer;
+struct FErosMorphTableArrays;
+
+/**
+ * Um morph controlado pela customização
+ */
+USTRUCT(BlueprintType)
+struct FErosMorphDefinition
+{
+	GENERATED_BODY()
+
+	// Nome do morph target no skeletal mesh
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Morph")
+	FName MorphName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Morph")
+	float DefaultWeight = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Morph")
+	float MinWeight = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Morph")
+	float MaxWeight = 1.0f;
+};
+
+/**
+ * Slots da tabela resolvidos para um skeletal mesh
+ */
+struct FErosResolvedMorphs
+{
+	// Por slot da tabela: índice em USkeletalMesh::GetMorphTargets, ou INDEX_NONE se o mesh não tem o morph
+	TArray<int32> MeshMorphIndices;
+
+	int32 NumResolved = 0;
+};
+
+/**
+ * Tabela de morphs
+ * - Cada morph tem um slot (índice em Morphs); os pesos vivem num array de floats alinhado com os slots
+ * - Nome -> slot e slot -> morph do mesh são resolvidos uma vez (por tabela e por skeletal mesh)
+ * - Também guarda os presets de rosto (FAppearanceCustomization::FacePresetID) e os penteados;
+ *   a aparência replicada (FErosAppearanceDescriptor) manda o índice deles nestes arrays
+ */
+UCLASS(BlueprintType)
+class EROSSOCIAL_API UErosMorphTable : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Morphs")
+	TArray<FErosMorphDefinition> Morphs;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Presets")
+	TArray<FFacePresetData> FacePresets;
+
+	// IDs válidos de FAppearanceCustomization::HairStyle
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Presets")
+	TArray<FString> HairStyles;
+
+	int32 Num() const { return Morphs.Num(); }
+
+	/** Slot do morph, ou INDEX_NONE */
+	int32 FindSlot(FName MorphName) const;
+
+	/** Adiciona (ou encontra) um morph; usado para montar tabelas em runtime */
+	int32 AddMorph(FName MorphName, float DefaultWeight = 0.0f, float MinWeight = 0.0f, float MaxWeight = 1.0f);
+
+	const FFacePresetData* FindFacePreset(const FString& PresetID) const;
+
+	/** Índice em FacePresets, ou INDEX_NONE */
+	int32 FindFacePresetIndex(const FString& PresetID) const;
+
+	/** Mapeamento slot -> morph do mesh (calculado na primeira chamada para cada mesh) */
+	const FErosResolvedMorphs& ResolveForMesh(const USkeletalMesh* Mesh) const;
+
+	/** Pesos padrão na ordem dos slots */
+	void GetDefaultWeights(TArray<float>& OutWeights) const;
+
+	/** Padrões e limites em arrays densos para o blend (compartilhado com as workers) */
+	TSharedPtr<const FErosMorphTableArrays, ESPMode::ThreadSafe> GetDenseArrays() const;
+
+	/** Preset já convertido em camada densa, ou nullptr */
+	TSharedPtr<const FErosMorphLayer, ESPMode::ThreadSafe> GetFacePresetLayer(const FString& PresetID) const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	void InvalidateCaches();
+
+	// Só game thread
+	mutable TMap<FName, int32> SlotsByName;
+	mutable TMap<TObjectKey<USkeletalMesh>, FErosResolvedMorphs> ResolvedMeshes;
+	mutable TSharedPtr<const FErosMorphTableArrays, ESPMode::ThreadSafe> DenseArrays;
+	mutable TMap<FString, TSharedPtr<const FErosMorphLayer, ESPMode::ThreadSafe>> FacePresetLayers;
+};
@@ -0,0 +1,275 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosInteractionLatency.cpp
+
+#include "Systems/Interaction/ErosInteractionLatency.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+TRACE_DECLARE_FLOAT_COUNTER(ErosLatency_Select, TEXT("ErosInteraction/Select (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(ErosLatency_RequestPartner, TEXT("ErosInteraction/RequestPartner (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(ErosLatency_PrivateChat, TEXT("ErosInteraction/PrivateChat (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(ErosLatency_ViewProfile, TEXT("ErosInteraction/ViewProfile (ms)"));
+
+namespace
+{
+	const TCHAR* GetFlowName(EErosInteractionFlow Flow)
+	{
+		switch (Flow)
+		{
+		case EErosInteractionFlow::Select:         return TEXT("Select");
+		case EErosInteractionFlow::RequestPartner: return TEXT("RequestPartner");
+		case EErosInteractionFlow::PrivateChat:    return TEXT("PrivateChat");
+		case EErosInteractionFlow::ViewProfile:    return TEXT("ViewProfile");
+		default:                                   return TEXT("Unknown");
+		}
+	}
+
+	const TCHAR* GetStageName(EErosInteractionStage Stage)
+	{
+		switch (Stage)
+		{
+		case EErosInteractionStage::Pick:           return TEXT("Pick");
+		case EErosInteractionStage::BlueprintEvent: return TEXT("BlueprintEvent");
+		case EErosInteractionStage::ServerRequest:  return TEXT("ServerRequest");
+		case EErosInteractionStage::ServerResponse: return TEXT("ServerResponse");
+		case EErosInteractionStage::UIDisplayed:    return TEXT("UIDisplayed");
+		default:                                    return TEXT("Unknown");
+		}
+	}
+
+	void TraceFlowLatency(EErosInteractionFlow Flow, double Milliseconds)
+	{
+		switch (Flow)
+		{
+		case EErosInteractionFlow::Select:         TRACE_COUNTER_SET(ErosLatency_Select, Milliseconds); break;
+		case EErosInteractionFlow::RequestPartner: TRACE_COUNTER_SET(ErosLatency_RequestPartner, Milliseconds); break;
+		case EErosInteractionFlow::PrivateChat:    TRACE_COUNTER_SET(ErosLatency_PrivateChat, Milliseconds); break;
+		case EErosInteractionFlow::ViewProfile:    TRACE_COUNTER_SET(ErosLatency_ViewProfile, Milliseconds); break;
+		default: break;
+		}
+	}
+}
+
+// ========== HISTOGRAMA ==========
+
+double FErosLatencyHistogram::GetBucketUpperBound(int32 Bucket)
+{
+	return 0.5 * static_cast<double>(1 << Bucket);
+}
+
+void FErosLatencyHistogram::Add(double Milliseconds)
+{
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets - 1 && Milliseconds >= GetBucketUpperBound(Bucket))
+	{
+		++Bucket;
+	}
+
+	++Counts[Bucket];
+	++Num;
+	SumMs += Milliseconds;
+	MaxMs = FMath::Max(MaxMs, Milliseconds);
+}
+
+double FErosLatencyHistogram::GetPercentile(double Percentile) const
+{
+	if (Num == 0)
+	{
+		return 0.0;
+	}
+
+	const uint32 Target = FMath::Max<uint32>(1, FMath::CeilToInt(Percentile * Num));
+	uint32 Accumulated = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Accumulated += Counts[Bucket];
+		if (Accumulated >= Target)
+		{
+			// O último bucket não tem limite: vale o máximo observado
+			return Bucket == NumBuckets - 1 ? MaxMs : FMath::Min(GetBucketUpperBound(Bucket), MaxMs);
+		}
+	}
+
+	return MaxMs;
+}
+
+// ========== TRACKER ==========
+
+UErosInteractionLatencyTracker* UErosInteractionLatencyTracker::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UErosInteractionLatencyTracker>() : nullptr;
+}
+
+void UErosInteractionLatencyTracker::Deinitialize()
+{
+	// Fim da sessão
+	WriteCsv();
+
+	Super::Deinitialize();
+}
+
+void UErosInteractionLatencyTracker::BeginFlow(EErosInteractionFlow Flow, uint64 InputCycles)
+{
+	FFlowState& State = Flows[static_cast<int32>(Flow)];
+	if (State.bActive)
+	{
+		++State.Abandoned;
+	}
+
+	State.bActive = true;
+	State.StartCycles = InputCycles;
+}
+
+void UErosInteractionLatencyTracker::MarkStage(EErosInteractionFlow Flow, EErosInteractionStage Stage, uint64 Cycles)
+{
+	FFlowState& State = Flows[static_cast<int32>(Flow)];
+	if (!State.bActive)
+	{
+		return;
+	}
+
+	const double Milliseconds = FPlatformTime::ToMilliseconds64(Cycles - State.StartCycles);
+	State.Stages[static_cast<int32>(Stage)].Add(Milliseconds);
+
+	if (Stage == EErosInteractionStage::UIDisplayed)
+	{
+		FinishFlow(Flow, Cycles);
+	}
+}
+
+void UErosInteractionLatencyTracker::MarkInteractionStage(EErosInteractionFlow Flow, EErosInteractionStage Stage)
+{
+	MarkStage(Flow, Stage, FPlatformTime::Cycles64());
+}
+
+void UErosInteractionLatencyTracker::CompleteInteractionFlow(EErosInteractionFlow Flow)
+{
+	if (Flows[static_cast<int32>(Flow)].bActive)
+	{
+		FinishFlow(Flow, FPlatformTime::Cycles64());
+	}
+}
+
+void UErosInteractionLatencyTracker::AbandonFlow(EErosInteractionFlow Flow)
+{
+	FFlowState& State = Flows[static_cast<int32>(Flow)];
+	if (State.bActive)
+	{
+		State.bActive = false;
+		++State.Abandoned;
+	}
+}
+
+void UErosInteractionLatencyTracker::FinishFlow(EErosInteractionFlow Flow, uint64 Cycles)
+{
+	FFlowState& State = Flows[static_cast<int32>(Flow)];
+	State.bActive = false;
+
+	const double Milliseconds = FPlatformTime::ToMilliseconds64(Cycles - State.StartCycles);
+	State.Total.Add(Milliseconds);
+
+	TraceFlowLatency(Flow, Milliseconds);
+	TRACE_BOOKMARK(TEXT("ErosInteraction %s %.1f ms"), GetFlowName(Flow), Milliseconds);
+}
+
+bool UErosInteractionLatencyTracker::WriteCsv() const
+{
+	FString Header = TEXT("Flow,Stage,Count,Abandoned,AvgMs,P50Ms,P90Ms,P99Ms,MaxMs");
+	for (int32 Bucket = 0; Bucket < FErosLatencyHistogram::NumBuckets; ++Bucket)
+	{
+		Header += Bucket == FErosLatencyHistogram::NumBuckets - 1
+			? FString::Printf(TEXT(",>=%gms"), FErosLatencyHistogram::GetBucketUpperBound(Bucket - 1))
+			: FString::Printf(TEXT(",<%gms"), FErosLatencyHistogram::GetBucketUpperBound(Bucket));
+	}
+
+	TArray<FString> Lines;
+	Lines.Add(Header);
+
+	auto AddRow = [&Lines](const TCHAR* FlowName, const TCHAR* StageName, uint32 Abandoned, const FErosLatencyHistogram& Histogram)
+	{
+		if (Histogram.Num == 0)
+		{
+			return;
+		}
+
+		FString Line = FString::Printf(TEXT("%s,%s,%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f"),
+			FlowName, StageName, Histogram.Num, Abandoned, Histogram.SumMs / Histogram.Num,
+			Histogram.GetPercentile(0.5), Histogram.GetPercentile(0.9), Histogram.GetPercentile(0.99), Histogram.MaxMs);
+		for (const uint32 Count : Histogram.Counts)
+		{
+			Line += FString::Printf(TEXT(",%u"), Count);
+		}
+		Lines.Add(MoveTemp(Line));
+	};
+
+	for (int32 FlowIndex = 0; FlowIndex < NumFlows; ++FlowIndex)
+	{
+		const FFlowState& State = Flows[FlowIndex];
+		const TCHAR* FlowName = GetFlowName(static_cast<EErosInteractionFlow>(FlowIndex));
+
+		for (int32 StageIndex = 0; StageIndex < NumStages; ++StageIndex)
+		{
+			AddRow(FlowName, GetStageName(static_cast<EErosInteractionStage>(StageIndex)), State.Abandoned, State.Stages[StageIndex]);
+		}
+		AddRow(FlowName, TEXT("Total"), State.Abandoned, State.Total);
+	}
+
+	if (Lines.Num() == 1)
+	{
+		return false;
+	}
+
+	const FString FilePath = FPaths::ProfilingDir() / TEXT("ErosInteraction") / FString::Printf(TEXT("ErosInteractionLatency_%s.csv"), *FDateTime::Now().ToString());
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UErosInteractionLatencyTracker::WriteCsv - Failed to write %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UErosInteractionLatencyTracker::WriteCsv - Saved %s"), *FilePath);
+	return true;
+}
+
+void UErosInteractionLatencyTracker::LogSummary() const
+{
+	for (int32 FlowIndex = 0; FlowIndex < NumFlows; ++FlowIndex)
+	{
+		const FFlowState& State = Flows[FlowIndex];
+		if (State.Total.Num == 0)
+		{
+			continue;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("UErosInteractionLatencyTracker - %s: %u samples, avg %.1f ms, p50 %.1f, p90 %.1f, p99 %.1f, max %.1f (%u abandoned)"),
+			GetFlowName(static_cast<EErosInteractionFlow>(FlowIndex)), State.Total.Num, State.Total.SumMs / State.Total.Num,
+			State.Total.GetPercentile(0.5), State.Total.GetPercentile(0.9), State.Total.GetPercentile(0.99), State.Total.MaxMs, State.Abandoned);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+
+static void ErosInteractionLatencyDump(const TArray<FString>& Args, UWorld* World)
+{
+	const UErosInteractionLatencyTracker* Tracker = UErosInteractionLatencyTracker::Get(World);
+	if (!Tracker)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Eros.Interaction.LatencyDump - No game instance"));
+		return;
+	}
+
+	Tracker->LogSummary();
+	Tracker->WriteCsv();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ErosInteractionLatencyDumpCmd(
+	TEXT("Eros.Interaction.LatencyDump"),
+	TEXT("Mostra o resumo de latência das interações e grava o CSV da sessão até agora"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ErosInteractionLatencyDump));
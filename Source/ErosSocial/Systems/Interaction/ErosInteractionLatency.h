@@ -0,0 +1,116 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosInteractionLatency.h
+// Latência clique -> resposta das interações sociais
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ErosInteractionLatency.generated.h"
+
+UENUM(BlueprintType)
+enum class EErosInteractionFlow : uint8
+{
+	Select          UMETA(DisplayName = "Select (Interaction Menu)"),
+	RequestPartner  UMETA(DisplayName = "Request Partner"),
+	PrivateChat     UMETA(DisplayName = "Private Chat"),
+	ViewProfile     UMETA(DisplayName = "View Profile"),
+	MAX             UMETA(Hidden)
+};
+
+/**
+ * Marcos de um fluxo, medidos a partir do input
+ */
+UENUM(BlueprintType)
+enum class EErosInteractionStage : uint8
+{
+	Pick            UMETA(DisplayName = "Pick (Raycast)"),
+	BlueprintEvent  UMETA(DisplayName = "Blueprint Event"),
+	ServerRequest   UMETA(DisplayName = "Server Request Sent"),
+	ServerResponse  UMETA(DisplayName = "Server Response Received"),
+	UIDisplayed     UMETA(DisplayName = "UI Displayed"),
+	MAX             UMETA(Hidden)
+};
+
+/**
+ * Histograma de latência em buckets log2 (0.5 ms, 1 ms, 2 ms ... 16 s)
+ */
+struct FErosLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 16;
+
+	void Add(double Milliseconds);
+
+	// Limite superior do bucket que contém o percentil (0..1)
+	double GetPercentile(double Percentile) const;
+
+	static double GetBucketUpperBound(int32 Bucket);
+
+	uint32 Counts[NumBuckets] = {};
+	uint32 Num = 0;
+	double SumMs = 0.0;
+	double MaxMs = 0.0;
+};
+
+/**
+ * Mede o tempo do input até cada marco dos fluxos de interação (pick, evento BP, RPC, UI)
+ * - Um fluxo ativo por tipo; um novo input do mesmo tipo descarta o anterior como abandonado
+ * - UIDisplayed encerra o fluxo (ou CompleteInteractionFlow para fluxos sem UI)
+ * - Cada amostra vai para um contador do Unreal Insights e para os histogramas da sessão
+ * - Os histogramas são gravados em CSV (Saved/Profiling/ErosInteraction) no fim da sessão
+ *
+ * O controller marca todos os marcos dos fluxos que ele dispara:
+ * - Select: UI quando o menu de interação aparece
+ * - RequestPartner: ServerRequest no envio do RPC, ServerResponse e UI no ClientPartnerRequestAck
+ * - PrivateChat/ViewProfile: só cliente; UI quando o evento BP que abre a janela retorna
+ * Marcos sem amostra não entram no CSV.
+ */
+UCLASS()
+class EROSSOCIAL_API UErosInteractionLatencyTracker : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosInteractionLatencyTracker* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	/** Início do fluxo; InputCycles é o FPlatformTime::Cycles64 do input */
+	void BeginFlow(EErosInteractionFlow Flow, uint64 InputCycles);
+
+	/** Ignorado se o fluxo não está ativo (ex.: função chamada direto pelo Blueprint) */
+	void MarkStage(EErosInteractionFlow Flow, EErosInteractionStage Stage, uint64 Cycles);
+
+	UFUNCTION(BlueprintCallable, Category = "Interaction|Latency")
+	void MarkInteractionStage(EErosInteractionFlow Flow, EErosInteractionStage Stage);
+
+	UFUNCTION(BlueprintCallable, Category = "Interaction|Latency")
+	void CompleteInteractionFlow(EErosInteractionFlow Flow);
+
+	/** Encerra sem amostra de Total (o fluxo não vai chegar ao fim) e conta como abandonado */
+	void AbandonFlow(EErosInteractionFlow Flow);
+
+	/** Grava os histogramas da sessão; retorna false se não há amostras ou a escrita falhou */
+	bool WriteCsv() const;
+
+	void LogSummary() const;
+
+private:
+	static constexpr int32 NumFlows = static_cast<int32>(EErosInteractionFlow::MAX);
+	static constexpr int32 NumStages = static_cast<int32>(EErosInteractionStage::MAX);
+
+	struct FFlowState
+	{
+		bool bActive = false;
+		uint64 StartCycles = 0;
+		uint32 Abandoned = 0;
+
+		// Tempo desde o input até cada marco
+		FErosLatencyHistogram Stages[NumStages];
+		FErosLatencyHistogram Total;
+	};
+
+	void FinishFlow(EErosInteractionFlow Flow, uint64 Cycles);
+
+	FFlowState Flows[NumFlows];
+};
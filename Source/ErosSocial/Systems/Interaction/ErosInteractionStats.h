@@ -0,0 +1,10 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosInteractionStats.h
+// Grupo de stats de interação do ErosSocial ("stat ErosInteraction")
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("ErosSocial Interaction"), STATGROUP_ErosInteraction, STATCAT_Advanced);
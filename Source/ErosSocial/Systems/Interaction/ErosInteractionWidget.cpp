@@ -0,0 +1,97 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosInteractionWidget.cpp
+
+#include "Systems/Interaction/ErosInteractionWidget.h"
+#include "GameFramework/Pawn.h"
+
+void UErosInteractionWidget::SetTarget(AActor* NewTarget)
+{
+	if (Target.Get() == NewTarget)
+	{
+		return;
+	}
+
+	Target = NewTarget;
+	TimeSinceRefresh = 0.0f;
+
+	BP_OnTargetChanged(NewTarget);
+	RefreshFields();
+}
+
+void UErosInteractionWidget::ClearTarget()
+{
+	Target.Reset();
+}
+
+void UErosInteractionWidget::RefreshFields()
+{
+	// Alvo sem PlayerState (ainda não replicado ou não é jogador) aplica campos vazios
+	// para não deixar na tela o nome/status do alvo anterior
+	FErosInteractionTargetInfo NewInfo;
+	if (!GatherTargetInfo(NewInfo))
+	{
+		NewInfo = FErosInteractionTargetInfo();
+	}
+
+	const bool bForceAll = !bHasBoundInfo;
+	bHasBoundInfo = true;
+
+	if (bForceAll || NewInfo.CharacterName != BoundInfo.CharacterName)
+	{
+		BP_OnCharacterNameChanged(NewInfo.CharacterName);
+	}
+
+	if (bForceAll || NewInfo.Status != BoundInfo.Status)
+	{
+		BP_OnStatusChanged(NewInfo.Status);
+	}
+
+	if (bForceAll || NewInfo.bHasPartner != BoundInfo.bHasPartner || NewInfo.PartnerName != BoundInfo.PartnerName)
+	{
+		BP_OnPartnerChanged(NewInfo.bHasPartner, NewInfo.PartnerName);
+	}
+
+	if (bForceAll || NewInfo.bIsFriend != BoundInfo.bIsFriend)
+	{
+		BP_OnFriendshipChanged(NewInfo.bIsFriend);
+	}
+
+	BoundInfo = MoveTemp(NewInfo);
+}
+
+bool UErosInteractionWidget::GatherTargetInfo(FErosInteractionTargetInfo& OutInfo) const
+{
+	const APawn* TargetPawn = Cast<APawn>(Target.Get());
+	const AErosSocialPlayerState* TargetPS = TargetPawn ? TargetPawn->GetPlayerState<AErosSocialPlayerState>() : nullptr;
+	if (!TargetPS)
+	{
+		return false;
+	}
+
+	OutInfo.CharacterName = TargetPS->CharacterName;
+	OutInfo.Status = TargetPS->GetPlayerStatus();
+	OutInfo.bHasPartner = TargetPS->HasPartner();
+	OutInfo.PartnerName = TargetPS->GetPartnerName();
+
+	const AErosSocialPlayerState* LocalPS = GetOwningPlayerState<AErosSocialPlayerState>();
+	OutInfo.bIsFriend = LocalPS && LocalPS->IsFriend(TargetPS->UserID);
+
+	return true;
+}
+
+void UErosInteractionWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	if (!Target.IsValid())
+	{
+		return;
+	}
+
+	TimeSinceRefresh += InDeltaTime;
+	if (TimeSinceRefresh >= RefreshInterval)
+	{
+		TimeSinceRefresh = 0.0f;
+		RefreshFields();
+	}
+}
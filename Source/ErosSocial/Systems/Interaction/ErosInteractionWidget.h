@@ -0,0 +1,101 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosInteractionWidget.h
+// Base dos widgets de tooltip e menu de interação
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "ErosSocialPlayerState.h"
+#include "ErosInteractionWidget.generated.h"
+
+/**
+ * Campos do alvo mostrados pelos widgets de interação
+ */
+USTRUCT(BlueprintType)
+struct FErosInteractionTargetInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	FString CharacterName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	EPlayerStatus Status = EPlayerStatus::Online;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	bool bHasPartner = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	FString PartnerName;
+
+	// Amigo do jogador local
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	bool bIsFriend = false;
+};
+
+/**
+ * Widget de interação reaproveitável entre alvos (vem do pool do controller)
+ * SetTarget e o refresh periódico comparam os campos com os últimos aplicados
+ * e disparam só os eventos dos que mudaram; o Blueprint atualiza apenas os
+ * textos/ícones correspondentes em vez de reconstruir o widget.
+ */
+UCLASS(Abstract)
+class EROSSOCIAL_API UErosInteractionWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void SetTarget(AActor* NewTarget);
+
+	/** Chamado ao devolver o widget ao pool; mantém os campos para o diff do próximo alvo */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void ClearTarget();
+
+	/** Relê o PlayerState do alvo e aplica só o que mudou */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void RefreshFields();
+
+	UFUNCTION(BlueprintPure, Category = "Interaction")
+	AActor* GetTarget() const { return Target.Get(); }
+
+	UFUNCTION(BlueprintPure, Category = "Interaction")
+	const FErosInteractionTargetInfo& GetTargetInfo() const { return BoundInfo; }
+
+	// Intervalo do refresh enquanto visível (status/partner do alvo mudam pela replicação)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Interaction")
+	float RefreshInterval = 0.25f;
+
+protected:
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	// ========== EVENTOS DE BINDING ==========
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Interaction")
+	void BP_OnTargetChanged(AActor* NewTarget);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Interaction")
+	void BP_OnCharacterNameChanged(const FString& CharacterName);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Interaction")
+	void BP_OnStatusChanged(EPlayerStatus Status);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Interaction")
+	void BP_OnPartnerChanged(bool bHasPartner, const FString& PartnerName);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Interaction")
+	void BP_OnFriendshipChanged(bool bIsFriend);
+
+private:
+	bool GatherTargetInfo(FErosInteractionTargetInfo& OutInfo) const;
+
+	TWeakObjectPtr<AActor> Target;
+
+	FErosInteractionTargetInfo BoundInfo;
+
+	// Falso até o primeiro bind: força todos os eventos na primeira vez
+	bool bHasBoundInfo = false;
+
+	float TimeSinceRefresh = 0.0f;
+};
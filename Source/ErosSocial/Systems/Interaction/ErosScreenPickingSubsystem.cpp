@@ -0,0 +1,214 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosScreenPickingSubsystem.cpp
+
+#include "Systems/Interaction/ErosScreenPickingSubsystem.h"
+#include "Systems/Interaction/ErosInteractionStats.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+
+DECLARE_CYCLE_STAT(TEXT("Picking Rebuild"), STAT_ErosPicking_Rebuild, STATGROUP_ErosInteraction);
+DECLARE_CYCLE_STAT(TEXT("Picking Query"), STAT_ErosPicking_Query, STATGROUP_ErosInteraction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Picking Entries"), STAT_ErosPicking_Entries, STATGROUP_ErosInteraction);
+
+void UErosScreenPickingSubsystem::RebuildIfStale()
+{
+	if (BuiltFrame == GFrameCounter)
+	{
+		return;
+	}
+	BuiltFrame = GFrameCounter;
+
+	SCOPE_CYCLE_COUNTER(STAT_ErosPicking_Rebuild);
+
+	Entries.Reset();
+	for (TArray<int32>& Bin : Bins)
+	{
+		Bin.Reset();
+	}
+
+	ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	UWorld* World = LocalPlayer ? LocalPlayer->GetWorld() : nullptr;
+	APlayerController* PlayerController = World ? LocalPlayer->GetPlayerController(World) : nullptr;
+	if (!PlayerController || !LocalPlayer->ViewportClient)
+	{
+		return;
+	}
+
+	// Uma matriz de projeção por frame em vez de um ProjectWorldToScreen por ponto
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		return;
+	}
+
+	const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+	const FVector ViewOriginWorld = ProjectionData.ViewOrigin;
+
+	const int32 SafeBinSize = FMath::Max(BinSize, 8);
+	ViewOrigin = ViewRect.Min;
+	const int32 NewNumBinsX = FMath::DivideAndRoundUp(ViewRect.Width(), SafeBinSize);
+	const int32 NewNumBinsY = FMath::DivideAndRoundUp(ViewRect.Height(), SafeBinSize);
+	if (NewNumBinsX != NumBinsX || NewNumBinsY != NumBinsY)
+	{
+		NumBinsX = NewNumBinsX;
+		NumBinsY = NewNumBinsY;
+		Bins.SetNum(NumBinsX * NumBinsY);
+	}
+
+	const APawn* OwnPawn = PlayerController->GetPawn();
+
+	for (TActorIterator<ACharacter> It(World); It; ++It)
+	{
+		ACharacter* Character = *It;
+		if (Character == OwnPawn || Character->IsHidden())
+		{
+			continue;
+		}
+
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		if (!Capsule)
+		{
+			continue;
+		}
+
+		// Caixa da cápsula: 8 cantos projetados; qualquer canto atrás da câmera descarta o personagem
+		const FVector Center = Capsule->GetComponentLocation();
+		const float Radius = Capsule->GetScaledCapsuleRadius();
+		const FVector Extent(Radius, Radius, Capsule->GetScaledCapsuleHalfHeight());
+
+		FBox2D ScreenRect(ForceInit);
+		bool bInFront = true;
+		for (int32 Corner = 0; Corner < 8 && bInFront; ++Corner)
+		{
+			const FVector CornerLocation = Center + Extent * FVector(
+				(Corner & 1) ? 1.0f : -1.0f,
+				(Corner & 2) ? 1.0f : -1.0f,
+				(Corner & 4) ? 1.0f : -1.0f);
+
+			FVector2D ScreenPoint;
+			bInFront = FSceneView::ProjectWorldToScreen(CornerLocation, ViewRect, ViewProjectionMatrix, ScreenPoint);
+			ScreenRect += ScreenPoint;
+		}
+
+		if (!bInFront)
+		{
+			continue;
+		}
+
+		const int32 MinBinX = FMath::FloorToInt((ScreenRect.Min.X - ViewOrigin.X) / SafeBinSize);
+		const int32 MinBinY = FMath::FloorToInt((ScreenRect.Min.Y - ViewOrigin.Y) / SafeBinSize);
+		const int32 MaxBinX = FMath::FloorToInt((ScreenRect.Max.X - ViewOrigin.X) / SafeBinSize);
+		const int32 MaxBinY = FMath::FloorToInt((ScreenRect.Max.Y - ViewOrigin.Y) / SafeBinSize);
+		if (MaxBinX < 0 || MaxBinY < 0 || MinBinX >= NumBinsX || MinBinY >= NumBinsY)
+		{
+			// Fora do viewport
+			continue;
+		}
+
+		const float Depth = FVector::Dist(ViewOriginWorld, Center);
+		const int32 EntryIndex = Entries.Add({ Character, ScreenRect, Depth, FMath::Max(0.0f, Depth - Radius) });
+
+		for (int32 BinY = FMath::Max(MinBinY, 0); BinY <= FMath::Min(MaxBinY, NumBinsY - 1); ++BinY)
+		{
+			for (int32 BinX = FMath::Max(MinBinX, 0); BinX <= FMath::Min(MaxBinX, NumBinsX - 1); ++BinX)
+			{
+				Bins[BinY * NumBinsX + BinX].Add(EntryIndex);
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ErosPicking_Entries, Entries.Num());
+}
+
+void UErosScreenPickingSubsystem::GetCandidatesAt(const FVector2D& ScreenPosition, TArray<FErosScreenPickCandidate>& OutCandidates)
+{
+	OutCandidates.Reset();
+
+	RebuildIfStale();
+
+	SCOPE_CYCLE_COUNTER(STAT_ErosPicking_Query);
+
+	const int32 SafeBinSize = FMath::Max(BinSize, 8);
+	const int32 BinX = FMath::FloorToInt((ScreenPosition.X - ViewOrigin.X) / SafeBinSize);
+	const int32 BinY = FMath::FloorToInt((ScreenPosition.Y - ViewOrigin.Y) / SafeBinSize);
+	if (BinX < 0 || BinY < 0 || BinX >= NumBinsX || BinY >= NumBinsY)
+	{
+		return;
+	}
+
+	for (const int32 EntryIndex : Bins[BinY * NumBinsX + BinX])
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+		if (Entry.ScreenRect.IsInside(ScreenPosition) && Entry.Character.IsValid())
+		{
+			OutCandidates.Add({ Entry.Character, Entry.Depth, Entry.NearDepth });
+		}
+	}
+
+	OutCandidates.Sort([](const FErosScreenPickCandidate& A, const FErosScreenPickCandidate& B)
+	{
+		return A.Depth < B.Depth;
+	});
+}
+
+ACharacter* UErosScreenPickingSubsystem::PickCharacterAtScreenPosition(FVector2D ScreenPosition)
+{
+	TArray<FErosScreenPickCandidate> Candidates;
+	GetCandidatesAt(ScreenPosition, Candidates);
+	return Candidates.Num() > 0 ? Candidates[0].Character.Get() : nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+
+/**
+ * Mede reconstrução e consulta do grid com os personagens em tela
+ * Uso: Eros.Picking.Benchmark [Queries=10000]
+ */
+static void ErosPickingBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	UErosScreenPickingSubsystem* Picking = PlayerController ? ULocalPlayer::GetSubsystem<UErosScreenPickingSubsystem>(PlayerController->GetLocalPlayer()) : nullptr;
+	if (!Picking)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Eros.Picking.Benchmark - No local player"));
+		return;
+	}
+
+	const int32 NumQueries = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+	int32 ViewportX = 0;
+	int32 ViewportY = 0;
+	PlayerController->GetViewportSize(ViewportX, ViewportY);
+
+	Picking->Invalidate();
+	const double RebuildStart = FPlatformTime::Seconds();
+	TArray<FErosScreenPickCandidate> Candidates;
+	Picking->GetCandidatesAt(FVector2D::ZeroVector, Candidates);
+	const double RebuildSeconds = FPlatformTime::Seconds() - RebuildStart;
+
+	FRandomStream Random(1337);
+	int32 NumHits = 0;
+	const double QueryStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		Picking->GetCandidatesAt(FVector2D(Random.FRandRange(0.0f, ViewportX), Random.FRandRange(0.0f, ViewportY)), Candidates);
+		NumHits += Candidates.Num() > 0 ? 1 : 0;
+	}
+	const double QuerySeconds = FPlatformTime::Seconds() - QueryStart;
+
+	UE_LOG(LogTemp, Log, TEXT("Eros.Picking.Benchmark - %d characters on screen: rebuild %.1f us, query %.3f us avg (%d/%d hits)"),
+		Picking->GetNumEntries(), RebuildSeconds * 1e6, QuerySeconds * 1e6 / NumQueries, NumHits, NumQueries);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ErosPickingBenchmarkCmd(
+	TEXT("Eros.Picking.Benchmark"),
+	TEXT("Mede reconstrução e consulta do grid de picking em tela. Args: [Queries=10000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ErosPickingBenchmark));
@@ -0,0 +1,80 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosScreenPickingSubsystem.h
+// Índice em espaço de tela para picking de personagens pelo cursor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "ErosScreenPickingSubsystem.generated.h"
+
+class ACharacter;
+
+/**
+ * Personagem sob um ponto da tela
+ */
+struct FErosScreenPickCandidate
+{
+	TWeakObjectPtr<ACharacter> Character;
+
+	// Distância da câmera até o centro do personagem
+	float Depth = 0.0f;
+
+	// Distância da câmera até a frente da cápsula (usada contra o trace de oclusão)
+	float NearDepth = 0.0f;
+};
+
+/**
+ * Grid de bins em espaço de tela com os bounds projetados dos personagens
+ * - Reconstruído no máximo uma vez por frame, e só em frames com consulta
+ * - Consulta por ponto olha um único bin: microssegundos mesmo com centenas de avatares
+ * - Não sabe de oclusão: quem chama confirma com um trace (ver AErosSocialPlayerController)
+ */
+UCLASS()
+class EROSSOCIAL_API UErosScreenPickingSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Personagens cujo retângulo projetado contém o ponto, do mais próximo ao mais distante
+	 * ScreenPosition em pixels do viewport (mesmo espaço de GetMousePosition)
+	 */
+	void GetCandidatesAt(const FVector2D& ScreenPosition, TArray<FErosScreenPickCandidate>& OutCandidates);
+
+	/**
+	 * Personagem mais próximo da câmera sob o ponto (sem teste de oclusão)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	ACharacter* PickCharacterAtScreenPosition(FVector2D ScreenPosition);
+
+	/** Força a reconstrução na próxima consulta */
+	void Invalidate() { BuiltFrame = MAX_uint64; }
+
+	int32 GetNumEntries() const { return Entries.Num(); }
+
+	// Tamanho do bin em pixels
+	int32 BinSize = 64;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<ACharacter> Character;
+		FBox2D ScreenRect;
+		float Depth;
+		float NearDepth;
+	};
+
+	void RebuildIfStale();
+
+	uint64 BuiltFrame = MAX_uint64;
+
+	FIntPoint ViewOrigin = FIntPoint::ZeroValue;
+	int32 NumBinsX = 0;
+	int32 NumBinsY = 0;
+
+	TArray<FEntry> Entries;
+
+	// Índices em Entries por bin; as listas mantêm a memória entre frames
+	TArray<TArray<int32>> Bins;
+};
@@ -0,0 +1,297 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosNameplateSubsystem.cpp
+
+#include "Systems/Nameplates/ErosNameplateSubsystem.h"
+#include "Systems/Nameplates/SErosNameplateLayer.h"
+#include "Systems/Interaction/ErosInteractionStats.h"
+#include "Systems/Proximity/ErosProximitySubsystem.h"
+#include "ErosSocialCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/PlayerController.h"
+#include "Rendering/SlateRenderer.h"
+#include "SceneView.h"
+#include "Styling/CoreStyle.h"
+
+DECLARE_CYCLE_STAT(TEXT("Nameplates Gather"), STAT_ErosNameplates_Gather, STATGROUP_ErosInteraction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nameplates Drawn"), STAT_ErosNameplates_Drawn, STATGROUP_ErosInteraction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nameplates Text Rebuilds"), STAT_ErosNameplates_TextRebuilds, STATGROUP_ErosInteraction);
+
+void UErosNameplateSubsystem::Deinitialize()
+{
+	RemoveLayer();
+	TextCache.Reset();
+
+	Super::Deinitialize();
+}
+
+ETickableTickType UErosNameplateSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UErosNameplateSubsystem::IsTickable() const
+{
+	return bNameplatesVisible && FSlateApplication::IsInitialized();
+}
+
+TStatId UErosNameplateSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UErosNameplateSubsystem, STATGROUP_Tickables);
+}
+
+void UErosNameplateSubsystem::SetNameplatesVisible(bool bVisible)
+{
+	bNameplatesVisible = bVisible;
+	if (!bVisible)
+	{
+		DrawItems.Reset();
+		RemoveLayer();
+	}
+}
+
+void UErosNameplateSubsystem::Tick(float DeltaTime)
+{
+	EnsureLayer();
+	GatherNameplates();
+
+	if ((GFrameCounter % 600) == 0)
+	{
+		EvictStaleText();
+	}
+}
+
+void UErosNameplateSubsystem::EnsureLayer()
+{
+	ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	UGameViewportClient* ViewportClient = LocalPlayer ? LocalPlayer->ViewportClient.Get() : nullptr;
+	if (!ViewportClient)
+	{
+		return;
+	}
+
+	// Viagem de mapa limpa os widgets do viewport; recoloca a camada quando isso acontece
+	if (Layer.IsValid() && Layer->GetParentWidget().IsValid())
+	{
+		return;
+	}
+
+	if (!Layer.IsValid())
+	{
+		Layer = SNew(SErosNameplateLayer, this);
+
+		NameFont = FCoreStyle::GetDefaultFontStyle("Bold", NameFontSize);
+		StatusFont = FCoreStyle::GetDefaultFontStyle("Regular", StatusFontSize);
+	}
+
+	// Abaixo dos widgets UMG (tooltip usa 100, menu 99)
+	ViewportClient->AddViewportWidgetForPlayer(LocalPlayer, Layer.ToSharedRef(), -10);
+}
+
+void UErosNameplateSubsystem::RemoveLayer()
+{
+	if (!Layer.IsValid())
+	{
+		return;
+	}
+
+	ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	if (UGameViewportClient* ViewportClient = LocalPlayer ? LocalPlayer->ViewportClient.Get() : nullptr)
+	{
+		ViewportClient->RemoveViewportWidgetForPlayer(LocalPlayer, Layer.ToSharedRef());
+	}
+
+	Layer.Reset();
+}
+
+void UErosNameplateSubsystem::GatherNameplates()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosNameplates_Gather);
+
+	DrawItems.Reset();
+	Candidates.Reset();
+	PlacedRects.Reset();
+
+	ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	UWorld* World = LocalPlayer ? LocalPlayer->GetWorld() : nullptr;
+	APlayerController* PlayerController = World ? LocalPlayer->GetPlayerController(World) : nullptr;
+	UErosProximitySubsystem* Proximity = UErosProximitySubsystem::Get(World);
+	if (!PlayerController || !Proximity || !Layer.IsValid() || !LocalPlayer->ViewportClient)
+	{
+		return;
+	}
+
+	// Mesma projeção do picking: uma matriz por frame
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		return;
+	}
+
+	const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+	const FVector ViewOrigin = ProjectionData.ViewOrigin;
+
+	// Pixels do viewport -> unidades locais da camada (DPI)
+	const float LayerScale = Layer->GetTickSpaceGeometry().Scale;
+	const float InvLayerScale = LayerScale > UE_KINDA_SMALL_NUMBER ? 1.0f / LayerScale : 1.0f;
+
+	TArray<AErosSocialCharacter*> Nearby;
+	Proximity->QueryRadius(ViewOrigin, MaxDistance, Nearby, PlayerController->GetPawn());
+
+	const uint64 Frame = GFrameCounter;
+	const float FadeRange = FMath::Max(MaxDistance - FadeStartDistance, 1.0f);
+
+	for (AErosSocialCharacter* Character : Nearby)
+	{
+		const AErosSocialPlayerState* PlayerState = Character->GetPlayerState<AErosSocialPlayerState>();
+		if (!PlayerState || Character->IsHidden())
+		{
+			continue;
+		}
+
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		const float HalfHeight = Capsule ? Capsule->GetScaledCapsuleHalfHeight() : 88.0f;
+		const FVector Head = Character->GetActorLocation() + FVector(0.0f, 0.0f, HalfHeight + HeadOffset);
+
+		FVector2D ScreenPoint;
+		if (!FSceneView::ProjectWorldToScreen(Head, ViewRect, ViewProjectionMatrix, ScreenPoint))
+		{
+			continue;
+		}
+
+		const FVector2D Anchor = (ScreenPoint - FVector2D(ViewRect.Min)) * InvLayerScale;
+		if (Anchor.X < 0.0f || Anchor.Y < 0.0f || Anchor.X > ViewRect.Width() * InvLayerScale || Anchor.Y > ViewRect.Height() * InvLayerScale)
+		{
+			continue;
+		}
+
+		GetCachedText(PlayerState).LastUsedFrame = Frame;
+
+		Candidates.Add({ PlayerState, Anchor, FVector::Dist(ViewOrigin, Head) });
+	}
+
+	// Mais próximos primeiro: ganham o declutter e entram no limite
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B)
+	{
+		return A.Distance < B.Distance;
+	});
+
+	const int32 MaxItems = FMath::Min(Candidates.Num(), MaxNameplates);
+	DrawItems.Reserve(MaxItems);
+
+	for (const FCandidate& Candidate : Candidates)
+	{
+		if (DrawItems.Num() >= MaxItems)
+		{
+			break;
+		}
+
+		const FCachedText& Text = TextCache.FindChecked(Candidate.PlayerState);
+		const FVector2D BlockSize(FMath::Max(Text.NameSize.X, Text.StatusSize.X), Text.NameSize.Y + Text.StatusSize.Y);
+
+		// Bloco centrado no X da âncora, com a base nela
+		FBox2D Rect(Candidate.Anchor - FVector2D(BlockSize.X * 0.5f, BlockSize.Y), Candidate.Anchor + FVector2D(BlockSize.X * 0.5f, 0.0f));
+
+		bool bPlaced = false;
+		for (int32 Shift = 0; Shift <= MaxDeclutterShifts; ++Shift)
+		{
+			const FBox2D* Overlap = PlacedRects.FindByPredicate([&Rect](const FBox2D& Placed)
+			{
+				return Placed.Intersect(Rect);
+			});
+
+			if (!Overlap)
+			{
+				bPlaced = true;
+				break;
+			}
+
+			// Sobe até logo acima da nameplate que está no caminho
+			const float Offset = Rect.Max.Y - Overlap->Min.Y + 2.0f;
+			Rect.Min.Y -= Offset;
+			Rect.Max.Y -= Offset;
+		}
+
+		if (!bPlaced)
+		{
+			continue;
+		}
+
+		PlacedRects.Add(Rect);
+
+		FErosNameplateDrawItem& Item = DrawItems.AddDefaulted_GetRef();
+		Item.Name = Text.Name;
+		Item.Status = Text.Status;
+		Item.NamePosition = FVector2D(Rect.GetCenter().X - Text.NameSize.X * 0.5f, Rect.Min.Y);
+		Item.StatusPosition = FVector2D(Rect.GetCenter().X - Text.StatusSize.X * 0.5f, Rect.Min.Y + Text.NameSize.Y);
+		Item.StatusColor = GetStatusColor(Text.SourceStatus);
+		Item.Alpha = 1.0f - FMath::Clamp((Candidate.Distance - FadeStartDistance) / FadeRange, 0.0f, 1.0f);
+	}
+
+	SET_DWORD_STAT(STAT_ErosNameplates_Drawn, DrawItems.Num());
+}
+
+UErosNameplateSubsystem::FCachedText& UErosNameplateSubsystem::GetCachedText(const AErosSocialPlayerState* PlayerState)
+{
+	FCachedText& Text = TextCache.FindOrAdd(PlayerState);
+
+	const EPlayerStatus Status = PlayerState->GetPlayerStatus();
+	const bool bNameChanged = !Text.bBuilt || !Text.SourceName.Equals(PlayerState->CharacterName, ESearchCase::CaseSensitive);
+	const bool bStatusChanged = !Text.bBuilt || Text.SourceStatus != Status;
+	if (!bNameChanged && !bStatusChanged)
+	{
+		return Text;
+	}
+
+	INC_DWORD_STAT(STAT_ErosNameplates_TextRebuilds);
+
+	// Só aqui há formatação e medição de texto: quando nome ou status mudam
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+
+	if (bNameChanged)
+	{
+		Text.SourceName = PlayerState->CharacterName;
+		Text.Name = FText::FromString(Text.SourceName);
+		Text.NameSize = FontMeasure->Measure(Text.Name, NameFont);
+	}
+
+	if (bStatusChanged)
+	{
+		Text.SourceStatus = Status;
+		Text.Status = FText::FromString(PlayerState->GetStatusAsString());
+		Text.StatusSize = FontMeasure->Measure(Text.Status, StatusFont);
+	}
+
+	Text.bBuilt = true;
+
+	return Text;
+}
+
+void UErosNameplateSubsystem::EvictStaleText()
+{
+	const uint64 Frame = GFrameCounter;
+	for (auto It = TextCache.CreateIterator(); It; ++It)
+	{
+		if (Frame - It.Value().LastUsedFrame > 300)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+FLinearColor UErosNameplateSubsystem::GetStatusColor(EPlayerStatus Status)
+{
+	switch (Status)
+	{
+	case EPlayerStatus::Online:    return FLinearColor(0.4f, 1.0f, 0.4f);
+	case EPlayerStatus::Busy:      return FLinearColor(1.0f, 0.4f, 0.4f);
+	case EPlayerStatus::InPartner: return FLinearColor(1.0f, 0.5f, 0.8f);
+	case EPlayerStatus::AFK:       return FLinearColor(0.7f, 0.7f, 0.7f);
+	default:                       return FLinearColor::White;
+	}
+}
@@ -0,0 +1,137 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosNameplateSubsystem.h
+// Nameplates (nome + status) de todos os jogadores visíveis num único elemento Slate
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
+#include "Fonts/SlateFontInfo.h"
+#include "ErosSocialPlayerState.h"
+#include "ErosNameplateSubsystem.generated.h"
+
+class SErosNameplateLayer;
+
+/**
+ * Uma nameplate pronta para desenhar (coordenadas locais da camada, já sem sobreposição)
+ */
+struct FErosNameplateDrawItem
+{
+	FText Name;
+	FText Status;
+
+	// Canto superior esquerdo de cada linha
+	FVector2D NamePosition = FVector2D::ZeroVector;
+	FVector2D StatusPosition = FVector2D::ZeroVector;
+
+	FLinearColor StatusColor = FLinearColor::White;
+	float Alpha = 1.0f;
+};
+
+/**
+ * Nameplates em lote
+ * - Uma única camada Slate no viewport do jogador desenha todas as nameplates numa passada
+ * - Candidatos vêm do UErosProximitySubsystem (raio MaxDistance em volta da câmera)
+ * - Textos ficam em cache por PlayerState e só são refeitos quando nome/status mudam
+ * - Fade por distância e declutter em espaço de tela (os mais próximos têm prioridade)
+ */
+UCLASS(config = Game)
+class EROSSOCIAL_API UErosNameplateSubsystem : public ULocalPlayerSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	UFUNCTION(BlueprintCallable, Category = "Nameplates")
+	void SetNameplatesVisible(bool bVisible);
+
+	UFUNCTION(BlueprintPure, Category = "Nameplates")
+	bool AreNameplatesVisible() const { return bNameplatesVisible; }
+
+	UFUNCTION(BlueprintPure, Category = "Nameplates")
+	int32 GetNumVisibleNameplates() const { return DrawItems.Num(); }
+
+	const TArray<FErosNameplateDrawItem>& GetDrawItems() const { return DrawItems; }
+	const FSlateFontInfo& GetNameFont() const { return NameFont; }
+	const FSlateFontInfo& GetStatusFont() const { return StatusFont; }
+
+	// ========== CONFIGURAÇÃO (DefaultGame.ini) ==========
+
+	// Além disso a nameplate não aparece
+	UPROPERTY(Config)
+	float MaxDistance = 3000.0f;
+
+	// A partir daqui a nameplate começa a sumir
+	UPROPERTY(Config)
+	float FadeStartDistance = 2000.0f;
+
+	// Limite de nameplates desenhadas (as mais próximas)
+	UPROPERTY(Config)
+	int32 MaxNameplates = 128;
+
+	// Altura acima da cabeça (topo da cápsula)
+	UPROPERTY(Config)
+	float HeadOffset = 30.0f;
+
+	// Quantas vezes uma nameplate sobreposta sobe antes de ser descartada
+	UPROPERTY(Config)
+	int32 MaxDeclutterShifts = 3;
+
+	UPROPERTY(Config)
+	int32 NameFontSize = 12;
+
+	UPROPERTY(Config)
+	int32 StatusFontSize = 9;
+
+private:
+	struct FCachedText
+	{
+		FString SourceName;
+		EPlayerStatus SourceStatus = EPlayerStatus::Online;
+		FText Name;
+		FText Status;
+		FVector2D NameSize = FVector2D::ZeroVector;
+		FVector2D StatusSize = FVector2D::ZeroVector;
+		uint64 LastUsedFrame = 0;
+		bool bBuilt = false;
+	};
+
+	struct FCandidate
+	{
+		TObjectKey<AErosSocialPlayerState> PlayerState;
+		FVector2D Anchor;
+		float Distance;
+	};
+
+	void EnsureLayer();
+	void RemoveLayer();
+	void GatherNameplates();
+	FCachedText& GetCachedText(const AErosSocialPlayerState* PlayerState);
+	void EvictStaleText();
+
+	static FLinearColor GetStatusColor(EPlayerStatus Status);
+
+	bool bNameplatesVisible = true;
+
+	TSharedPtr<SErosNameplateLayer> Layer;
+
+	FSlateFontInfo NameFont;
+	FSlateFontInfo StatusFont;
+
+	TMap<TObjectKey<AErosSocialPlayerState>, FCachedText> TextCache;
+
+	// Reaproveitados a cada frame
+	TArray<FCandidate> Candidates;
+	TArray<FBox2D> PlacedRects;
+	TArray<FErosNameplateDrawItem> DrawItems;
+};
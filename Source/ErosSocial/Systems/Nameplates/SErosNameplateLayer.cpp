@@ -0,0 +1,52 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// SErosNameplateLayer.cpp
+
+#include "Systems/Nameplates/SErosNameplateLayer.h"
+#include "Systems/Nameplates/ErosNameplateSubsystem.h"
+#include "Rendering/DrawElements.h"
+
+void SErosNameplateLayer::Construct(const FArguments& InArgs, UErosNameplateSubsystem* InSubsystem)
+{
+	Subsystem = InSubsystem;
+	SetVisibility(EVisibility::HitTestInvisible);
+}
+
+int32 SErosNameplateLayer::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const UErosNameplateSubsystem* Nameplates = Subsystem.Get();
+	if (!Nameplates)
+	{
+		return LayerId;
+	}
+
+	const FSlateFontInfo& NameFont = Nameplates->GetNameFont();
+	const FSlateFontInfo& StatusFont = Nameplates->GetStatusFont();
+	const FLinearColor ShadowColor(0.0f, 0.0f, 0.0f, 0.75f);
+	const FVector2D ShadowOffset(1.0f, 1.0f);
+
+	// Sombras numa camada e textos na seguinte: o batcher junta tudo em poucos draw calls
+	const int32 ShadowLayer = LayerId;
+	const int32 TextLayer = LayerId + 1;
+
+	for (const FErosNameplateDrawItem& Item : Nameplates->GetDrawItems())
+	{
+		const FLinearColor Fade(1.0f, 1.0f, 1.0f, Item.Alpha);
+
+		FSlateDrawElement::MakeText(OutDrawElements, ShadowLayer,
+			AllottedGeometry.ToPaintGeometry(FSlateLayoutTransform(Item.NamePosition + ShadowOffset)),
+			Item.Name, NameFont, ESlateDrawEffect::None, ShadowColor * Fade);
+		FSlateDrawElement::MakeText(OutDrawElements, TextLayer,
+			AllottedGeometry.ToPaintGeometry(FSlateLayoutTransform(Item.NamePosition)),
+			Item.Name, NameFont, ESlateDrawEffect::None, FLinearColor::White * Fade);
+
+		FSlateDrawElement::MakeText(OutDrawElements, ShadowLayer,
+			AllottedGeometry.ToPaintGeometry(FSlateLayoutTransform(Item.StatusPosition + ShadowOffset)),
+			Item.Status, StatusFont, ESlateDrawEffect::None, ShadowColor * Fade);
+		FSlateDrawElement::MakeText(OutDrawElements, TextLayer,
+			AllottedGeometry.ToPaintGeometry(FSlateLayoutTransform(Item.StatusPosition)),
+			Item.Status, StatusFont, ESlateDrawEffect::None, Item.StatusColor * Fade);
+	}
+
+	return TextLayer;
+}
@@ -0,0 +1,31 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// SErosNameplateLayer.h
+// Camada Slate que desenha as nameplates do UErosNameplateSubsystem
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+class UErosNameplateSubsystem;
+
+/**
+ * Widget folha em tela cheia, sem hit test
+ * Não tem estado próprio: cada OnPaint desenha os itens preparados pelo subsistema no Tick
+ */
+class EROSSOCIAL_API SErosNameplateLayer : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SErosNameplateLayer) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UErosNameplateSubsystem* InSubsystem);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override { return FVector2D::ZeroVector; }
+
+private:
+	TWeakObjectPtr<UErosNameplateSubsystem> Subsystem;
+};
@@ -0,0 +1,171 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosNetBenchCommandlet.cpp
+
+#include "Systems/Network/ErosNetBenchCommandlet.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+namespace ErosNetBenchCommandlet
+{
+	static FProcHandle Launch(const FString& Arguments)
+	{
+		const FString Executable = FPlatformProcess::ExecutablePath();
+		UE_LOG(LogTemp, Log, TEXT("UErosNetBenchCommandlet - %s %s"), *Executable, *Arguments);
+		return FPlatformProcess::CreateProc(*Executable, *Arguments, false, true, true, nullptr, 0, nullptr, nullptr);
+	}
+
+	static void Terminate(FProcHandle& Handle)
+	{
+		if (Handle.IsValid())
+		{
+			if (FPlatformProcess::IsProcRunning(Handle))
+			{
+				FPlatformProcess::TerminateProc(Handle, true);
+			}
+			FPlatformProcess::CloseProc(Handle);
+		}
+	}
+}
+
+UErosNetBenchCommandlet::UErosNetBenchCommandlet()
+{
+	// Só orquestra processos: não carrega mundo nem conteúdo
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UErosNetBenchCommandlet::Main(const FString& Params)
+{
+	int32 NumClients = 16;
+	float Seconds = 60.0f;
+	int32 Port = 17777;
+	float ServerWarmupSeconds = 15.0f;
+	float StartupTimeoutSeconds = 180.0f;
+	FString Map;
+	FString OutputDir;
+
+	FParse::Value(*Params, TEXT("Clients="), NumClients);
+	FParse::Value(*Params, TEXT("Seconds="), Seconds);
+	FParse::Value(*Params, TEXT("Port="), Port);
+	FParse::Value(*Params, TEXT("ServerWarmup="), ServerWarmupSeconds);
+	FParse::Value(*Params, TEXT("StartupTimeout="), StartupTimeoutSeconds);
+	FParse::Value(*Params, TEXT("Map="), Map);
+	FParse::Value(*Params, TEXT("Output="), OutputDir);
+
+	NumClients = FMath::Max(NumClients, 1);
+	if (Seconds <= 0.0f)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UErosNetBenchCommandlet::Main - Seconds must be > 0 (the server exits when the run ends)"));
+		return 1;
+	}
+
+	if (OutputDir.IsEmpty())
+	{
+		OutputDir = FPaths::ProfilingDir() / TEXT("ErosNet") / FString::Printf(TEXT("Run_%s"), *FDateTime::Now().ToString());
+	}
+	OutputDir = FPaths::ConvertRelativePathToFull(OutputDir);
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	const FString CsvPath = OutputDir / TEXT("ErosNetBench.csv");
+	IFileManager::Get().Delete(*CsvPath, false, true, true);
+
+	// ========== SERVIDOR ==========
+
+	const FString ServerArgs = FString::Printf(
+		TEXT("\"%s\" %s -server -nullrhi -nosound -unattended -nopause -log -port=%d -ErosNetBench -ErosNetBenchClients=%d -ErosNetBenchSeconds=%g -ErosNetBenchCsv=\"%s\" -abslog=\"%s\""),
+		*ProjectPath, *Map, Port, NumClients, Seconds, *CsvPath, *(OutputDir / TEXT("Server.log")));
+
+	FProcHandle Server = ErosNetBenchCommandlet::Launch(ServerArgs);
+	if (!Server.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("UErosNetBenchCommandlet::Main - Failed to launch the server"));
+		return 1;
+	}
+
+	// O servidor precisa estar ouvindo antes dos clientes tentarem conectar
+	const double WarmupEnd = FPlatformTime::Seconds() + ServerWarmupSeconds;
+	while (FPlatformTime::Seconds() < WarmupEnd && FPlatformProcess::IsProcRunning(Server))
+	{
+		FPlatformProcess::Sleep(0.5f);
+	}
+
+	if (!FPlatformProcess::IsProcRunning(Server))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UErosNetBenchCommandlet::Main - Server exited during startup (see %s)"), *(OutputDir / TEXT("Server.log")));
+		FPlatformProcess::CloseProc(Server);
+		return 1;
+	}
+
+	// ========== CLIENTES ==========
+
+	TArray<FProcHandle> Clients;
+	Clients.Reserve(NumClients);
+
+	for (int32 ClientIndex = 0; ClientIndex < NumClients; ++ClientIndex)
+	{
+		const FString ClientArgs = FString::Printf(
+			TEXT("\"%s\" 127.0.0.1:%d -game -nullrhi -nosound -unattended -nopause -log -ErosNetBench -abslog=\"%s\""),
+			*ProjectPath, Port, *(OutputDir / FString::Printf(TEXT("Client_%02d.log"), ClientIndex)));
+
+		FProcHandle Client = ErosNetBenchCommandlet::Launch(ClientArgs);
+		if (!Client.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("UErosNetBenchCommandlet::Main - Failed to launch client %d"), ClientIndex);
+			continue;
+		}
+		Clients.Add(Client);
+
+		// Espaça as conexões: N clientes abrindo o mapa ao mesmo tempo dominam a máquina
+		FPlatformProcess::Sleep(0.5f);
+	}
+
+	// ========== ESPERA ==========
+
+	// O servidor só começa a contar Seconds quando todos os clientes entraram
+	const double Deadline = FPlatformTime::Seconds() + StartupTimeoutSeconds + Seconds;
+	bool bTimedOut = false;
+
+	while (FPlatformProcess::IsProcRunning(Server))
+	{
+		if (FPlatformTime::Seconds() > Deadline)
+		{
+			bTimedOut = true;
+			break;
+		}
+		FPlatformProcess::Sleep(1.0f);
+	}
+
+	int32 ServerReturnCode = 0;
+	if (!bTimedOut)
+	{
+		FPlatformProcess::GetProcReturnCode(Server, &ServerReturnCode);
+	}
+
+	ErosNetBenchCommandlet::Terminate(Server);
+	for (FProcHandle& Client : Clients)
+	{
+		ErosNetBenchCommandlet::Terminate(Client);
+	}
+
+	if (bTimedOut)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UErosNetBenchCommandlet::Main - Timed out after %.0fs (did all %d clients connect? see %s)"),
+			StartupTimeoutSeconds + Seconds, NumClients, *OutputDir);
+		return 1;
+	}
+
+	if (!IFileManager::Get().FileExists(*CsvPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UErosNetBenchCommandlet::Main - Server exited (code %d) without writing %s"), ServerReturnCode, *CsvPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UErosNetBenchCommandlet::Main - %d clients, %.0fs: %s"), Clients.Num(), Seconds, *CsvPath);
+	return 0;
+}
@@ -0,0 +1,32 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosNetBenchCommandlet.h
+// Execução automática do benchmark de replicação (servidor dedicado + clientes headless)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ErosNetBenchCommandlet.generated.h"
+
+/**
+ * Sobe o benchmark inteiro na máquina local e espera terminar
+ *   UnrealEditor-Cmd ErosSocial.uproject -run=ErosNetBench -Clients=16 -Seconds=60
+ *     [-Map=/Game/...] [-Port=17777] [-ServerWarmup=15] [-StartupTimeout=180] [-Output=<pasta>]
+ *
+ * - Servidor: -server -nullrhi -ErosNetBench (UErosNetBenchmark inicia quando os N clientes entram)
+ * - Clientes: N processos -game -nullrhi -nosound conectando em 127.0.0.1
+ * - Espera o servidor gravar o CSV e sair; encerra os clientes que sobrarem
+ * - Saída em Saved/Profiling/ErosNet/Run_<data> (ou -Output): ErosNetBench.csv + logs de cada processo
+ *
+ * Retorna 0 com o CSV gravado; diferente de 0 em timeout, falha ao iniciar processos ou CSV ausente.
+ */
+UCLASS()
+class EROSSOCIAL_API UErosNetBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UErosNetBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
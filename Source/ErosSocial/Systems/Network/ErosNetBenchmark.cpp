@@ -0,0 +1,633 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosNetBenchmark.cpp
+
+#include "Systems/Network/ErosNetBenchmark.h"
+#include "Systems/Network/ErosSocialReplicationGraph.h"
+#include "ErosSocialPlayerState.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/BitWriter.h"
+#include "UObject/UnrealType.h"
+
+namespace ErosNetBenchmark
+{
+	// Referências a objetos viram NetGUID (packed int); estimamos em vez de serializar
+	// para não mexer no package map de uma conexão real
+	static constexpr int64 ObjectReferenceBits = 32;
+
+	static int64 MeasurePropertyBits(const FProperty* Property, const void* Value)
+	{
+		if (Property->IsA<FObjectPropertyBase>())
+		{
+			return ObjectReferenceBits;
+		}
+
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			// Contagem de elementos + cada elemento
+			FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+			int64 Bits = 16;
+			for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+			{
+				Bits += MeasurePropertyBits(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index));
+			}
+			return Bits;
+		}
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			// Structs sem NetSerialize próprio são replicadas campo a campo
+			if (!(StructProperty->Struct->StructFlags & STRUCT_NetSerializeNative))
+			{
+				int64 Bits = 0;
+				for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+				{
+					if (It->HasAnyPropertyFlags(CPF_RepSkip))
+					{
+						continue;
+					}
+
+					for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+					{
+						Bits += MeasurePropertyBits(*It, It->ContainerPtrToValuePtr<void>(Value, Index));
+					}
+				}
+				return Bits;
+			}
+		}
+
+		FNetBitWriter Writer(nullptr, 256);
+		const_cast<FProperty*>(Property)->NetSerializeItem(Writer, nullptr, const_cast<void*>(Value));
+		return Writer.GetNumBits();
+	}
+
+	static float Percentile(TArray<float> Samples, float Percent)
+	{
+		if (Samples.Num() == 0)
+		{
+			return 0.0f;
+		}
+
+		Samples.Sort();
+		const int32 Index = FMath::Clamp(FMath::FloorToInt(Samples.Num() * Percent / 100.0f), 0, Samples.Num() - 1);
+		return Samples[Index];
+	}
+}
+
+UErosNetBenchmark* UErosNetBenchmark::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosNetBenchmark>() : nullptr;
+}
+
+bool UErosNetBenchmark::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UErosNetBenchmark::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	if (FParse::Param(CommandLine, TEXT("ErosNetBench")))
+	{
+		// Cliente anda sozinho; servidor inicia quando os clientes chegarem
+		bClientMovement = true;
+		bAutoStart = true;
+		FParse::Value(CommandLine, TEXT("ErosNetBenchClients="), AutoStartClients);
+		FParse::Value(CommandLine, TEXT("ErosNetBenchSeconds="), AutoStartSeconds);
+		FParse::Value(CommandLine, TEXT("ErosNetBenchCsv="), OutputCsvPath);
+	}
+
+	int32 Seed = 1337;
+	FParse::Value(CommandLine, TEXT("ErosNetBenchSeed="), Seed);
+	Random.Initialize(Seed);
+}
+
+void UErosNetBenchmark::Deinitialize()
+{
+	ReleaseTrackedActors();
+
+	Super::Deinitialize();
+}
+
+TStatId UErosNetBenchmark::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UErosNetBenchmark, STATGROUP_Tickables);
+}
+
+void UErosNetBenchmark::Tick(float DeltaTime)
+{
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+
+	if (NetMode == NM_Client)
+	{
+		if (bClientMovement)
+		{
+			TickClientMovement(DeltaTime);
+		}
+		return;
+	}
+
+	if (NetMode != NM_Standalone)
+	{
+		TickServer(DeltaTime);
+	}
+}
+
+// ========== SERVIDOR ==========
+
+void UErosNetBenchmark::StartBenchmark(float Seconds, bool bInExitWhenDone)
+{
+	ReleaseTrackedActors();
+	TrackedClasses.Reset();
+	NetTickMs.Reset();
+	ClientOutBytesPerSecond.Reset();
+
+	Duration = Seconds;
+	bExitWhenDone = bInExitWhenDone;
+	ElapsedTime = 0.0f;
+	TimeUntilScript = 1.0f;
+	TimeUntilBandwidthSample = 1.0f;
+	MaxPlayers = 0;
+	NumStatusChanges = 0;
+	NumFriendChanges = 0;
+	NumPartnerChanges = 0;
+
+	// Clientes sem login não têm UserID; amizades e partner precisam de um
+	for (AErosSocialPlayerState* ErosPlayerState : GetBenchPlayers())
+	{
+		if (!ErosPlayerState->UserID.IsValid())
+		{
+			ErosPlayerState->UserID = FErosUserId::FromString(FString::Printf(TEXT("netbench_%d"), ErosPlayerState->GetPlayerId()));
+		}
+	}
+
+	bRunning = true;
+
+	UE_LOG(LogTemp, Log, TEXT("UErosNetBenchmark::StartBenchmark - Running for %.0fs with %d players"),
+		Seconds, GetBenchPlayers().Num());
+}
+
+void UErosNetBenchmark::StopBenchmark()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+	WriteCsv();
+	ReleaseTrackedActors();
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void UErosNetBenchmark::TickServer(float DeltaTime)
+{
+	if (!bRunning)
+	{
+		if (bAutoStart && GetBenchPlayers().Num() >= AutoStartClients)
+		{
+			bAutoStart = false;
+			StartBenchmark(AutoStartSeconds, true);
+		}
+		return;
+	}
+
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver)
+	{
+		return;
+	}
+
+	ElapsedTime += DeltaTime;
+
+	// O flush de rede roda depois do tick do mundo: aqui lemos o frame anterior
+	if (const UErosSocialReplicationGraph* Graph = Cast<UErosSocialReplicationGraph>(NetDriver->GetReplicationDriver()))
+	{
+		NetTickMs.Add(static_cast<float>(Graph->GetLastReplicateActorsMs()));
+	}
+
+	TimeUntilBandwidthSample -= DeltaTime;
+	if (TimeUntilBandwidthSample <= 0.0f)
+	{
+		TimeUntilBandwidthSample = 1.0f;
+		for (const UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			if (Connection)
+			{
+				ClientOutBytesPerSecond.Add(Connection->OutBytesPerSecond);
+			}
+		}
+	}
+
+	TimeUntilScript -= DeltaTime;
+	if (TimeUntilScript <= 0.0f)
+	{
+		TimeUntilScript = 1.0f;
+		RunScriptedActions();
+	}
+
+	SampleReplicatedProperties();
+
+	if (Duration > 0.0f && ElapsedTime >= Duration)
+	{
+		StopBenchmark();
+	}
+}
+
+TArray<AErosSocialPlayerState*> UErosNetBenchmark::GetBenchPlayers() const
+{
+	TArray<AErosSocialPlayerState*> Players;
+
+	if (const AGameStateBase* GameState = GetWorld()->GetGameState())
+	{
+		for (APlayerState* PlayerState : GameState->PlayerArray)
+		{
+			if (AErosSocialPlayerState* ErosPlayerState = Cast<AErosSocialPlayerState>(PlayerState))
+			{
+				Players.Add(ErosPlayerState);
+			}
+		}
+	}
+
+	return Players;
+}
+
+void UErosNetBenchmark::RunScriptedActions()
+{
+	TArray<AErosSocialPlayerState*> Players = GetBenchPlayers();
+	MaxPlayers = FMath::Max(MaxPlayers, Players.Num());
+
+	const int32 NumPlayers = Players.Num();
+	if (NumPlayers == 0)
+	{
+		return;
+	}
+
+	// Status: cerca de 1/4 dos jogadores por segundo alternam Online/Busy
+	const int32 NumStatus = FMath::Max(1, NumPlayers / 4);
+	for (int32 Index = 0; Index < NumStatus; ++Index)
+	{
+		AErosSocialPlayerState* Player = Players[Random.RandRange(0, NumPlayers - 1)];
+		if (!Player->bHasPartner)
+		{
+			Player->SetPlayerStatus(Player->PlayerStatus == EPlayerStatus::Online ? EPlayerStatus::Busy : EPlayerStatus::Online);
+			++NumStatusChanges;
+		}
+	}
+
+	if (NumPlayers < 2)
+	{
+		return;
+	}
+
+	// Amizade: um par por segundo (adiciona ou desfaz)
+	{
+		const int32 IndexA = Random.RandRange(0, NumPlayers - 1);
+		const int32 IndexB = (IndexA + Random.RandRange(1, NumPlayers - 1)) % NumPlayers;
+		AErosSocialPlayerState* PlayerA = Players[IndexA];
+		AErosSocialPlayerState* PlayerB = Players[IndexB];
+
+		if (PlayerA->IsFriend(PlayerB->UserID))
+		{
+			PlayerA->RemoveFriend(PlayerB->UserID);
+			PlayerB->RemoveFriend(PlayerA->UserID);
+		}
+		else
+		{
+			PlayerA->AddFriend(PlayerB->UserID);
+			PlayerB->AddFriend(PlayerA->UserID);
+		}
+		++NumFriendChanges;
+	}
+
+	// Partner: forma ou desfaz um par por segundo
+	{
+		const int32 IndexA = Random.RandRange(0, NumPlayers - 1);
+		const int32 IndexB = (IndexA + Random.RandRange(1, NumPlayers - 1)) % NumPlayers;
+		AErosSocialPlayerState* PlayerA = Players[IndexA];
+		AErosSocialPlayerState* PlayerB = Players[IndexB];
+
+		if (PlayerA->bHasPartner)
+		{
+			AErosSocialPlayerState* OldPartner = PlayerA->GetPartner();
+			PlayerA->RemovePartner();
+			if (OldPartner)
+			{
+				OldPartner->RemovePartner();
+			}
+			++NumPartnerChanges;
+		}
+		else if (!PlayerB->bHasPartner)
+		{
+			PlayerA->SetPartner(PlayerB);
+			PlayerB->SetPartner(PlayerA);
+			++NumPartnerChanges;
+		}
+	}
+}
+
+void UErosNetBenchmark::SampleReplicatedProperties()
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver || NetDriver->ClientConnections.Num() == 0)
+	{
+		return;
+	}
+
+	for (AErosSocialPlayerState* ErosPlayerState : GetBenchPlayers())
+	{
+		TrackActor(ErosPlayerState);
+		TrackActor(ErosPlayerState->GetPawn());
+	}
+
+	for (auto It = TrackedActors.CreateIterator(); It; ++It)
+	{
+		FTrackedActor& Tracked = It.Value();
+		FTrackedClass& ClassInfo = TrackedClasses[Tracked.ClassIndex];
+
+		AActor* Actor = Tracked.Actor.Get();
+		if (!Actor)
+		{
+			ReleaseShadow(Tracked);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// Conexões que têm canal aberto para esse ator
+		int32 NumReceivers = 0;
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			if (Connection && Connection->FindActorChannelRef(Actor))
+			{
+				++NumReceivers;
+			}
+		}
+
+		for (int32 PropertyIndex = 0; PropertyIndex < ClassInfo.Properties.Num(); ++PropertyIndex)
+		{
+			const FProperty* Property = ClassInfo.Properties[PropertyIndex];
+			uint8* ShadowValue = Tracked.Shadow + ClassInfo.ShadowOffsets[PropertyIndex];
+
+			int64 ChangedBits = 0;
+			for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+			{
+				const void* Value = Property->ContainerPtrToValuePtr<void>(Actor, Index);
+				if (!Property->Identical(Value, ShadowValue + Index * Property->ElementSize))
+				{
+					ChangedBits += ErosNetBenchmark::MeasurePropertyBits(Property, Value);
+				}
+			}
+
+			if (ChangedBits == 0)
+			{
+				continue;
+			}
+
+			Property->CopyCompleteValue(ShadowValue, Property->ContainerPtrToValuePtr<void>(Actor));
+
+			if (NumReceivers > 0)
+			{
+				++ClassInfo.PropertyChanges[PropertyIndex];
+				ClassInfo.PropertyBits[PropertyIndex] += ChangedBits * NumReceivers;
+			}
+		}
+	}
+}
+
+int32 UErosNetBenchmark::FindOrAddTrackedClass(UClass* Class)
+{
+	const int32 ExistingIndex = TrackedClasses.IndexOfByPredicate([Class](const FTrackedClass& Info) { return Info.Class == Class; });
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	FTrackedClass& ClassInfo = TrackedClasses.AddDefaulted_GetRef();
+	ClassInfo.Class = Class;
+
+	int32 Offset = 0;
+	for (TFieldIterator<FProperty> It(Class); It; ++It)
+	{
+		FProperty* Property = *It;
+		if (!Property->HasAnyPropertyFlags(CPF_Net))
+		{
+			continue;
+		}
+
+		Offset = Align(Offset, Property->GetMinAlignment());
+		ClassInfo.Properties.Add(Property);
+		ClassInfo.ShadowOffsets.Add(Offset);
+		Offset += Property->GetSize();
+	}
+
+	ClassInfo.ShadowSize = Offset;
+	ClassInfo.PropertyChanges.SetNumZeroed(ClassInfo.Properties.Num());
+	ClassInfo.PropertyBits.SetNumZeroed(ClassInfo.Properties.Num());
+
+	return TrackedClasses.Num() - 1;
+}
+
+void UErosNetBenchmark::TrackActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	if (FTrackedActor* Existing = TrackedActors.Find(Actor))
+	{
+		if (Existing->Actor.Get() == Actor)
+		{
+			return;
+		}
+
+		// Endereço reaproveitado por outro ator
+		ReleaseShadow(*Existing);
+		TrackedActors.Remove(Actor);
+	}
+
+	const int32 ClassIndex = FindOrAddTrackedClass(Actor->GetClass());
+	const FTrackedClass& ClassInfo = TrackedClasses[ClassIndex];
+
+	FTrackedActor& Tracked = TrackedActors.Add(Actor);
+	Tracked.Actor = Actor;
+	Tracked.ClassIndex = ClassIndex;
+	Tracked.Shadow = static_cast<uint8*>(FMemory::Malloc(FMath::Max(ClassInfo.ShadowSize, 1), 16));
+
+	// A cópia inicial não conta: só mudanças a partir daqui
+	for (int32 PropertyIndex = 0; PropertyIndex < ClassInfo.Properties.Num(); ++PropertyIndex)
+	{
+		const FProperty* Property = ClassInfo.Properties[PropertyIndex];
+		uint8* ShadowValue = Tracked.Shadow + ClassInfo.ShadowOffsets[PropertyIndex];
+		Property->InitializeValue(ShadowValue);
+		Property->CopyCompleteValue(ShadowValue, Property->ContainerPtrToValuePtr<void>(Actor));
+	}
+}
+
+void UErosNetBenchmark::ReleaseTrackedActors()
+{
+	for (TPair<AActor*, FTrackedActor>& Pair : TrackedActors)
+	{
+		ReleaseShadow(Pair.Value);
+	}
+
+	TrackedActors.Reset();
+}
+
+void UErosNetBenchmark::ReleaseShadow(FTrackedActor& Tracked)
+{
+	const FTrackedClass& ClassInfo = TrackedClasses[Tracked.ClassIndex];
+	for (int32 PropertyIndex = 0; PropertyIndex < ClassInfo.Properties.Num(); ++PropertyIndex)
+	{
+		ClassInfo.Properties[PropertyIndex]->DestroyValue(Tracked.Shadow + ClassInfo.ShadowOffsets[PropertyIndex]);
+	}
+
+	FMemory::Free(Tracked.Shadow);
+	Tracked.Shadow = nullptr;
+}
+
+bool UErosNetBenchmark::WriteCsv() const
+{
+	const float Seconds = FMath::Max(ElapsedTime, KINDA_SMALL_NUMBER);
+	const int32 NumPlayers = FMath::Max(MaxPlayers, 1);
+
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Metric,Class,Property,Value"));
+
+	auto AddRow = [&Lines](const TCHAR* Metric, const FString& ClassName, const FString& PropertyName, double Value)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%s,%s,%.3f"), Metric, *ClassName, *PropertyName, Value));
+	};
+
+	AddRow(TEXT("DurationSeconds"), FString(), FString(), Seconds);
+	AddRow(TEXT("Players"), FString(), FString(), MaxPlayers);
+	AddRow(TEXT("StatusChanges"), FString(), FString(), NumStatusChanges);
+	AddRow(TEXT("FriendChanges"), FString(), FString(), NumFriendChanges);
+	AddRow(TEXT("PartnerChanges"), FString(), FString(), NumPartnerChanges);
+
+	// Tempo de rede (ServerReplicateActors) por frame
+	double NetTickTotal = 0.0;
+	float NetTickMax = 0.0f;
+	for (const float Sample : NetTickMs)
+	{
+		NetTickTotal += Sample;
+		NetTickMax = FMath::Max(NetTickMax, Sample);
+	}
+	AddRow(TEXT("NetTickMsAvg"), FString(), FString(), NetTickMs.Num() > 0 ? NetTickTotal / NetTickMs.Num() : 0.0);
+	AddRow(TEXT("NetTickMsP50"), FString(), FString(), ErosNetBenchmark::Percentile(NetTickMs, 50.0f));
+	AddRow(TEXT("NetTickMsP95"), FString(), FString(), ErosNetBenchmark::Percentile(NetTickMs, 95.0f));
+	AddRow(TEXT("NetTickMsMax"), FString(), FString(), NetTickMax);
+
+	// Banda medida por conexão
+	int64 OutBytesTotal = 0;
+	int32 OutBytesMax = 0;
+	for (const int32 Sample : ClientOutBytesPerSecond)
+	{
+		OutBytesTotal += Sample;
+		OutBytesMax = FMath::Max(OutBytesMax, Sample);
+	}
+	AddRow(TEXT("ClientOutBytesPerSecAvg"), FString(), FString(), ClientOutBytesPerSecond.Num() > 0 ? static_cast<double>(OutBytesTotal) / ClientOutBytesPerSecond.Num() : 0.0);
+	AddRow(TEXT("ClientOutBytesPerSecMax"), FString(), FString(), OutBytesMax);
+
+	// Estimativa por classe e por propriedade
+	for (const FTrackedClass& ClassInfo : TrackedClasses)
+	{
+		const FString ClassName = ClassInfo.Class->GetName();
+
+		int64 ClassBits = 0;
+		for (int32 PropertyIndex = 0; PropertyIndex < ClassInfo.Properties.Num(); ++PropertyIndex)
+		{
+			const FString PropertyName = ClassInfo.Properties[PropertyIndex]->GetName();
+			const double PropertyBytes = ClassInfo.PropertyBits[PropertyIndex] / 8.0;
+			ClassBits += ClassInfo.PropertyBits[PropertyIndex];
+
+			AddRow(TEXT("PropertyChanges"), ClassName, PropertyName, ClassInfo.PropertyChanges[PropertyIndex]);
+			AddRow(TEXT("PropertyBytes"), ClassName, PropertyName, PropertyBytes);
+			AddRow(TEXT("PropertyBytesPerPlayerPerSec"), ClassName, PropertyName, PropertyBytes / NumPlayers / Seconds);
+		}
+
+		AddRow(TEXT("ClassBytes"), ClassName, FString(), ClassBits / 8.0);
+		AddRow(TEXT("ClassBytesPerPlayerPerSec"), ClassName, FString(), ClassBits / 8.0 / NumPlayers / Seconds);
+	}
+
+	const FString FilePath = !OutputCsvPath.IsEmpty() ? OutputCsvPath
+		: FPaths::ProfilingDir() / TEXT("ErosNet") / FString::Printf(TEXT("ErosNetBench_%s.csv"), *FDateTime::Now().ToString());
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UErosNetBenchmark::WriteCsv - Failed to write %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UErosNetBenchmark::WriteCsv - Saved %s"), *FilePath);
+	return true;
+}
+
+// ========== CLIENTE ==========
+
+void UErosNetBenchmark::TickClientMovement(float DeltaTime)
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	if (!Pawn)
+	{
+		return;
+	}
+
+	ElapsedTime += DeltaTime;
+
+	// Círculo lento: 20s andando, 10s parado (exercita a taxa adaptativa)
+	if (FMath::Fmod(ElapsedTime, 30.0f) < 20.0f)
+	{
+		ClientMoveAngle += DeltaTime * 0.5f;
+		Pawn->AddMovementInput(FVector(FMath::Cos(ClientMoveAngle), FMath::Sin(ClientMoveAngle), 0.0f));
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+
+static void ErosNetBenchStart(const TArray<FString>& Args, UWorld* World)
+{
+	UErosNetBenchmark* Benchmark = UErosNetBenchmark::Get(World);
+	if (!Benchmark || !World->GetNetDriver() || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Eros.Net.Bench.Start - Must run on a server"));
+		return;
+	}
+
+	const float Seconds = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 60.0f;
+	Benchmark->StartBenchmark(Seconds);
+}
+
+static void ErosNetBenchStop(const TArray<FString>& Args, UWorld* World)
+{
+	if (UErosNetBenchmark* Benchmark = UErosNetBenchmark::Get(World))
+	{
+		Benchmark->StopBenchmark();
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ErosNetBenchStartCmd(
+	TEXT("Eros.Net.Bench.Start"),
+	TEXT("Inicia o benchmark de replicação no servidor. Args: [Seconds=60] (0 = até Eros.Net.Bench.Stop)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ErosNetBenchStart));
+
+static FAutoConsoleCommandWithWorldAndArgs ErosNetBenchStopCmd(
+	TEXT("Eros.Net.Bench.Stop"),
+	TEXT("Encerra o benchmark de replicação e grava o CSV"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ErosNetBenchStop));
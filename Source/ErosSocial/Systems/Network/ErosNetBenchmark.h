@@ -0,0 +1,128 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosNetBenchmark.h
+// Benchmark de banda de replicação (servidor dedicado + clientes headless)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ErosNetBenchmark.generated.h"
+
+class AErosSocialPlayerState;
+
+/**
+ * Harness de benchmark de replicação
+ *
+ * Execução automática (sobe servidor + N clientes headless, espera e coleta o CSV; ver UErosNetBenchCommandlet):
+ *   UnrealEditor-Cmd ErosSocial.uproject -run=ErosNetBench -Clients=16 -Seconds=60 [-Map=/Game/...]
+ *
+ * Manual, servidor (dedicado, localhost):
+ *   ErosSocial.uproject <Mapa> -server -log -ErosNetBench -ErosNetBenchClients=16 -ErosNetBenchSeconds=60 [-ErosNetBenchCsv=<arquivo>]
+ * Clientes (N vezes, mesmo host):
+ *   ErosSocial.uproject 127.0.0.1 -game -nullrhi -nosound -unattended -ErosNetBench
+ *
+ * O servidor espera os N clientes, roteiriza mudanças de status, amizades e pares de partner,
+ * e os clientes andam sozinhos (o movimento passa pelo caminho normal do CharacterMovement).
+ * No fim grava Saved/Profiling/ErosNet/ErosNetBench_<data>.csv (ou -ErosNetBenchCsv) e fecha o processo.
+ * Também pode ser iniciado manualmente com Eros.Net.Bench.Start / Eros.Net.Bench.Stop.
+ *
+ * Bytes por propriedade são estimados: valor serializado (NetSerializeItem) de cada mudança
+ * vezes as conexões com canal aberto para o ator, sem headers de bunch/pacote.
+ * Os totais por conexão (OutBytesPerSecond) e o tempo de ServerReplicateActors são medidos.
+ */
+UCLASS()
+class EROSSOCIAL_API UErosNetBenchmark : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosNetBenchmark* Get(const UObject* WorldContextObject);
+
+	// USubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Inicia a coleta no servidor (Seconds <= 0: até Stop) */
+	void StartBenchmark(float Seconds, bool bExitWhenDone = false);
+
+	/** Encerra a coleta e grava o CSV */
+	void StopBenchmark();
+
+	bool IsRunning() const { return bRunning; }
+
+private:
+	struct FTrackedClass
+	{
+		UClass* Class = nullptr;
+		TArray<FProperty*> Properties;
+		TArray<int32> ShadowOffsets;
+		int32 ShadowSize = 0;
+
+		// Paralelo a Properties
+		TArray<int64> PropertyChanges;
+		TArray<int64> PropertyBits;
+	};
+
+	struct FTrackedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		int32 ClassIndex = INDEX_NONE;
+		uint8* Shadow = nullptr;
+	};
+
+	void TickServer(float DeltaTime);
+	void TickClientMovement(float DeltaTime);
+
+	void RunScriptedActions();
+	void SampleReplicatedProperties();
+
+	int32 FindOrAddTrackedClass(UClass* Class);
+	void TrackActor(AActor* Actor);
+	void ReleaseTrackedActors();
+	void ReleaseShadow(FTrackedActor& Tracked);
+
+	bool WriteCsv() const;
+
+	TArray<AErosSocialPlayerState*> GetBenchPlayers() const;
+
+	// ========== CONFIGURAÇÃO (linha de comando) ==========
+
+	bool bClientMovement = false;
+	bool bAutoStart = false;
+	int32 AutoStartClients = 1;
+	float AutoStartSeconds = 60.0f;
+
+	// Vazio: Saved/Profiling/ErosNet/ErosNetBench_<data>.csv
+	FString OutputCsvPath;
+
+	// ========== ESTADO ==========
+
+	bool bRunning = false;
+	bool bExitWhenDone = false;
+	float Duration = 0.0f;
+	float ElapsedTime = 0.0f;
+	float TimeUntilScript = 0.0f;
+	float TimeUntilBandwidthSample = 0.0f;
+	float ClientMoveAngle = 0.0f;
+
+	FRandomStream Random;
+
+	TArray<FTrackedClass> TrackedClasses;
+	TMap<AActor*, FTrackedActor> TrackedActors;
+
+	// Um valor por frame de rede
+	TArray<float> NetTickMs;
+
+	// Uma amostra por conexão a cada segundo
+	TArray<int32> ClientOutBytesPerSecond;
+
+	int32 MaxPlayers = 0;
+	int32 NumStatusChanges = 0;
+	int32 NumFriendChanges = 0;
+	int32 NumPartnerChanges = 0;
+};
@@ -0,0 +1,10 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosNetStats.h
+// Grupo de stats de rede do ErosSocial ("stat ErosNet")
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("ErosSocial Net"), STATGROUP_ErosNet, STATCAT_Advanced);
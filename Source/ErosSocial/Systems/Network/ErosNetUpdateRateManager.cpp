@@ -0,0 +1,286 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosNetUpdateRateManager.cpp
+
+#include "Systems/Network/ErosNetUpdateRateManager.h"
+#include "Systems/Network/ErosNetStats.h"
+#include "Systems/Network/ErosSocialReplicationGraph.h"
+#include "ErosSocialCharacter.h"
+#include "ErosSocialPlayerState.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("NetRate Evaluate"), STAT_ErosNetRate_Evaluate, STATGROUP_ErosNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("NetRate Avatars Full"), STAT_ErosNetRate_Full, STATGROUP_ErosNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("NetRate Avatars Reduced"), STAT_ErosNetRate_Reduced, STATGROUP_ErosNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("NetRate Avatars Min"), STAT_ErosNetRate_Min, STATGROUP_ErosNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("NetRate Rate Changes"), STAT_ErosNetRate_Changes, STATGROUP_ErosNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Out Bytes/s (avg)"), STAT_ErosNet_ClientOutBytesAvg, STATGROUP_ErosNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Out Bytes/s (max)"), STAT_ErosNet_ClientOutBytesMax, STATGROUP_ErosNet);
+
+namespace ErosNetUpdateRate
+{
+	// Metades sucessivas da taxa cheia até a mínima: poucas trocas de degrau e poucas escritas no RepGraph
+	static float Quantize(float Frequency, float FullFrequency, float MinFrequency)
+	{
+		for (float Step = FullFrequency; Step > MinFrequency; Step *= 0.5f)
+		{
+			if (Frequency > Step * 0.75f)
+			{
+				return Step;
+			}
+		}
+		return MinFrequency;
+	}
+}
+
+UErosNetUpdateRateManager::UErosNetUpdateRateManager()
+{
+}
+
+UErosNetUpdateRateManager* UErosNetUpdateRateManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosNetUpdateRateManager>() : nullptr;
+}
+
+bool UErosNetUpdateRateManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UErosNetUpdateRateManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UErosNetUpdateRateManager, STATGROUP_ErosNet);
+}
+
+void UErosNetUpdateRateManager::Tick(float DeltaTime)
+{
+	const UWorld* World = GetWorld();
+	const ENetMode NetMode = World->GetNetMode();
+	if (NetMode == NM_Client || NetMode == NM_Standalone)
+	{
+		return;
+	}
+
+	TimeUntilEvaluation -= DeltaTime;
+	if (TimeUntilEvaluation > 0.0f)
+	{
+		return;
+	}
+	TimeUntilEvaluation = EvaluationInterval;
+
+	EvaluateNow();
+}
+
+void UErosNetUpdateRateManager::NotifyInteraction(AActor* InstigatorActor, AActor* TargetActor, float Duration)
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const double ExpireTime = World->GetTimeSeconds() + Duration;
+	for (AActor* Actor : { InstigatorActor, TargetActor })
+	{
+		if (Actor)
+		{
+			double& PinExpireTime = InteractionPins.FindOrAdd(Actor);
+			PinExpireTime = FMath::Max(PinExpireTime, ExpireTime);
+		}
+	}
+}
+
+void UErosNetUpdateRateManager::EvaluateNow()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosNetRate_Evaluate);
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const double CurrentTime = World->GetTimeSeconds();
+
+	Viewers.Reset();
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (!PlayerController)
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		Viewers.Add({ ViewLocation, ViewRotation.Vector(), PlayerController });
+	}
+
+	for (auto It = InteractionPins.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid() || It.Value() <= CurrentTime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	UNetDriver* NetDriver = World->GetNetDriver();
+	UErosSocialReplicationGraph* Graph = NetDriver ? Cast<UErosSocialReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+
+	int32 NumFull = 0;
+	int32 NumReduced = 0;
+	int32 NumMin = 0;
+	int32 NumChanges = 0;
+
+	for (TActorIterator<AErosSocialCharacter> It(World); It; ++It)
+	{
+		AErosSocialCharacter* Character = *It;
+
+		// Dormentes não replicam; a taxa é reavaliada quando acordarem
+		if (Character->NetDormancy > DORM_Awake)
+		{
+			continue;
+		}
+
+		const float FullFrequency = Character->GetClass()->GetDefaultObject<AErosSocialCharacter>()->NetUpdateFrequency;
+		const float MinFrequency = FMath::Min(MinNetUpdateFrequency, FullFrequency);
+
+		const float Frequency = IsPinnedToFullRate(Character, CurrentTime)
+			? FullFrequency
+			: ErosNetUpdateRate::Quantize(ComputeFrequency(Character, FullFrequency), FullFrequency, MinFrequency);
+
+		if (Character->SetAdaptiveNetUpdateFrequency(Frequency))
+		{
+			++NumChanges;
+
+			// Com Replication Graph o NetUpdateFrequency do ator não é lido a cada frame
+			if (Graph)
+			{
+				Graph->SetActorReplicationFrequency(Character, Frequency);
+			}
+		}
+
+		if (Frequency >= FullFrequency)
+		{
+			++NumFull;
+		}
+		else if (Frequency > MinFrequency)
+		{
+			++NumReduced;
+		}
+		else
+		{
+			++NumMin;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ErosNetRate_Full, NumFull);
+	SET_DWORD_STAT(STAT_ErosNetRate_Reduced, NumReduced);
+	SET_DWORD_STAT(STAT_ErosNetRate_Min, NumMin);
+	SET_DWORD_STAT(STAT_ErosNetRate_Changes, NumChanges);
+
+	UpdateBandwidthStats();
+}
+
+float UErosNetUpdateRateManager::ComputeFrequency(const AErosSocialCharacter* Character, float FullFrequency) const
+{
+	const FVector Location = Character->GetActorLocation();
+	const AController* OwnController = Character->GetController();
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(ViewConeHalfAngleDegrees));
+	const float MinRateDistSq = FMath::Square(MinRateDistance);
+
+	float NearestDistSq = MAX_flt;
+	bool bInView = false;
+
+	for (const FViewerInfo& Viewer : Viewers)
+	{
+		// O dono recebe o próprio movimento por correções, não por essa taxa
+		if (Viewer.Controller == OwnController)
+		{
+			continue;
+		}
+
+		const FVector ToCharacter = Location - Viewer.Location;
+		const float DistSq = ToCharacter.SizeSquared();
+		NearestDistSq = FMath::Min(NearestDistSq, DistSq);
+
+		if (!bInView && DistSq <= MinRateDistSq)
+		{
+			const float Dist = FMath::Sqrt(DistSq);
+			bInView = Dist <= KINDA_SMALL_NUMBER || FVector::DotProduct(ToCharacter, Viewer.Direction) >= CosHalfAngle * Dist;
+		}
+	}
+
+	// Ninguém olhando
+	if (NearestDistSq == MAX_flt)
+	{
+		return 0.0f;
+	}
+
+	const float Range = FMath::Max(MinRateDistance - FullRateDistance, 1.0f);
+	float Alpha = 1.0f - FMath::Clamp((FMath::Sqrt(NearestDistSq) - FullRateDistance) / Range, 0.0f, 1.0f);
+
+	if (!bInView)
+	{
+		Alpha *= 0.5f;
+	}
+
+	// Parado: só rotação/animação mudam, e devagar
+	if (Character->GetVelocity().SizeSquared2D() < FMath::Square(IdleSpeedThreshold))
+	{
+		Alpha *= 0.5f;
+	}
+
+	return FMath::Lerp(MinNetUpdateFrequency, FullFrequency, Alpha);
+}
+
+bool UErosNetUpdateRateManager::IsPinnedToFullRate(const AErosSocialCharacter* Character, double CurrentTime) const
+{
+	const AErosSocialPlayerState* ErosPlayerState = Character->GetPlayerState<AErosSocialPlayerState>();
+
+	const double* PinExpireTime = InteractionPins.Find(const_cast<AErosSocialCharacter*>(Character));
+	if (!PinExpireTime && ErosPlayerState)
+	{
+		PinExpireTime = InteractionPins.Find(const_cast<AErosSocialPlayerState*>(ErosPlayerState));
+	}
+	if (PinExpireTime && *PinExpireTime > CurrentTime)
+	{
+		return true;
+	}
+
+	// Casal perto um do outro: o partner sempre vê o outro em taxa cheia
+	// Este é o único pin do partner; o nó social do Replication Graph só usa a taxa calculada aqui
+	const AErosSocialPlayerState* Partner = ErosPlayerState ? ErosPlayerState->GetPartner() : nullptr;
+	const APawn* PartnerPawn = Partner ? Partner->GetPawn() : nullptr;
+	return PartnerPawn && FVector::DistSquared(PartnerPawn->GetActorLocation(), Character->GetActorLocation()) <= FMath::Square(PartnerFullRateDistance);
+}
+
+void UErosNetUpdateRateManager::UpdateBandwidthStats() const
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver || NetDriver->ClientConnections.Num() == 0)
+	{
+		SET_DWORD_STAT(STAT_ErosNet_ClientOutBytesAvg, 0);
+		SET_DWORD_STAT(STAT_ErosNet_ClientOutBytesMax, 0);
+		return;
+	}
+
+	int64 TotalBytes = 0;
+	int32 MaxBytes = 0;
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection)
+		{
+			TotalBytes += Connection->OutBytesPerSecond;
+			MaxBytes = FMath::Max(MaxBytes, Connection->OutBytesPerSecond);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ErosNet_ClientOutBytesAvg, static_cast<uint32>(TotalBytes / NetDriver->ClientConnections.Num()));
+	SET_DWORD_STAT(STAT_ErosNet_ClientOutBytesMax, static_cast<uint32>(MaxBytes));
+}
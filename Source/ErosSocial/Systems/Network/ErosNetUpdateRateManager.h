@@ -0,0 +1,102 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosNetUpdateRateManager.h
+// Taxa de replicação adaptativa dos avatares
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ErosNetUpdateRateManager.generated.h"
+
+class AErosSocialCharacter;
+
+/**
+ * Ajusta a frequência de replicação de cada AErosSocialCharacter (somente servidor)
+ * - Distância até o viewer mais próximo e se está dentro do campo de visão de alguém
+ * - Parado ou em movimento
+ * - Taxa cheia para quem tem o partner por perto ou está numa interação ativa
+ *
+ * A taxa é quantizada em degraus (metades da taxa cheia até a mínima) e só é aplicada quando o degrau muda.
+ * O cliente recebe a taxa pelo personagem e ajusta a suavização de movimento dos simulated proxies.
+ */
+UCLASS(config = Game)
+class EROSSOCIAL_API UErosNetUpdateRateManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UErosNetUpdateRateManager();
+
+	static UErosNetUpdateRateManager* Get(const UObject* WorldContextObject);
+
+	// USubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Mantém os dois atores em taxa cheia durante Duration segundos (chat, emote, convite...)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Network")
+	void NotifyInteraction(AActor* InstigatorActor, AActor* TargetActor, float Duration = 10.0f);
+
+	/**
+	 * Recalcula as taxas imediatamente (normalmente a cada EvaluationInterval)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Network")
+	void EvaluateNow();
+
+	// ========== CONFIGURAÇÃO (DefaultGame.ini) ==========
+
+	// Intervalo entre avaliações
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.25f;
+
+	// Taxa mínima (Hz) para avatares longe ou parados fora de vista
+	UPROPERTY(Config)
+	float MinNetUpdateFrequency = 5.0f;
+
+	// Até aqui o avatar mantém a taxa cheia (se estiver em vista)
+	UPROPERTY(Config)
+	float FullRateDistance = 1500.0f;
+
+	// A partir daqui o avatar fica na taxa mínima
+	UPROPERTY(Config)
+	float MinRateDistance = 8000.0f;
+
+	// Meio ângulo do cone de visão usado para "em vista"
+	UPROPERTY(Config)
+	float ViewConeHalfAngleDegrees = 60.0f;
+
+	// Abaixo dessa velocidade o avatar é considerado parado
+	UPROPERTY(Config)
+	float IdleSpeedThreshold = 10.0f;
+
+	// Partner dentro dessa distância deixa o casal em taxa cheia
+	UPROPERTY(Config)
+	float PartnerFullRateDistance = 4000.0f;
+
+private:
+	struct FViewerInfo
+	{
+		FVector Location;
+		FVector Direction;
+		const AController* Controller;
+	};
+
+	float ComputeFrequency(const AErosSocialCharacter* Character, float FullFrequency) const;
+
+	bool IsPinnedToFullRate(const AErosSocialCharacter* Character, double CurrentTime) const;
+
+	void UpdateBandwidthStats() const;
+
+	// Reaproveitado entre avaliações
+	TArray<FViewerInfo> Viewers;
+
+	// Ator -> tempo (World) em que a interação expira
+	TMap<TWeakObjectPtr<AActor>, double> InteractionPins;
+
+	float TimeUntilEvaluation = 0.0f;
+};
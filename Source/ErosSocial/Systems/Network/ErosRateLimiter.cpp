@@ -0,0 +1,130 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosRateLimiter.cpp
+
+#include "Systems/Network/ErosRateLimiter.h"
+#include "Systems/Network/ErosNetStats.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RPCs Rate Limited"), STAT_ErosNet_RateLimited, STATGROUP_ErosNet);
+
+UErosRateLimitSubsystem* UErosRateLimitSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosRateLimitSubsystem>() : nullptr;
+}
+
+void UErosRateLimitSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (FErosRateLimitRule& Rule : RulesByAction)
+	{
+		Rule.Burst = 0.0f;
+	}
+
+	for (const FErosRateLimitRule& Rule : Rules)
+	{
+		if (Rule.Action < EErosRateLimitedAction::MAX)
+		{
+			RulesByAction[static_cast<int32>(Rule.Action)] = Rule;
+		}
+	}
+}
+
+bool UErosRateLimitSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UErosRateLimitSubsystem::TryConsume(FErosRateLimitState& State, EErosRateLimitedAction Action, const UObject* Requester)
+{
+	if (Action >= EErosRateLimitedAction::MAX)
+	{
+		return false;
+	}
+
+	const int32 ActionIndex = static_cast<int32>(Action);
+	const FErosRateLimitRule& Rule = RulesByAction[ActionIndex];
+	if (Rule.Burst <= 0.0f)
+	{
+		++AllowedCounts[ActionIndex];
+		return true;
+	}
+
+	// Tempo real: pausa e dilatação não podem liberar pedidos
+	const double Now = GetWorld()->GetRealTimeSeconds();
+	FErosRateLimitState::FBucket& Bucket = State.Buckets[ActionIndex];
+
+	if (Bucket.Tokens < 0.0f)
+	{
+		Bucket.Tokens = Rule.Burst;
+	}
+	else
+	{
+		const double Elapsed = FMath::Max(0.0, Now - Bucket.LastRefillTime);
+		Bucket.Tokens = FMath::Min(Rule.Burst, Bucket.Tokens + static_cast<float>(Elapsed * FMath::Max(Rule.RefillPerSecond, 0.0f)));
+	}
+	Bucket.LastRefillTime = Now;
+
+	if (Bucket.Tokens >= 1.0f)
+	{
+		Bucket.Tokens -= 1.0f;
+		++AllowedCounts[ActionIndex];
+		return true;
+	}
+
+	++Bucket.NumDropped;
+	++DropCounts[ActionIndex];
+	INC_DWORD_STAT(STAT_ErosNet_RateLimited);
+
+	// Um aviso por conexão ao começar a descartar e depois a cada 100 descartes
+	if (Bucket.NumDropped == 1 || Bucket.NumDropped % 100 == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UErosRateLimitSubsystem::TryConsume - %s dropped %s (%u dropped on this connection)"),
+			*GetNameSafe(Requester), *UEnum::GetValueAsString(Action), Bucket.NumDropped);
+	}
+
+	return false;
+}
+
+int64 UErosRateLimitSubsystem::GetDropCount(EErosRateLimitedAction Action) const
+{
+	return Action < EErosRateLimitedAction::MAX ? DropCounts[static_cast<int32>(Action)] : 0;
+}
+
+int64 UErosRateLimitSubsystem::GetTotalDropCount() const
+{
+	int64 Total = 0;
+	for (const int64 Count : DropCounts)
+	{
+		Total += Count;
+	}
+	return Total;
+}
+
+void UErosRateLimitSubsystem::LogSummary() const
+{
+	for (int32 ActionIndex = 0; ActionIndex < static_cast<int32>(EErosRateLimitedAction::MAX); ++ActionIndex)
+	{
+		const FErosRateLimitRule& Rule = RulesByAction[ActionIndex];
+		UE_LOG(LogTemp, Log, TEXT("UErosRateLimitSubsystem - %-32s allowed %lld, dropped %lld (burst %.1f, %.2f/s)"),
+			*UEnum::GetValueAsString(static_cast<EErosRateLimitedAction>(ActionIndex)),
+			AllowedCounts[ActionIndex], DropCounts[ActionIndex], Rule.Burst, Rule.RefillPerSecond);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+
+static void ErosRateLimitStats(const TArray<FString>& Args, UWorld* World)
+{
+	if (const UErosRateLimitSubsystem* RateLimiter = UErosRateLimitSubsystem::Get(World))
+	{
+		RateLimiter->LogSummary();
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ErosRateLimitStatsCmd(
+	TEXT("Eros.Net.RateLimitStats"),
+	TEXT("Pedidos aceitos e descartados por ação (rate limit dos RPCs sociais)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ErosRateLimitStats));
@@ -0,0 +1,99 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosRateLimiter.h
+// Limite de RPCs sociais por conexão (token bucket por ação)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ErosRateLimiter.generated.h"
+
+UENUM(BlueprintType)
+enum class EErosRateLimitedAction : uint8
+{
+	PartnerRequest  UMETA(DisplayName = "Partner Request"),
+	FriendAdd       UMETA(DisplayName = "Friend Add"),
+	FriendRemove    UMETA(DisplayName = "Friend Remove"),
+	StatusChange    UMETA(DisplayName = "Status Change"),
+	ChatMessage     UMETA(DisplayName = "Chat Message"),
+	MAX             UMETA(Hidden)
+};
+
+/**
+ * Regra de uma ação (DefaultGame.ini)
+ * +Rules=(Action=PartnerRequest,Burst=3,RefillPerSecond=0.2)
+ */
+USTRUCT()
+struct FErosRateLimitRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EErosRateLimitedAction Action = EErosRateLimitedAction::MAX;
+
+	// Pedidos seguidos permitidos com o balde cheio
+	UPROPERTY()
+	float Burst = 5.0f;
+
+	// Tokens devolvidos por segundo (taxa sustentada)
+	UPROPERTY()
+	float RefillPerSecond = 1.0f;
+};
+
+/**
+ * Estado de uma conexão (fica no PlayerController do servidor, morre junto com a conexão)
+ */
+struct FErosRateLimitState
+{
+	struct FBucket
+	{
+		float Tokens = -1.0f;      // < 0: ainda não usado (começa cheio)
+		double LastRefillTime = 0.0;
+		uint32 NumDropped = 0;
+	};
+
+	FBucket Buckets[static_cast<int32>(EErosRateLimitedAction::MAX)];
+};
+
+/**
+ * Token buckets dos RPCs sociais (somente servidor)
+ * - As RPCs consultam TryConsume antes de qualquer lógica de jogo; sem token, o pedido é descartado
+ * - Ação sem regra no ini não tem limite
+ * - Descartes contados por ação (total do servidor) e por conexão; "stat ErosNet" e Eros.Net.RateLimitStats
+ */
+UCLASS(config = Game)
+class EROSSOCIAL_API UErosRateLimitSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosRateLimitSubsystem* Get(const UObject* WorldContextObject);
+
+	// USubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Consome um token da ação; false = descartar o pedido */
+	bool TryConsume(FErosRateLimitState& State, EErosRateLimitedAction Action, const UObject* Requester);
+
+	/** Descartes da ação desde o início do mundo (todas as conexões) */
+	UFUNCTION(BlueprintPure, Category = "Network")
+	int64 GetDropCount(EErosRateLimitedAction Action) const;
+
+	UFUNCTION(BlueprintPure, Category = "Network")
+	int64 GetTotalDropCount() const;
+
+	void LogSummary() const;
+
+	// ========== CONFIGURAÇÃO (DefaultGame.ini) ==========
+
+	UPROPERTY(Config)
+	TArray<FErosRateLimitRule> Rules;
+
+private:
+	// Indexado pela ação; Burst <= 0 = sem limite
+	FErosRateLimitRule RulesByAction[static_cast<int32>(EErosRateLimitedAction::MAX)];
+
+	int64 DropCounts[static_cast<int32>(EErosRateLimitedAction::MAX)] = {};
+	int64 AllowedCounts[static_cast<int32>(EErosRateLimitedAction::MAX)] = {};
+};
@@ -0,0 +1,606 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosSocialReplicationGraph.cpp
+
+#include "Systems/Network/ErosSocialReplicationGraph.h"
+#include "Systems/Network/ErosNetStats.h"
+#include "ErosSocialCharacter.h"
+#include "ErosSocialPlayerState.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Containers/Ticker.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_CYCLE_STAT(TEXT("RepGraph ServerReplicateActors"), STAT_ErosRep_ServerReplicateActors, STATGROUP_ErosNet);
+DECLARE_CYCLE_STAT(TEXT("RepGraph Avatar Gather"), STAT_ErosRep_AvatarGather, STATGROUP_ErosNet);
+DECLARE_CYCLE_STAT(TEXT("RepGraph Social Gather"), STAT_ErosRep_SocialGather, STATGROUP_ErosNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RepGraph Avatars Near"), STAT_ErosRep_AvatarsNear, STATGROUP_ErosNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RepGraph Avatars Mid"), STAT_ErosRep_AvatarsMid, STATGROUP_ErosNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RepGraph Avatars Far"), STAT_ErosRep_AvatarsFar, STATGROUP_ErosNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RepGraph Social Actors"), STAT_ErosRep_SocialActors, STATGROUP_ErosNet);
+
+//////////////////////////////////////////////////////////////////////////
+// UErosSocialReplicationGraph
+
+UErosSocialReplicationGraph::UErosSocialReplicationGraph()
+	: GridNode(nullptr)
+	, AlwaysRelevantNode(nullptr)
+	, AvatarNode(nullptr)
+	, PlayerStateNode(nullptr)
+{
+}
+
+void UErosSocialReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Configuração padrão a partir do CDO de cada classe replicada (NetUpdateFrequency e NetCullDistance)
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject(false));
+		if (!ActorCDO || !ActorCDO->GetIsReplicated())
+		{
+			continue;
+		}
+
+		// Ignorar classes temporárias do editor
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		FClassReplicationInfo ClassInfo;
+		ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ActorCDO->NetUpdateFrequency);
+		ClassInfo.SetCullDistanceSquared(ActorCDO->NetCullDistanceSquared);
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+
+	// Avatares: o cull é feito pelo grid de avatares
+	FClassReplicationInfo AvatarInfo = GlobalActorReplicationInfoMap.GetClassInfo(AErosSocialCharacter::StaticClass());
+	AvatarInfo.SetCullDistanceSquared(AvatarCullDistance * AvatarCullDistance);
+	GlobalActorReplicationInfoMap.SetClassInfo(AErosSocialCharacter::StaticClass(), AvatarInfo);
+
+	// PlayerStates: vão em subconjuntos rotativos, então o canal não pode expirar
+	FClassReplicationInfo PlayerStateInfo;
+	PlayerStateInfo.DistancePriorityScale = 0.0f;
+	PlayerStateInfo.ActorChannelFrameTimeout = 0;
+	GlobalActorReplicationInfoMap.SetClassInfo(AErosSocialPlayerState::StaticClass(), PlayerStateInfo);
+}
+
+void UErosSocialReplicationGraph::InitGlobalGraphNodes()
+{
+	// Grid padrão para o que não é avatar
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	AddGlobalGraphNode(GridNode);
+
+	// Grid dos avatares com buckets por distância
+	AvatarNode = CreateNewNode<UErosReplicationGraphNode_AvatarGrid>();
+	AvatarNode->CellSize = AvatarCellSize;
+	AvatarNode->NearDistance = AvatarNearDistance;
+	AvatarNode->MidDistance = AvatarMidDistance;
+	AvatarNode->CullDistance = AvatarCullDistance;
+	AvatarNode->MidPeriodFrames = static_cast<uint8>(FMath::Clamp(AvatarMidPeriodFrames, 1, 255));
+	AvatarNode->FarPeriodFrames = static_cast<uint8>(FMath::Clamp(AvatarFarPeriodFrames, 1, 255));
+	AddGlobalGraphNode(AvatarNode);
+
+	// GameState e afins
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	PlayerStateNode = CreateNewNode<UErosReplicationGraphNode_PlayerStates>();
+	PlayerStateNode->MaxPerFrame = FMath::Max(1, MaxPlayerStatesPerFrame);
+	AddGlobalGraphNode(PlayerStateNode);
+
+	UE_LOG(LogTemp, Log, TEXT("ErosSocialReplicationGraph::InitGlobalGraphNodes - Replication graph initialized"));
+}
+
+void UErosSocialReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UErosReplicationGraphNode_SocialRelevant* SocialNode = CreateNewNode<UErosReplicationGraphNode_SocialRelevant>();
+	AddConnectionGraphNode(SocialNode, RepGraphConnection);
+}
+
+void UErosSocialReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+
+	if (Actor->IsA<AErosSocialCharacter>())
+	{
+		AvatarNode->NotifyAddNetworkActor(ActorInfo);
+	}
+	else if (Actor->IsA<AErosSocialPlayerState>())
+	{
+		PlayerStateNode->NotifyAddNetworkActor(ActorInfo);
+	}
+	else if (Actor->bOnlyRelevantToOwner)
+	{
+		// Controllers entram pelo nó da conexão dona
+	}
+	else if (Actor->bAlwaysRelevant)
+	{
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+	}
+	else if (Actor->IsReplicatingMovement())
+	{
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+	}
+	else
+	{
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+	}
+}
+
+void UErosSocialReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+
+	if (Actor->IsA<AErosSocialCharacter>())
+	{
+		AvatarNode->NotifyRemoveNetworkActor(ActorInfo);
+	}
+	else if (Actor->IsA<AErosSocialPlayerState>())
+	{
+		PlayerStateNode->NotifyRemoveNetworkActor(ActorInfo);
+	}
+	else if (Actor->bOnlyRelevantToOwner)
+	{
+	}
+	else if (Actor->bAlwaysRelevant)
+	{
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+	}
+	else if (Actor->IsReplicatingMovement())
+	{
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+	}
+	else
+	{
+		GridNode->RemoveActor_Static(ActorInfo);
+	}
+}
+
+void UErosSocialReplicationGraph::RemoveClientConnection(UNetConnection* NetConnection)
+{
+	ConnectionStats.Remove(NetConnection);
+
+	Super::RemoveClientConnection(NetConnection);
+}
+
+int32 UErosSocialReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosRep_ServerReplicateActors);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 Result = Super::ServerReplicateActors(DeltaSeconds);
+
+	LastReplicateActorsSeconds = FPlatformTime::Seconds() - StartTime;
+	ReplicateActorsSeconds += LastReplicateActorsSeconds;
+	++ReplicateActorsFrames;
+
+	return Result;
+}
+
+AErosSocialPlayerState* UErosSocialReplicationGraph::FindPlayerStateByUserId(const FErosUserId& UserId) const
+{
+	return PlayerStateNode ? PlayerStateNode->FindByUserId(UserId) : nullptr;
+}
+
+void UErosSocialReplicationGraph::SetActorReplicationFrequency(AActor* Actor, float Frequency)
+{
+	if (FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Actor))
+	{
+		GlobalInfo->Settings.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(Frequency);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UErosReplicationGraphNode_AvatarGrid
+
+UErosReplicationGraphNode_AvatarGrid::UErosReplicationGraphNode_AvatarGrid()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void UErosReplicationGraphNode_AvatarGrid::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	Avatars.Add(ActorInfo.Actor);
+}
+
+bool UErosReplicationGraphNode_AvatarGrid::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	const bool bRemoved = Avatars.RemoveFast(ActorInfo.Actor);
+	if (!bRemoved && bWarnIfNotFound)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ErosReplicationGraphNode_AvatarGrid::NotifyRemoveNetworkActor - %s not found"), *GetNameSafe(ActorInfo.Actor));
+	}
+
+	// As células são reconstruídas no próximo PrepareForReplication; até lá o ator não pode ser coletado
+	for (TPair<FIntPoint, TArray<AActor*>>& Cell : Cells)
+	{
+		Cell.Value.RemoveSwap(ActorInfo.Actor);
+	}
+
+	return bRemoved;
+}
+
+void UErosReplicationGraphNode_AvatarGrid::NotifyResetAllNetworkActors()
+{
+	Avatars.Reset();
+	Cells.Reset();
+}
+
+FIntPoint UErosReplicationGraphNode_AvatarGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UErosReplicationGraphNode_AvatarGrid::PrepareForReplication()
+{
+	for (TPair<FIntPoint, TArray<AActor*>>& Cell : Cells)
+	{
+		Cell.Value.Reset();
+	}
+
+	for (AActor* Avatar : Avatars)
+	{
+		Cells.FindOrAdd(GetCell(Avatar->GetActorLocation())).Add(Avatar);
+	}
+}
+
+void UErosReplicationGraphNode_AvatarGrid::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosRep_AvatarGather);
+
+	const float NearDistSq = NearDistance * NearDistance;
+	const float MidDistSq = MidDistance * MidDistance;
+	const float CullDistSq = CullDistance * CullDistance;
+	const int32 CellRadius = FMath::CeilToInt(CullDistance / CellSize);
+
+	FGlobalActorReplicationInfoMap& GlobalMap = *GraphGlobals->GlobalActorReplicationInfoMap;
+
+	FErosRepGraphConnectionStats& Stats = CastChecked<UErosSocialReplicationGraph>(GetOuter())->GetMutableConnectionStats(Params.ConnectionManager.NetConnection);
+	Stats.NumNearAvatars = 0;
+	Stats.NumMidAvatars = 0;
+	Stats.NumFarAvatars = 0;
+
+	GatheredAvatars.Reset();
+
+	// Em split-screen o último viewer define o bucket; no hub há um viewer por conexão
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		const FIntPoint Center = GetCell(Viewer.ViewLocation);
+
+		for (int32 X = Center.X - CellRadius; X <= Center.X + CellRadius; ++X)
+		{
+			for (int32 Y = Center.Y - CellRadius; Y <= Center.Y + CellRadius; ++Y)
+			{
+				const TArray<AActor*>* Cell = Cells.Find(FIntPoint(X, Y));
+				if (!Cell)
+				{
+					continue;
+				}
+
+				for (AActor* Avatar : *Cell)
+				{
+					const float DistSq = FVector::DistSquared2D(Avatar->GetActorLocation(), Viewer.ViewLocation);
+					if (DistSq > CullDistSq)
+					{
+						continue;
+					}
+
+					const FGlobalActorReplicationInfo& GlobalInfo = GlobalMap.Get(Avatar);
+					FConnectionReplicationActorInfo& ConnectionInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(Avatar);
+					ConnectionInfo.SetCullDistanceSquared(GlobalInfo.Settings.GetCullDistanceSquared());
+
+					const uint32 ClassPeriod = GlobalInfo.Settings.ReplicationPeriodFrame;
+					uint32 Period = ClassPeriod;
+					if (DistSq <= NearDistSq)
+					{
+						++Stats.NumNearAvatars;
+					}
+					else if (DistSq <= MidDistSq)
+					{
+						Period = FMath::Max<uint32>(ClassPeriod, MidPeriodFrames);
+						++Stats.NumMidAvatars;
+					}
+					else
+					{
+						Period = FMath::Max<uint32>(ClassPeriod, FarPeriodFrames);
+						++Stats.NumFarAvatars;
+					}
+					ConnectionInfo.ReplicationPeriodFrame = static_cast<decltype(ConnectionInfo.ReplicationPeriodFrame)>(Period);
+
+					GatheredAvatars.Add(Avatar);
+				}
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_ErosRep_AvatarsNear, Stats.NumNearAvatars);
+	INC_DWORD_STAT_BY(STAT_ErosRep_AvatarsMid, Stats.NumMidAvatars);
+	INC_DWORD_STAT_BY(STAT_ErosRep_AvatarsFar, Stats.NumFarAvatars);
+
+	if (GatheredAvatars.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(GatheredAvatars);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UErosReplicationGraphNode_PlayerStates
+
+UErosReplicationGraphNode_PlayerStates::UErosReplicationGraphNode_PlayerStates()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void UErosReplicationGraphNode_PlayerStates::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	PlayerStates.AddUnique(CastChecked<AErosSocialPlayerState>(ActorInfo.Actor));
+}
+
+bool UErosReplicationGraphNode_PlayerStates::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	AErosSocialPlayerState* PlayerState = CastChecked<AErosSocialPlayerState>(ActorInfo.Actor);
+	const bool bRemoved = PlayerStates.RemoveSwap(PlayerState) > 0;
+
+	// Limpa as referências imediatamente; o resto é reconstruído no próximo frame
+	for (FActorRepListRefView& Chunk : Chunks)
+	{
+		Chunk.RemoveFast(PlayerState);
+	}
+	PlayerStatesByUserId.Remove(PlayerState->UserID);
+
+	if (!bRemoved && bWarnIfNotFound)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ErosReplicationGraphNode_PlayerStates::NotifyRemoveNetworkActor - %s not found"), *GetNameSafe(PlayerState));
+	}
+
+	return bRemoved;
+}
+
+void UErosReplicationGraphNode_PlayerStates::NotifyResetAllNetworkActors()
+{
+	PlayerStates.Reset();
+	Chunks.Reset();
+	PlayerStatesByUserId.Reset();
+}
+
+void UErosReplicationGraphNode_PlayerStates::PrepareForReplication()
+{
+	// UserID é definido depois do spawn (PostLogin), então a tabela é refeita a cada frame
+	PlayerStatesByUserId.Reset();
+
+	const int32 NumChunks = FMath::Max(1, FMath::DivideAndRoundUp(PlayerStates.Num(), MaxPerFrame));
+	Chunks.SetNum(NumChunks);
+	for (FActorRepListRefView& Chunk : Chunks)
+	{
+		Chunk.Reset();
+	}
+
+	for (int32 Index = 0; Index < PlayerStates.Num(); ++Index)
+	{
+		AErosSocialPlayerState* PlayerState = PlayerStates[Index];
+		Chunks[Index / MaxPerFrame].Add(PlayerState);
+
+		if (PlayerState->UserID.IsValid())
+		{
+			PlayerStatesByUserId.Add(PlayerState->UserID, PlayerState);
+		}
+	}
+}
+
+void UErosReplicationGraphNode_PlayerStates::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	if (Chunks.Num() == 0)
+	{
+		return;
+	}
+
+	FActorRepListRefView& Chunk = Chunks[Params.ReplicationFrameNum % Chunks.Num()];
+	if (Chunk.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(Chunk);
+	}
+}
+
+AErosSocialPlayerState* UErosReplicationGraphNode_PlayerStates::FindByUserId(const FErosUserId& UserId) const
+{
+	AErosSocialPlayerState* const* Found = PlayerStatesByUserId.Find(UserId);
+	return Found ? *Found : nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UErosReplicationGraphNode_SocialRelevant
+
+void UErosReplicationGraphNode_SocialRelevant::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosRep_SocialGather);
+
+	UErosSocialReplicationGraph* Graph = CastChecked<UErosSocialReplicationGraph>(GetOuter());
+
+	ReplicationActorList.Reset();
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		ReplicationActorList.ConditionalAdd(Viewer.InViewer);
+		ReplicationActorList.ConditionalAdd(Viewer.ViewTarget);
+
+		APlayerController* PlayerController = Cast<APlayerController>(Viewer.InViewer);
+		AErosSocialPlayerState* PlayerState = PlayerController ? PlayerController->GetPlayerState<AErosSocialPlayerState>() : nullptr;
+		if (!PlayerState)
+		{
+			continue;
+		}
+
+		// O próprio PlayerState não entra no rodízio
+		ReplicationActorList.Add(PlayerState);
+
+		// Partner e amigos: relevantes a qualquer distância
+		AddSocialTarget(PlayerState->GetPartner(), Params);
+		for (const FErosUserId& FriendUserID : PlayerState->FriendsList)
+		{
+			AddSocialTarget(Graph->FindPlayerStateByUserId(FriendUserID), Params);
+		}
+	}
+
+	FErosRepGraphConnectionStats& Stats = Graph->GetMutableConnectionStats(Params.ConnectionManager.NetConnection);
+	Stats.NumSocialActors = ReplicationActorList.Num();
+	Stats.OutBytesPerSecond = Params.ConnectionManager.NetConnection ? Params.ConnectionManager.NetConnection->OutBytesPerSecond : 0;
+	Stats.LastReplicationFrame = Params.ReplicationFrameNum;
+	INC_DWORD_STAT_BY(STAT_ErosRep_SocialActors, Stats.NumSocialActors);
+
+	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorList);
+}
+
+void UErosReplicationGraphNode_SocialRelevant::AddSocialTarget(AErosSocialPlayerState* Target, const FConnectionGatherActorListParameters& Params)
+{
+	if (!Target)
+	{
+		return;
+	}
+
+	FGlobalActorReplicationInfoMap& GlobalMap = *GraphGlobals->GlobalActorReplicationInfoMap;
+
+	ReplicationActorList.Add(Target);
+
+	if (APawn* TargetPawn = Target->GetPawn())
+	{
+		// Sem cull de distância e fora dos buckets do grid de avatares (que roda antes)
+		FConnectionReplicationActorInfo& ConnectionInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(TargetPawn);
+		ConnectionInfo.SetCullDistanceSquared(0.0f);
+
+		// Taxa do UErosNetUpdateRateManager (dono do pin do partner: taxa cheia com o casal perto)
+		ConnectionInfo.ReplicationPeriodFrame = GlobalMap.Get(TargetPawn).Settings.ReplicationPeriodFrame;
+
+		ReplicationActorList.Add(TargetPawn);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+
+static void ErosRepGraphPrintConnectionStats(const TArray<FString>& Args, UWorld* World)
+{
+	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	const UErosSocialReplicationGraph* Graph = NetDriver ? Cast<UErosSocialReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+	if (!Graph)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Eros.RepGraph.PrintConnectionStats - No ErosSocialReplicationGraph on this world"));
+		return;
+	}
+
+	for (const TPair<UNetConnection*, FErosRepGraphConnectionStats>& Pair : Graph->GetAllConnectionStats())
+	{
+		const FErosRepGraphConnectionStats& Stats = Pair.Value;
+		UE_LOG(LogTemp, Log, TEXT("%s: near %d, mid %d, far %d, social %d, %d B/s (frame %u)"),
+			*GetNameSafe(Pair.Key ? Pair.Key->PlayerController : nullptr),
+			Stats.NumNearAvatars, Stats.NumMidAvatars, Stats.NumFarAvatars, Stats.NumSocialActors,
+			Stats.OutBytesPerSecond, Stats.LastReplicationFrame);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ErosRepGraphPrintConnectionStatsCmd(
+	TEXT("Eros.RepGraph.PrintConnectionStats"),
+	TEXT("Mostra o custo de replicação por conexão (avatares por bucket, atores sociais, bytes/s)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ErosRepGraphPrintConnectionStats));
+
+/**
+ * Compara o tempo de replicação com todos acordados e com uma fração dos jogadores dormentes
+ * Uso: Eros.Net.IdleBenchmark [PercentIdle=80] [SampleSeconds=10] (servidor, com clientes conectados)
+ */
+static void ErosNetIdleBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	UErosSocialReplicationGraph* Graph = NetDriver ? Cast<UErosSocialReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+	AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (!Graph || !GameState)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Eros.Net.IdleBenchmark - Must run on a server using ErosSocialReplicationGraph"));
+		return;
+	}
+
+	const float PercentIdle = Args.Num() > 0 ? FMath::Clamp(FCString::Atof(*Args[0]), 0.0f, 100.0f) : 80.0f;
+	const float SampleSeconds = Args.Num() > 1 ? FMath::Max(1.0f, FCString::Atof(*Args[1])) : 10.0f;
+
+	TArray<TWeakObjectPtr<AErosSocialPlayerState>> Players;
+	for (APlayerState* PlayerState : GameState->PlayerArray)
+	{
+		if (AErosSocialPlayerState* ErosPlayerState = Cast<AErosSocialPlayerState>(PlayerState))
+		{
+			ErosPlayerState->WakeFromNetIdle();
+			Players.Add(ErosPlayerState);
+		}
+	}
+
+	const int32 NumToIdle = FMath::RoundToInt(Players.Num() * PercentIdle / 100.0f);
+
+	UE_LOG(LogTemp, Log, TEXT("Eros.Net.IdleBenchmark - %d players, sampling %.0fs awake then %.0fs with %d idle"),
+		Players.Num(), SampleSeconds, SampleSeconds, NumToIdle);
+
+	Graph->ResetReplicateActorsTiming();
+
+	TWeakObjectPtr<UErosSocialReplicationGraph> WeakGraph(Graph);
+	double PhaseStartTime = FPlatformTime::Seconds();
+	double AwakeMs = 0.0;
+	bool bIdlePhase = false;
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[WeakGraph, Players, NumToIdle, SampleSeconds, PhaseStartTime, AwakeMs, bIdlePhase](float DeltaTime) mutable
+		{
+			UErosSocialReplicationGraph* Graph = WeakGraph.Get();
+			if (!Graph)
+			{
+				return false;
+			}
+
+			if (FPlatformTime::Seconds() - PhaseStartTime < SampleSeconds)
+			{
+				return true;
+			}
+
+			if (!bIdlePhase)
+			{
+				AwakeMs = Graph->GetAverageReplicateActorsMs();
+
+				for (int32 Index = 0; Index < NumToIdle; ++Index)
+				{
+					if (AErosSocialPlayerState* ErosPlayerState = Players[Index].Get())
+					{
+						ErosPlayerState->EnterNetIdle();
+					}
+				}
+
+				Graph->ResetReplicateActorsTiming();
+				PhaseStartTime = FPlatformTime::Seconds();
+				bIdlePhase = true;
+				return true;
+			}
+
+			const double IdleMs = Graph->GetAverageReplicateActorsMs();
+			UE_LOG(LogTemp, Log, TEXT("Eros.Net.IdleBenchmark - ServerReplicateActors avg: %.3f ms awake, %.3f ms with %d/%d idle (%.1f%%)"),
+				AwakeMs, IdleMs, NumToIdle, Players.Num(), AwakeMs > 0.0 ? 100.0 * IdleMs / AwakeMs : 0.0);
+
+			// Jogadores realmente ativos voltam a replicar no próximo input; os demais seguem a regra normal de inatividade
+			for (int32 Index = 0; Index < NumToIdle; ++Index)
+			{
+				if (AErosSocialPlayerState* ErosPlayerState = Players[Index].Get())
+				{
+					ErosPlayerState->WakeFromNetIdle();
+				}
+			}
+
+			return false;
+		}));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ErosNetIdleBenchmarkCmd(
+	TEXT("Eros.Net.IdleBenchmark"),
+	TEXT("Mede ServerReplicateActors com todos acordados e com uma fração dos jogadores dormentes. Args: [PercentIdle=80] [SampleSeconds=10]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ErosNetIdleBenchmark));
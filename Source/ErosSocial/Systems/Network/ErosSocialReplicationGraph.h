@@ -0,0 +1,225 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosSocialReplicationGraph.h
+// Replication Graph do hub social
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "ErosUserId.h"
+#include "ErosSocialReplicationGraph.generated.h"
+
+class AErosSocialPlayerState;
+class UErosReplicationGraphNode_AvatarGrid;
+class UErosReplicationGraphNode_PlayerStates;
+
+/**
+ * Custo de replicação de uma conexão no último frame de rede
+ */
+struct FErosRepGraphConnectionStats
+{
+	// Avatares perto do viewer (taxa da classe)
+	int32 NumNearAvatars = 0;
+
+	// Avatares a meia distância (bucket intermediário)
+	int32 NumMidAvatars = 0;
+
+	// Avatares distantes (bucket mais lento)
+	int32 NumFarAvatars = 0;
+
+	// Partner e amigos (sempre relevantes)
+	int32 NumSocialActors = 0;
+
+	int32 OutBytesPerSecond = 0;
+
+	uint32 LastReplicationFrame = 0;
+};
+
+/**
+ * Replication Graph do hub
+ * - Grid espacial próprio para AErosSocialCharacter, com buckets de frequência por distância
+ * - PlayerStates replicados em subconjuntos rotativos
+ * - Nó por conexão que mantém partner e amigos sempre relevantes
+ * - Demais atores no grid espacial padrão do engine
+ */
+UCLASS(Transient, config = Engine)
+class EROSSOCIAL_API UErosSocialReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	UErosSocialReplicationGraph();
+
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual void RemoveClientConnection(UNetConnection* NetConnection) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	/**
+	 * Procura o PlayerState de um usuário (tabela reconstruída uma vez por frame de rede)
+	 */
+	AErosSocialPlayerState* FindPlayerStateByUserId(const FErosUserId& UserId) const;
+
+	/**
+	 * Troca a frequência de replicação de um ator já registrado (taxa adaptativa dos avatares)
+	 * Os buckets de distância do grid de avatares continuam valendo por cima dela
+	 */
+	void SetActorReplicationFrequency(AActor* Actor, float Frequency);
+
+	/**
+	 * Stats de custo por conexão (preenchidos pelos nós durante o gather)
+	 */
+	FErosRepGraphConnectionStats& GetMutableConnectionStats(UNetConnection* NetConnection) { return ConnectionStats.FindOrAdd(NetConnection); }
+
+	const TMap<UNetConnection*, FErosRepGraphConnectionStats>& GetAllConnectionStats() const { return ConnectionStats; }
+
+	/**
+	 * Tempo médio de ServerReplicateActors (ms) desde o último reset
+	 */
+	double GetAverageReplicateActorsMs() const { return ReplicateActorsFrames > 0 ? ReplicateActorsSeconds * 1000.0 / ReplicateActorsFrames : 0.0; }
+
+	void ResetReplicateActorsTiming() { ReplicateActorsSeconds = 0.0; ReplicateActorsFrames = 0; }
+
+	/** Tempo de ServerReplicateActors (ms) no último frame de rede */
+	double GetLastReplicateActorsMs() const { return LastReplicateActorsSeconds * 1000.0; }
+
+	// ========== CONFIGURAÇÃO (DefaultEngine.ini) ==========
+
+	// Célula do grid padrão (atores que não são avatares)
+	UPROPERTY(Config)
+	float GridCellSize = 10000.0f;
+
+	// Célula do grid de avatares
+	UPROPERTY(Config)
+	float AvatarCellSize = 2000.0f;
+
+	// Até aqui o avatar replica na taxa da classe
+	UPROPERTY(Config)
+	float AvatarNearDistance = 1500.0f;
+
+	// Até aqui usa o bucket intermediário; depois, o bucket distante
+	UPROPERTY(Config)
+	float AvatarMidDistance = 4000.0f;
+
+	// Além disso o avatar não é relevante (exceto partner/amigos)
+	UPROPERTY(Config)
+	float AvatarCullDistance = 8000.0f;
+
+	// Período (em frames de rede) do bucket intermediário
+	UPROPERTY(Config)
+	int32 AvatarMidPeriodFrames = 2;
+
+	// Período (em frames de rede) do bucket distante
+	UPROPERTY(Config)
+	int32 AvatarFarPeriodFrames = 4;
+
+	// PlayerStates de terceiros replicados por frame
+	UPROPERTY(Config)
+	int32 MaxPlayerStatesPerFrame = 32;
+
+protected:
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	UPROPERTY()
+	TObjectPtr<UErosReplicationGraphNode_AvatarGrid> AvatarNode;
+
+	UPROPERTY()
+	TObjectPtr<UErosReplicationGraphNode_PlayerStates> PlayerStateNode;
+
+	TMap<UNetConnection*, FErosRepGraphConnectionStats> ConnectionStats;
+
+	double ReplicateActorsSeconds = 0.0;
+	double LastReplicateActorsSeconds = 0.0;
+	int32 ReplicateActorsFrames = 0;
+};
+
+/**
+ * Grid espacial dos avatares
+ * Todos os avatares dentro do cull são coletados todo frame (o canal não fecha),
+ * mas o período de replicação por conexão cresce com a distância
+ */
+UCLASS()
+class EROSSOCIAL_API UErosReplicationGraphNode_AvatarGrid : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UErosReplicationGraphNode_AvatarGrid();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	float CellSize = 2000.0f;
+	float NearDistance = 1500.0f;
+	float MidDistance = 4000.0f;
+	float CullDistance = 8000.0f;
+	uint8 MidPeriodFrames = 2;
+	uint8 FarPeriodFrames = 4;
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+
+	FActorRepListRefView Avatars;
+
+	// Reconstruído em PrepareForReplication; as listas mantêm a memória entre frames
+	TMap<FIntPoint, TArray<AActor*>> Cells;
+
+	// Lista de saída reaproveitada (o gather é sequencial por conexão)
+	FActorRepListRefView GatheredAvatars;
+};
+
+/**
+ * PlayerStates de terceiros em subconjuntos rotativos
+ * Também mantém a tabela UserId -> PlayerState usada pelo nó social
+ */
+UCLASS()
+class EROSSOCIAL_API UErosReplicationGraphNode_PlayerStates : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UErosReplicationGraphNode_PlayerStates();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	AErosSocialPlayerState* FindByUserId(const FErosUserId& UserId) const;
+
+	int32 MaxPerFrame = 32;
+
+private:
+	TArray<AErosSocialPlayerState*> PlayerStates;
+
+	TArray<FActorRepListRefView> Chunks;
+
+	TMap<FErosUserId, AErosSocialPlayerState*> PlayerStatesByUserId;
+};
+
+/**
+ * Nó por conexão: controller, view target, o próprio PlayerState,
+ * partner e amigos (pawn + PlayerState), sempre relevantes e fora do bucket de distância
+ */
+UCLASS()
+class EROSSOCIAL_API UErosReplicationGraphNode_SocialRelevant : public UReplicationGraphNode_AlwaysRelevant_ForConnection
+{
+	GENERATED_BODY()
+
+public:
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+	void AddSocialTarget(AErosSocialPlayerState* Target, const FConnectionGatherActorListParameters& Params);
+};
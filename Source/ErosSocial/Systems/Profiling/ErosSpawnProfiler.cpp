@@ -0,0 +1,263 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosSpawnProfiler.cpp
+
+#include "Systems/Profiling/ErosSpawnProfiler.h"
+#include "ErosSocialCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+LLM_DEFINE_TAG(ErosCharacter);
+
+namespace ErosSpawnProfiler
+{
+	struct FStageTotals
+	{
+		int64 Calls = 0;
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+		int64 Objects = 0;
+		int64 MemoryBytes = 0;
+	};
+
+	// Só game thread
+	static bool bCapturing = false;
+	static FStageTotals StageTotals[static_cast<int32>(EErosSpawnStage::Count)];
+
+	const TCHAR* GetStageName(EErosSpawnStage Stage)
+	{
+		switch (Stage)
+		{
+			case EErosSpawnStage::SpawnActor: return TEXT("SpawnActor");
+			case EErosSpawnStage::BeginPlay: return TEXT("BeginPlay");
+			case EErosSpawnStage::ClothingInit: return TEXT("ClothingInit");
+			case EErosSpawnStage::MorphSetup: return TEXT("MorphSetup");
+			case EErosSpawnStage::PossessedBy: return TEXT("PossessedBy");
+			case EErosSpawnStage::SyncWithPlayerState: return TEXT("SyncWithPlayerState");
+			case EErosSpawnStage::InitializeCharacter: return TEXT("InitializeCharacter");
+			case EErosSpawnStage::BodyCustomization: return TEXT("BodyCustomization");
+			case EErosSpawnStage::AppearanceCustomization: return TEXT("AppearanceCustomization");
+			case EErosSpawnStage::Outfit: return TEXT("Outfit");
+			default: return TEXT("Unknown");
+		}
+	}
+
+	void BeginCapture()
+	{
+		check(IsInGameThread());
+		for (FStageTotals& Totals : StageTotals)
+		{
+			Totals = FStageTotals();
+		}
+		bCapturing = true;
+	}
+
+	void EndCapture()
+	{
+		bCapturing = false;
+	}
+
+	bool IsCapturing()
+	{
+		return bCapturing;
+	}
+
+	void ReportCapture(int32 PerCharacterDivisor)
+	{
+		const double Divisor = FMath::Max(PerCharacterDivisor, 1);
+
+		TArray<FString> Lines;
+		Lines.Add(TEXT("Stage,Calls,TotalMs,AvgMs,MaxMs,MsPerCharacter,UObjectsPerCharacter,KBPerCharacter"));
+
+		UE_LOG(LogTemp, Log, TEXT("ErosSpawnProfiler - %d characters"), PerCharacterDivisor);
+		UE_LOG(LogTemp, Log, TEXT("%-24s %6s %10s %8s %8s %10s %10s %10s"),
+			TEXT("Stage"), TEXT("Calls"), TEXT("Total ms"), TEXT("Avg ms"), TEXT("Max ms"), TEXT("ms/char"), TEXT("UObj/char"), TEXT("KB/char"));
+
+		for (int32 Index = 0; Index < static_cast<int32>(EErosSpawnStage::Count); ++Index)
+		{
+			const FStageTotals& Totals = StageTotals[Index];
+			const TCHAR* StageName = GetStageName(static_cast<EErosSpawnStage>(Index));
+			const double TotalMs = Totals.TotalSeconds * 1000.0;
+			const double AvgMs = Totals.Calls > 0 ? TotalMs / Totals.Calls : 0.0;
+			const double MaxMs = Totals.MaxSeconds * 1000.0;
+			const double ObjectsPerCharacter = Totals.Objects / Divisor;
+			const double KBPerCharacter = Totals.MemoryBytes / 1024.0 / Divisor;
+
+			UE_LOG(LogTemp, Log, TEXT("%-24s %6lld %10.3f %8.3f %8.3f %10.3f %10.1f %10.1f"),
+				StageName, Totals.Calls, TotalMs, AvgMs, MaxMs, TotalMs / Divisor, ObjectsPerCharacter, KBPerCharacter);
+			Lines.Add(FString::Printf(TEXT("%s,%lld,%.3f,%.3f,%.3f,%.3f,%.2f,%.2f"),
+				StageName, Totals.Calls, TotalMs, AvgMs, MaxMs, TotalMs / Divisor, ObjectsPerCharacter, KBPerCharacter));
+		}
+
+		const FString FilePath = FPaths::ProfilingDir() / TEXT("ErosSpawn") / FString::Printf(TEXT("ErosSpawnBench_%s.csv"), *FDateTime::Now().ToString());
+		if (!FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("ErosSpawnProfiler::ReportCapture - Failed to write %s"), *FilePath);
+			return;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("ErosSpawnProfiler::ReportCapture - Saved %s"), *FilePath);
+	}
+
+	FStageScope::FStageScope(EErosSpawnStage InStage)
+		: Stage(InStage)
+		, bActive(bCapturing && IsInGameThread())
+	{
+		if (bActive)
+		{
+			// Memória do processo: inclui ruído de outras threads, serve para ordem de grandeza
+			StartMemory = FPlatformMemory::GetStats().UsedPhysical;
+			StartObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+			StartTime = FPlatformTime::Seconds();
+		}
+	}
+
+	FStageScope::~FStageScope()
+	{
+		if (!bActive)
+		{
+			return;
+		}
+
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		FStageTotals& Totals = StageTotals[static_cast<int32>(Stage)];
+		++Totals.Calls;
+		Totals.TotalSeconds += Elapsed;
+		Totals.MaxSeconds = FMath::Max(Totals.MaxSeconds, Elapsed);
+		Totals.Objects += GUObjectArray.GetObjectArrayNumMinusAvailable() - StartObjects;
+		Totals.MemoryBytes += static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(StartMemory);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Benchmark
+
+namespace
+{
+	// Mesma seed em toda execução: resultados comparáveis entre builds
+	FCharacterSaveData MakeBenchmarkCharacter(FRandomStream& Random, int32 Index)
+	{
+		FCharacterSaveData Data;
+		Data.CharacterName = FString::Printf(TEXT("SpawnBench_%d"), Index);
+		Data.CharacterGender = Random.FRand() < 0.5f ? ECharacterGender::Male : ECharacterGender::Female;
+
+		FBodyCustomization& Body = Data.BodyCustomization;
+		Body.BreastSize = Random.FRand();
+		Body.ButtSize = Random.FRand();
+		Body.Height = Random.FRand();
+		Body.Weight = Random.FRand();
+		Body.Muscle = Random.FRand();
+
+		FAppearanceCustomization& Appearance = Data.AppearanceCustomization;
+		Appearance.SkinColor = FLinearColor(Random.FRand(), Random.FRand(), Random.FRand());
+		Appearance.HairColor = FLinearColor(Random.FRand(), Random.FRand(), Random.FRand());
+		Appearance.EyeColor = FLinearColor(Random.FRand(), Random.FRand(), Random.FRand());
+		Appearance.MakeupColor = FLinearColor(Random.FRand(), Random.FRand(), Random.FRand());
+		Appearance.bHasMakeup = Random.FRand() < 0.5f;
+		Appearance.BodyHairDensity = Random.FRand();
+		Appearance.FaceMorphOverrides.Add(TEXT("Height"), Random.FRand());
+
+		static const TCHAR* OutfitSlots[] = { TEXT("Top"), TEXT("Bottom"), TEXT("Shoes"), TEXT("Hat") };
+		for (const TCHAR* SlotName : OutfitSlots)
+		{
+			FClothingItemData& Item = Data.CurrentOutfit.AddDefaulted_GetRef();
+			Item.ItemID = FString::Printf(TEXT("bench_%s_%d"), SlotName, Random.RandRange(0, 9));
+			Item.SlotType = SlotName;
+			Item.Color = FLinearColor(Random.FRand(), Random.FRand(), Random.FRand());
+			Item.bEquipped = true;
+		}
+
+		return Data;
+	}
+}
+
+static void ErosSpawnBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Eros.Character.SpawnBenchmark - Must run with authority (standalone or server)"));
+		return;
+	}
+
+	const int32 NumCharacters = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 50;
+	const bool bKeep = Args.Num() > 1 && FCString::ToBool(*Args[1]);
+
+	// Pawn do GameMode se for um AErosSocialCharacter (Blueprint com mesh e tabela de morphs)
+	UClass* CharacterClass = AErosSocialCharacter::StaticClass();
+	if (const AGameModeBase* GameMode = World->GetAuthGameMode())
+	{
+		if (GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(AErosSocialCharacter::StaticClass()))
+		{
+			CharacterClass = GameMode->DefaultPawnClass;
+		}
+	}
+
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	const FVector Origin = PlayerController && PlayerController->GetPawn()
+		? PlayerController->GetPawn()->GetActorLocation() + FVector(300.0f, 0.0f, 0.0f)
+		: FVector::ZeroVector;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	FRandomStream Random(1337);
+	TArray<AErosSocialCharacter*> Spawned;
+	Spawned.Reserve(NumCharacters);
+
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumCharacters)));
+
+	ErosSpawnProfiler::BeginCapture();
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		const FCharacterSaveData CharacterData = MakeBenchmarkCharacter(Random, Index);
+		const FVector Location = Origin + FVector((Index / GridSize) * 150.0f, (Index % GridSize) * 150.0f, 0.0f);
+
+		AErosSocialCharacter* Character = nullptr;
+		{
+			// Inclui o BeginPlay (mundo já rodando)
+			EROS_SPAWN_STAGE_SCOPE(SpawnActor);
+			Character = World->SpawnActor<AErosSocialCharacter>(CharacterClass, FTransform(Location), SpawnParams);
+		}
+
+		if (!Character)
+		{
+			continue;
+		}
+
+		// AIController: passa por PossessedBy sem depender de conexão
+		Character->SpawnDefaultController();
+		Character->InitializeCharacter(CharacterData);
+		Spawned.Add(Character);
+	}
+
+	const double TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	ErosSpawnProfiler::EndCapture();
+
+	UE_LOG(LogTemp, Log, TEXT("Eros.Character.SpawnBenchmark - %d %s spawned in %.2f ms (%.3f ms/character)"),
+		Spawned.Num(), *CharacterClass->GetName(), TotalMs, TotalMs / FMath::Max(Spawned.Num(), 1));
+	ErosSpawnProfiler::ReportCapture(Spawned.Num());
+
+	if (!bKeep)
+	{
+		for (AErosSocialCharacter* Character : Spawned)
+		{
+			if (AController* Controller = Character->GetController())
+			{
+				Controller->Destroy();
+			}
+			Character->Destroy();
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ErosSpawnBenchmarkCmd(
+	TEXT("Eros.Character.SpawnBenchmark"),
+	TEXT("Spawna N personagens customizados e loga o custo por etapa (tempo, UObjects, memória). Args: [Characters=50] [Keep=0]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ErosSpawnBenchmark));
@@ -0,0 +1,70 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosSpawnProfiler.h
+// Custo por etapa do spawn e da inicialização dos personagens (trace, LLM e benchmark)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// Memória alocada no spawn e na customização dos personagens ("stat LLM" / -llm)
+LLM_DECLARE_TAG_API(ErosCharacter, EROSSOCIAL_API);
+
+/**
+ * Etapas do caminho de spawn (algumas aninhadas: InitializeCharacter contém corpo, aparência e outfit)
+ */
+enum class EErosSpawnStage : uint8
+{
+	SpawnActor,
+	BeginPlay,
+	ClothingInit,
+	MorphSetup,
+	PossessedBy,
+	SyncWithPlayerState,
+	InitializeCharacter,
+	BodyCustomization,
+	AppearanceCustomization,
+	Outfit,
+	Count
+};
+
+/**
+ * Coleta por etapa: chamadas, tempo (total e máximo), UObjects criados e memória (aprox.)
+ * - Os trace scopes ("ErosSpawn_<Etapa>" no Unreal Insights) e a tag LLM ficam sempre ativos
+ * - Os totais só são coletados entre BeginCapture e EndCapture (game thread)
+ *
+ * Benchmark: Eros.Character.SpawnBenchmark [Personagens] [Manter]
+ * Spawna N personagens com customização e outfit aleatórios (seed fixa), loga a tabela por etapa
+ * e grava Saved/Profiling/ErosSpawn/ErosSpawnBench_<data>.csv
+ */
+namespace ErosSpawnProfiler
+{
+	EROSSOCIAL_API const TCHAR* GetStageName(EErosSpawnStage Stage);
+
+	EROSSOCIAL_API void BeginCapture();
+	EROSSOCIAL_API void EndCapture();
+	EROSSOCIAL_API bool IsCapturing();
+
+	/** Loga a tabela por etapa e grava o CSV; PerCharacterDivisor = personagens do benchmark */
+	EROSSOCIAL_API void ReportCapture(int32 PerCharacterDivisor);
+
+	struct EROSSOCIAL_API FStageScope
+	{
+		explicit FStageScope(EErosSpawnStage InStage);
+		~FStageScope();
+
+	private:
+		EErosSpawnStage Stage;
+		bool bActive = false;
+		double StartTime = 0.0;
+		int32 StartObjects = 0;
+		uint64 StartMemory = 0;
+	};
+}
+
+/** Trace scope, tag LLM e coleta da etapa (uma por escopo) */
+#define EROS_SPAWN_STAGE_SCOPE(Stage) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(ErosSpawn_##Stage); \
+	LLM_SCOPE_BYTAG(ErosCharacter); \
+	ErosSpawnProfiler::FStageScope PREPROCESSOR_JOIN(ErosSpawnStageScope_, __LINE__)(EErosSpawnStage::Stage)
@@ -0,0 +1,276 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosProximitySubsystem.cpp
+
+#include "Systems/Proximity/ErosProximitySubsystem.h"
+#include "ErosSocialCharacter.h"
+#include "Engine/World.h"
+
+DECLARE_STATS_GROUP(TEXT("ErosSocial Proximity"), STATGROUP_ErosProximity, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Proximity Update"), STAT_ErosProximity_Update, STATGROUP_ErosProximity);
+DECLARE_CYCLE_STAT(TEXT("Proximity Query"), STAT_ErosProximity_Query, STATGROUP_ErosProximity);
+
+UErosProximitySubsystem::UErosProximitySubsystem()
+	: SpatialHash(1000.0f)
+{
+}
+
+UErosProximitySubsystem* UErosProximitySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosProximitySubsystem>() : nullptr;
+}
+
+bool UErosProximitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UErosProximitySubsystem::Deinitialize()
+{
+	for (FRegisteredCharacter& Entry : Registered)
+	{
+		if (USceneComponent* Root = Entry.Root.Get())
+		{
+			Root->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+		}
+	}
+
+	Registered.Reset();
+	HandlesByCharacter.Reset();
+	SpatialHash.Reset();
+
+	Super::Deinitialize();
+}
+
+void UErosProximitySubsystem::RegisterCharacter(AErosSocialCharacter* Character)
+{
+	USceneComponent* Root = Character ? Character->GetRootComponent() : nullptr;
+	if (!Root || HandlesByCharacter.Contains(Character))
+	{
+		return;
+	}
+
+	const int32 Handle = SpatialHash.Add(Character->GetActorLocation());
+	if (Registered.Num() <= Handle)
+	{
+		Registered.SetNum(Handle + 1);
+	}
+
+	FRegisteredCharacter& Entry = Registered[Handle];
+	Entry.Character = Character;
+	Entry.Root = Root;
+	Entry.TransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &UErosProximitySubsystem::OnCharacterMoved, Handle);
+
+	HandlesByCharacter.Add(Character, Handle);
+
+	NotifySegmentWatch(Character, Character->GetActorLocation());
+}
+
+void UErosProximitySubsystem::UnregisterCharacter(AErosSocialCharacter* Character)
+{
+	int32 Handle = INDEX_NONE;
+	if (!HandlesByCharacter.RemoveAndCopyValue(Character, Handle))
+	{
+		return;
+	}
+
+	NotifySegmentWatch(Character, Character->GetActorLocation());
+
+	FRegisteredCharacter& Entry = Registered[Handle];
+	if (USceneComponent* Root = Entry.Root.Get())
+	{
+		Root->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+	}
+	Entry = FRegisteredCharacter();
+
+	SpatialHash.Remove(Handle);
+}
+
+void UErosProximitySubsystem::OnCharacterMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 Handle)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosProximity_Update);
+
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	SpatialHash.Update(Handle, Location);
+
+	if (SegmentWatch.bActive && !SegmentWatch.bMoved)
+	{
+		NotifySegmentWatch(Registered[Handle].Character.Get(), Location);
+	}
+}
+
+void UErosProximitySubsystem::WatchSegment(const FVector& Start, const FVector& End, float Radius, const AActor* IgnoreActor, const AActor* WatchedActor)
+{
+	SegmentWatch.Start = Start;
+	SegmentWatch.End = End;
+	SegmentWatch.RadiusSq = FMath::Square(Radius);
+	SegmentWatch.IgnoreActor = IgnoreActor;
+	SegmentWatch.WatchedActor = WatchedActor;
+	SegmentWatch.bActive = true;
+	SegmentWatch.bMoved = false;
+}
+
+bool UErosProximitySubsystem::ConsumeSegmentMovement()
+{
+	const bool bMoved = SegmentWatch.bMoved;
+	SegmentWatch.bMoved = false;
+	return bMoved;
+}
+
+void UErosProximitySubsystem::NotifySegmentWatch(const AErosSocialCharacter* Character, const FVector& Location)
+{
+	if (!SegmentWatch.bActive || !Character || Character == SegmentWatch.IgnoreActor.Get())
+	{
+		return;
+	}
+
+	if (Character == SegmentWatch.WatchedActor.Get()
+		|| FMath::PointDistToSegmentSquared(Location, SegmentWatch.Start, SegmentWatch.End) <= SegmentWatch.RadiusSq)
+	{
+		SegmentWatch.bMoved = true;
+	}
+}
+
+void UErosProximitySubsystem::QueryRadius(const FVector& Center, float Radius, TArray<AErosSocialCharacter*>& OutCharacters, const AActor* IgnoreActor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosProximity_Query);
+
+	const int32* IgnoreHandle = HandlesByCharacter.Find(Cast<AErosSocialCharacter>(IgnoreActor));
+	SpatialHash.QueryRadius(Center, Radius, QueryScratch, IgnoreHandle ? *IgnoreHandle : INDEX_NONE);
+
+	OutCharacters.Reset(QueryScratch.Num());
+	for (const int32 Handle : QueryScratch)
+	{
+		if (AErosSocialCharacter* Character = Registered[Handle].Character.Get())
+		{
+			OutCharacters.Add(Character);
+		}
+	}
+}
+
+void UErosProximitySubsystem::QueryNearest(const FVector& Center, int32 Count, float MaxRadius, TArray<AErosSocialCharacter*>& OutCharacters, const AActor* IgnoreActor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosProximity_Query);
+
+	const int32* IgnoreHandle = HandlesByCharacter.Find(Cast<AErosSocialCharacter>(IgnoreActor));
+	SpatialHash.QueryKNearest(Center, Count, MaxRadius, QueryScratch, IgnoreHandle ? *IgnoreHandle : INDEX_NONE);
+
+	OutCharacters.Reset(QueryScratch.Num());
+	for (const int32 Handle : QueryScratch)
+	{
+		if (AErosSocialCharacter* Character = Registered[Handle].Character.Get())
+		{
+			OutCharacters.Add(Character);
+		}
+	}
+}
+
+TArray<AErosSocialCharacter*> UErosProximitySubsystem::GetCharactersInRadius(FVector Center, float Radius, AActor* IgnoreActor) const
+{
+	TArray<AErosSocialCharacter*> Characters;
+	QueryRadius(Center, Radius, Characters, IgnoreActor);
+	return Characters;
+}
+
+TArray<AErosSocialCharacter*> UErosProximitySubsystem::GetNearestCharacters(FVector Center, int32 Count, float MaxRadius, AActor* IgnoreActor) const
+{
+	TArray<AErosSocialCharacter*> Characters;
+	QueryNearest(Center, Count, MaxRadius, Characters, IgnoreActor);
+	return Characters;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+
+/**
+ * Compara o hash com busca linear em 1k e 10k pontos sintéticos (sem spawnar atores)
+ * Uso: Eros.Proximity.Benchmark [Queries=1000] [Radius=1500]
+ */
+static void ErosProximityBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumQueries = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+	const float Radius = Args.Num() > 1 ? FMath::Max(1.0f, FCString::Atof(*Args[1])) : 1500.0f;
+	const int32 K = 8;
+
+	for (const int32 NumEntities : { 1000, 10000 })
+	{
+		FRandomStream Random(1337);
+
+		// Densidade parecida com um hub lotado: ~1 personagem a cada 200x200
+		const float HalfExtent = FMath::Sqrt(static_cast<float>(NumEntities)) * 100.0f;
+		auto RandomLocation = [&Random, HalfExtent]()
+		{
+			return FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0f);
+		};
+
+		TArray<FVector> Locations;
+		Locations.Reserve(NumEntities);
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			Locations.Add(RandomLocation());
+		}
+
+		FErosSpatialHash Hash(1000.0f);
+		double StartTime = FPlatformTime::Seconds();
+		for (const FVector& Location : Locations)
+		{
+			Hash.Add(Location);
+		}
+		const double BuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+		// Todos andam um passo (a maioria continua na mesma célula)
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Handle = 0; Handle < NumEntities; ++Handle)
+		{
+			Locations[Handle] += FVector(Random.FRandRange(-50.0f, 50.0f), Random.FRandRange(-50.0f, 50.0f), 0.0f);
+			Hash.Update(Handle, Locations[Handle]);
+		}
+		const double UpdateSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TArray<FVector> Centers;
+		for (int32 Index = 0; Index < NumQueries; ++Index)
+		{
+			Centers.Add(RandomLocation());
+		}
+
+		TArray<int32> Results;
+		int64 HashFound = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (const FVector& Center : Centers)
+		{
+			Hash.QueryRadius(Center, Radius, Results);
+			HashFound += Results.Num();
+		}
+		const double RadiusSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (const FVector& Center : Centers)
+		{
+			Hash.QueryKNearest(Center, K, Radius * 4.0f, Results);
+		}
+		const double NearestSeconds = FPlatformTime::Seconds() - StartTime;
+
+		int64 LinearFound = 0;
+		const float RadiusSq = Radius * Radius;
+		StartTime = FPlatformTime::Seconds();
+		for (const FVector& Center : Centers)
+		{
+			for (const FVector& Location : Locations)
+			{
+				LinearFound += FVector::DistSquared(Location, Center) <= RadiusSq ? 1 : 0;
+			}
+		}
+		const double LinearSeconds = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogTemp, Log, TEXT("Eros.Proximity.Benchmark - %d entities: build %.2f ms, update all %.2f ms, radius %.2f us/query (linear %.2f us), %d-nearest %.2f us/query%s"),
+			NumEntities, BuildSeconds * 1e3, UpdateSeconds * 1e3,
+			RadiusSeconds * 1e6 / NumQueries, LinearSeconds * 1e6 / NumQueries,
+			K, NearestSeconds * 1e6 / NumQueries,
+			HashFound == LinearFound ? TEXT("") : TEXT(" [MISMATCH vs linear]"));
+	}
+}
+
+static FAutoConsoleCommand ErosProximityBenchmarkCmd(
+	TEXT("Eros.Proximity.Benchmark"),
+	TEXT("Mede o hash espacial de proximidade com 1k e 10k pontos. Args: [Queries=1000] [Radius=1500]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ErosProximityBenchmark));
@@ -0,0 +1,110 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosProximitySubsystem.h
+// Consultas de proximidade entre personagens
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "Systems/Proximity/ErosSpatialHash.h"
+#include "ErosProximitySubsystem.generated.h"
+
+class AErosSocialCharacter;
+
+/**
+ * Posições de todos os AErosSocialCharacter num hash espacial uniforme
+ * Os personagens se registram no BeginPlay e o hash é atualizado pelo TransformUpdated
+ * do root component, então as consultas nunca iteram todos os atores.
+ * Usado por menu de interação, pedidos de partner e raio do chat.
+ */
+UCLASS()
+class EROSSOCIAL_API UErosProximitySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UErosProximitySubsystem();
+
+	static UErosProximitySubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+
+	void RegisterCharacter(AErosSocialCharacter* Character);
+	void UnregisterCharacter(AErosSocialCharacter* Character);
+
+	// ========== CONSULTAS ==========
+
+	/**
+	 * Personagens a até Radius de Center (sem ordem)
+	 */
+	void QueryRadius(const FVector& Center, float Radius, TArray<AErosSocialCharacter*>& OutCharacters, const AActor* IgnoreActor = nullptr) const;
+
+	/**
+	 * Até Count personagens mais próximos de Center dentro de MaxRadius, do mais próximo ao mais distante
+	 */
+	void QueryNearest(const FVector& Center, int32 Count, float MaxRadius, TArray<AErosSocialCharacter*>& OutCharacters, const AActor* IgnoreActor = nullptr) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Proximity", meta = (AdvancedDisplay = "IgnoreActor"))
+	TArray<AErosSocialCharacter*> GetCharactersInRadius(FVector Center, float Radius, AActor* IgnoreActor = nullptr) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Proximity", meta = (AdvancedDisplay = "IgnoreActor"))
+	TArray<AErosSocialCharacter*> GetNearestCharacters(FVector Center, int32 Count = 8, float MaxRadius = 5000.0f, AActor* IgnoreActor = nullptr) const;
+
+	UFUNCTION(BlueprintPure, Category = "Proximity")
+	int32 GetNumCharacters() const { return SpatialHash.Num(); }
+
+	// ========== SEGMENTO OBSERVADO ==========
+
+	/**
+	 * Observa um segmento (raio do cursor do jogador local; um por mundo)
+	 * Personagem que se move, entra ou sai a até Radius dele, ou o WatchedActor em qualquer lugar,
+	 * marca movimento no próprio TransformUpdated: quem observa não precisa iterar os personagens
+	 */
+	void WatchSegment(const FVector& Start, const FVector& End, float Radius, const AActor* IgnoreActor, const AActor* WatchedActor);
+
+	void ClearSegmentWatch() { SegmentWatch = FSegmentWatch(); }
+
+	/** Houve movimento perto do segmento desde a última chamada */
+	bool ConsumeSegmentMovement();
+
+private:
+	struct FSegmentWatch
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		float RadiusSq = 0.0f;
+		TWeakObjectPtr<const AActor> IgnoreActor;
+		TWeakObjectPtr<const AActor> WatchedActor;
+		bool bActive = false;
+		bool bMoved = false;
+	};
+
+	void OnCharacterMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 Handle);
+
+	void NotifySegmentWatch(const AErosSocialCharacter* Character, const FVector& Location);
+
+	struct FRegisteredCharacter
+	{
+		TWeakObjectPtr<AErosSocialCharacter> Character;
+		TWeakObjectPtr<USceneComponent> Root;
+		FDelegateHandle TransformUpdatedHandle;
+	};
+
+	FErosSpatialHash SpatialHash;
+
+	// Indexado pelo handle do hash
+	TArray<FRegisteredCharacter> Registered;
+
+	TMap<const AErosSocialCharacter*, int32> HandlesByCharacter;
+
+	// Reaproveitado pelas consultas (game thread)
+	mutable TArray<int32> QueryScratch;
+
+	FSegmentWatch SegmentWatch;
+};
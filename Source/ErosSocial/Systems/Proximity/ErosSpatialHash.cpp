@@ -0,0 +1,191 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosSpatialHash.cpp
+
+#include "Systems/Proximity/ErosSpatialHash.h"
+
+FErosSpatialHash::FErosSpatialHash(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0f))
+	, InvCellSize(1.0f / FMath::Max(InCellSize, 1.0f))
+{
+}
+
+FIntPoint FErosSpatialHash::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X * InvCellSize), FMath::FloorToInt(Location.Y * InvCellSize));
+}
+
+int32 FErosSpatialHash::Add(const FVector& Location)
+{
+	const int32 Handle = Entries.Add({ Location, GetCell(Location), INDEX_NONE });
+	AddToCell(Handle, Entries[Handle].Cell);
+	return Handle;
+}
+
+void FErosSpatialHash::Update(int32 Handle, const FVector& NewLocation)
+{
+	FEntry& Entry = Entries[Handle];
+	Entry.Location = NewLocation;
+
+	const FIntPoint NewCell = GetCell(NewLocation);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromCell(Handle);
+		AddToCell(Handle, NewCell);
+	}
+}
+
+void FErosSpatialHash::Remove(int32 Handle)
+{
+	RemoveFromCell(Handle);
+	Entries.RemoveAt(Handle);
+}
+
+void FErosSpatialHash::Reset()
+{
+	Entries.Reset();
+	Cells.Reset();
+}
+
+void FErosSpatialHash::AddToCell(int32 Handle, const FIntPoint& Cell)
+{
+	FEntry& Entry = Entries[Handle];
+	TArray<int32>& CellHandles = Cells.FindOrAdd(Cell);
+	Entry.Cell = Cell;
+	Entry.IndexInCell = CellHandles.Add(Handle);
+}
+
+void FErosSpatialHash::RemoveFromCell(int32 Handle)
+{
+	FEntry& Entry = Entries[Handle];
+	TArray<int32>* CellHandles = Cells.Find(Entry.Cell);
+	if (!CellHandles)
+	{
+		return;
+	}
+
+	// Swap-remove: o último da célula assume a posição do removido
+	const int32 LastHandle = CellHandles->Last();
+	(*CellHandles)[Entry.IndexInCell] = LastHandle;
+	Entries[LastHandle].IndexInCell = Entry.IndexInCell;
+	CellHandles->Pop(EAllowShrinking::No);
+
+	if (CellHandles->Num() == 0)
+	{
+		Cells.Remove(Entry.Cell);
+	}
+
+	Entry.IndexInCell = INDEX_NONE;
+}
+
+void FErosSpatialHash::QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutHandles, int32 IgnoreHandle) const
+{
+	OutHandles.Reset();
+
+	const float RadiusSq = Radius * Radius;
+	const FIntPoint MinCell = GetCell(Center - FVector(Radius, Radius, 0.0f));
+	const FIntPoint MaxCell = GetCell(Center + FVector(Radius, Radius, 0.0f));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<int32>* CellHandles = Cells.Find(FIntPoint(X, Y));
+			if (!CellHandles)
+			{
+				continue;
+			}
+
+			for (const int32 Handle : *CellHandles)
+			{
+				if (Handle != IgnoreHandle && FVector::DistSquared(Entries[Handle].Location, Center) <= RadiusSq)
+				{
+					OutHandles.Add(Handle);
+				}
+			}
+		}
+	}
+}
+
+void FErosSpatialHash::QueryKNearest(const FVector& Center, int32 K, float MaxRadius, TArray<int32>& OutHandles, int32 IgnoreHandle) const
+{
+	OutHandles.Reset();
+	if (K <= 0 || Entries.Num() == 0)
+	{
+		return;
+	}
+
+	// K é pequeno (menu, chat): lista ordenada por inserção é mais barata que heap
+	TArray<TPair<float, int32>, TInlineAllocator<16>> Best;
+	const float MaxRadiusSq = MaxRadius * MaxRadius;
+	const FIntPoint CenterCell = GetCell(Center);
+	const int32 MaxRing = FMath::CeilToInt(MaxRadius * InvCellSize);
+
+	auto VisitCell = [&](int32 X, int32 Y)
+	{
+		const TArray<int32>* CellHandles = Cells.Find(FIntPoint(X, Y));
+		if (!CellHandles)
+		{
+			return;
+		}
+
+		for (const int32 Handle : *CellHandles)
+		{
+			if (Handle == IgnoreHandle)
+			{
+				continue;
+			}
+
+			const float DistSq = FVector::DistSquared(Entries[Handle].Location, Center);
+			if (DistSq > MaxRadiusSq || (Best.Num() == K && DistSq >= Best.Last().Key))
+			{
+				continue;
+			}
+
+			int32 InsertIndex = Best.Num();
+			while (InsertIndex > 0 && Best[InsertIndex - 1].Key > DistSq)
+			{
+				--InsertIndex;
+			}
+			Best.Insert(TPair<float, int32>(DistSq, Handle), InsertIndex);
+			if (Best.Num() > K)
+			{
+				Best.Pop(EAllowShrinking::No);
+			}
+		}
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		if (Ring == 0)
+		{
+			VisitCell(CenterCell.X, CenterCell.Y);
+		}
+		else
+		{
+			// Borda do quadrado de lado 2*Ring+1
+			for (int32 Offset = -Ring; Offset <= Ring; ++Offset)
+			{
+				VisitCell(CenterCell.X + Offset, CenterCell.Y - Ring);
+				VisitCell(CenterCell.X + Offset, CenterCell.Y + Ring);
+			}
+			for (int32 Offset = -Ring + 1; Offset <= Ring - 1; ++Offset)
+			{
+				VisitCell(CenterCell.X - Ring, CenterCell.Y + Offset);
+				VisitCell(CenterCell.X + Ring, CenterCell.Y + Offset);
+			}
+		}
+
+		// Tudo que falta está a pelo menos Ring células de distância no plano
+		const float UnvisitedMinDist = Ring * CellSize;
+		if (Best.Num() == K && Best.Last().Key <= UnvisitedMinDist * UnvisitedMinDist)
+		{
+			break;
+		}
+	}
+
+	OutHandles.Reserve(Best.Num());
+	for (const TPair<float, int32>& Pair : Best)
+	{
+		OutHandles.Add(Pair.Value);
+	}
+}
@@ -0,0 +1,62 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosSpatialHash.h
+// Hash espacial uniforme (XY) para consultas de proximidade
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hash espacial uniforme no plano XY
+ * - Add/Update/Remove em O(1); Update só mexe nas células quando o ponto troca de célula
+ * - Distâncias das consultas são 3D
+ * - Handles são estáveis enquanto o ponto existir
+ */
+class EROSSOCIAL_API FErosSpatialHash
+{
+public:
+	explicit FErosSpatialHash(float InCellSize = 1000.0f);
+
+	int32 Add(const FVector& Location);
+	void Update(int32 Handle, const FVector& NewLocation);
+	void Remove(int32 Handle);
+	void Reset();
+
+	/**
+	 * Pontos a até Radius de Center (sem ordem)
+	 */
+	void QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutHandles, int32 IgnoreHandle = INDEX_NONE) const;
+
+	/**
+	 * Até K pontos mais próximos de Center dentro de MaxRadius, do mais próximo ao mais distante
+	 * Busca em anéis de células a partir do centro e para assim que nenhum anel pode melhorar o resultado
+	 */
+	void QueryKNearest(const FVector& Center, int32 K, float MaxRadius, TArray<int32>& OutHandles, int32 IgnoreHandle = INDEX_NONE) const;
+
+	const FVector& GetLocation(int32 Handle) const { return Entries[Handle].Location; }
+
+	bool IsValidHandle(int32 Handle) const { return Entries.IsValidIndex(Handle); }
+
+	int32 Num() const { return Entries.Num(); }
+
+	float GetCellSize() const { return CellSize; }
+
+private:
+	struct FEntry
+	{
+		FVector Location;
+		FIntPoint Cell;
+		int32 IndexInCell;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	void AddToCell(int32 Handle, const FIntPoint& Cell);
+	void RemoveFromCell(int32 Handle);
+
+	float CellSize;
+	float InvCellSize;
+
+	TSparseArray<FEntry> Entries;
+	TMap<FIntPoint, TArray<int32>> Cells;
+};
@@ -4,6 +4,7 @@
 #include "SaveGameManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "HAL/PlatformFileManager.h"
 #include "Json.h"
 #include "JsonUtilities.h"
 
@@ -11,9 +12,9 @@ USaveGameManager::USaveGameManager()
 {
 }
 
-bool USaveGameManager::SaveCharacterData(const FCharacterSaveData& CharacterData, const FString& UserID, int32 SlotIndex)
+bool USaveGameManager::SaveCharacterData(const FCharacterSaveData& CharacterData, const FErosUserId& UserID, int32 SlotIndex)
 {
-	if (UserID.IsEmpty() || SlotIndex < 0 || SlotIndex > 1)
+	if (!UserID.IsValid() || SlotIndex < 0 || SlotIndex > 1)
 	{
 		return false;
 	}
@@ -38,9 +39,9 @@ bool USaveGameManager::SaveCharacterData(const FCharacterSaveData& CharacterData
 	return FFileHelper::SaveStringToFile(JsonString, *FilePath);
 }
 
-bool USaveGameManager::LoadCharacterData(FCharacterSaveData& OutCharacterData, const FString& UserID, int32 SlotIndex)
+bool USaveGameManager::LoadCharacterData(FCharacterSaveData& OutCharacterData, const FErosUserId& UserID, int32 SlotIndex)
 {
-	if (UserID.IsEmpty() || SlotIndex < 0 || SlotIndex > 1)
+	if (!UserID.IsValid() || SlotIndex < 0 || SlotIndex > 1)
 	{
 		return false;
 	}
@@ -62,9 +63,9 @@ bool USaveGameManager::LoadCharacterData(FCharacterSaveData& OutCharacterData, c
 	return DeserializeCharacterData(JsonString, OutCharacterData);
 }
 
-bool USaveGameManager::CharacterExists(const FString& UserID, int32 SlotIndex)
+bool USaveGameManager::CharacterExists(const FErosUserId& UserID, int32 SlotIndex)
 {
-	if (UserID.IsEmpty() || SlotIndex < 0 || SlotIndex > 1)
+	if (!UserID.IsValid() || SlotIndex < 0 || SlotIndex > 1)
 	{
 		return false;
 	}
@@ -74,9 +75,9 @@ bool USaveGameManager::CharacterExists(const FString& UserID, int32 SlotIndex)
 	return FPaths::FileExists(*FilePath);
 }
 
-bool USaveGameManager::DeleteCharacter(const FString& UserID, int32 SlotIndex)
+bool USaveGameManager::DeleteCharacter(const FErosUserId& UserID, int32 SlotIndex)
 {
-	if (UserID.IsEmpty() || SlotIndex < 0 || SlotIndex > 1)
+	if (!UserID.IsValid() || SlotIndex < 0 || SlotIndex > 1)
 	{
 		return false;
 	}
@@ -92,9 +93,9 @@ bool USaveGameManager::DeleteCharacter(const FString& UserID, int32 SlotIndex)
 	return FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*FilePath);
 }
 
-bool USaveGameManager::SaveOutfit(const FOutfitData& OutfitData, const FString& UserID, const FString& OutfitName)
+bool USaveGameManager::SaveOutfit(const FOutfitData& OutfitData, const FErosUserId& UserID, const FString& OutfitName)
 {
-	if (UserID.IsEmpty() || OutfitName.IsEmpty())
+	if (!UserID.IsValid() || OutfitName.IsEmpty())
 	{
 		return false;
 	}
@@ -113,9 +114,9 @@ bool USaveGameManager::SaveOutfit(const FOutfitData& OutfitData, const FString&
 	return FFileHelper::SaveStringToFile(OutputString, *FilePath);
 }
 
-bool USaveGameManager::LoadOutfit(FOutfitData& OutOutfitData, const FString& UserID, const FString& OutfitName)
+bool USaveGameManager::LoadOutfit(FOutfitData& OutOutfitData, const FErosUserId& UserID, const FString& OutfitName)
 {
-	if (UserID.IsEmpty() || OutfitName.IsEmpty())
+	if (!UserID.IsValid() || OutfitName.IsEmpty())
 	{
 		return false;
 	}
@@ -132,9 +133,9 @@ bool USaveGameManager::LoadOutfit(FOutfitData& OutOutfitData, const FString& Use
 	return FFileHelper::LoadFileToString(JsonString, *FilePath);
 }
 
-bool USaveGameManager::SaveWorldMap(const FString& MapData, const FString& UserID, const FString& MapName)
+bool USaveGameManager::SaveWorldMap(const FString& MapData, const FErosUserId& UserID, const FString& MapName)
 {
-	if (UserID.IsEmpty() || MapName.IsEmpty() || MapData.IsEmpty())
+	if (!UserID.IsValid() || MapName.IsEmpty() || MapData.IsEmpty())
 	{
 		return false;
 	}
@@ -146,9 +147,9 @@ bool USaveGameManager::SaveWorldMap(const FString& MapData, const FString& UserI
 	return FFileHelper::SaveStringToFile(MapData, *FilePath);
 }
 
-bool USaveGameManager::LoadWorldMap(FString& OutMapData, const FString& UserID, const FString& MapName)
+bool USaveGameManager::LoadWorldMap(FString& OutMapData, const FErosUserId& UserID, const FString& MapName)
 {
-	if (UserID.IsEmpty() || MapName.IsEmpty())
+	if (!UserID.IsValid() || MapName.IsEmpty())
 	{
 		return false;
 	}
@@ -164,12 +165,12 @@ bool USaveGameManager::LoadWorldMap(FString& OutMapData, const FString& UserID,
 	return FFileHelper::LoadFileToString(OutMapData, *FilePath);
 }
 
-FString USaveGameManager::GetSaveGamePath(const FString& UserID) const
+FString USaveGameManager::GetSaveGamePath(const FErosUserId& UserID) const
 {
-	return SaveGameDirectory + UserID + TEXT("/");
+	return SaveGameDirectory + UserID.ToString() + TEXT("/");
 }
 
-void USaveGameManager::EnsureSaveDirectoriesExist(const FString& UserID)
+void USaveGameManager::EnsureSaveDirectoriesExist(const FErosUserId& UserID)
 {
 	FString BasePath = GetSaveGamePath(UserID);
 	FString OutfitsPath = BasePath + TEXT("Outfits/");
@@ -193,6 +194,54 @@ void USaveGameManager::EnsureSaveDirectoriesExist(const FString& UserID)
 	}
 }
 
+bool USaveGameManager::MigrateLegacySaveDirectory(const FString& LegacyUserID, const FErosUserId& UserID)
+{
+	if (LegacyUserID.IsEmpty() || !UserID.IsValid())
+	{
+		return false;
+	}
+
+	const FString LegacyPath = SaveGameDirectory + LegacyUserID + TEXT("/");
+	const FString NewPath = GetSaveGamePath(UserID);
+
+	// Login que j era o ID em hex: mesma pasta
+	if (FPaths::IsSamePath(LegacyPath, NewPath))
+	{
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!PlatformFile.DirectoryExists(*LegacyPath))
+	{
+		return false;
+	}
+
+	// Nunca sobrescrever saves j feitos no formato novo
+	if (PlatformFile.DirectoryExists(*NewPath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SaveGameManager::MigrateLegacySaveDirectory - Both %s and %s exist, keeping the new one"),
+			*LegacyPath, *NewPath);
+		return false;
+	}
+
+	// Copia e s apaga a antiga depois da cpia completa
+	if (!PlatformFile.CopyDirectoryTree(*NewPath, *LegacyPath, false))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SaveGameManager::MigrateLegacySaveDirectory - Failed to copy %s to %s"), *LegacyPath, *NewPath);
+		PlatformFile.DeleteDirectoryRecursively(*NewPath);
+		return false;
+	}
+
+	if (!PlatformFile.DeleteDirectoryRecursively(*LegacyPath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SaveGameManager::MigrateLegacySaveDirectory - Copied, but could not remove %s"), *LegacyPath);
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("SaveGameManager::MigrateLegacySaveDirectory - Moved %s to %s"), *LegacyPath, *NewPath);
+	return true;
+}
+
 int32 USaveGameManager::GetCurrentTimestamp() const
 {
 	return static_cast<int32>(FDateTime::Now().ToUnixTimestamp());
@@ -203,7 +252,7 @@ FString USaveGameManager::SerializeCharacterData(const FCharacterSaveData& Chara
 	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
 
 	JsonObject->SetStringField(TEXT("CharacterName"), CharacterData.CharacterName);
-	JsonObject->SetStringField(TEXT("CharacterGender"), CharacterData.CharacterGender);
+	JsonObject->SetStringField(TEXT("CharacterGender"), LexToString(CharacterData.CharacterGender));
 	JsonObject->SetNumberField(TEXT("CharacterSlot"), CharacterData.CharacterSlot);
 
 	FString OutputString;
@@ -224,7 +273,14 @@ bool USaveGameManager::DeserializeCharacterData(const FString& JsonString, FChar
 	}
 
 	OutCharacterData.CharacterName = JsonObject->GetStringField(TEXT("CharacterName"));
-	OutCharacterData.CharacterGender = JsonObject->GetStringField(TEXT("CharacterGender"));
+	// Gnero ausente ou desconhecido no invalida o personagem
+	const FString GenderString = JsonObject->GetStringField(TEXT("CharacterGender"));
+	if (!LexTryParseString(OutCharacterData.CharacterGender, *GenderString))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SaveGameManager::DeserializeCharacterData - Unknown gender '%s' for '%s', using %s"),
+			*GenderString, *OutCharacterData.CharacterName, LexToString(ECharacterGender::Male));
+		OutCharacterData.CharacterGender = ECharacterGender::Male;
+	}
 	OutCharacterData.CharacterSlot = JsonObject->GetIntegerField(TEXT("CharacterSlot"));
 
 	return true;
@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "CharacterSaveData.h"
+#include "ErosUserId.h"
 #include "SaveGameManager.generated.h"
 
 UCLASS(Blueprintable, BlueprintType)
@@ -17,34 +18,41 @@ public:
 	USaveGameManager();
 
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
-	bool SaveCharacterData(const FCharacterSaveData& CharacterData, const FString& UserID, int32 SlotIndex);
+	bool SaveCharacterData(const FCharacterSaveData& CharacterData, const FErosUserId& UserID, int32 SlotIndex);
 
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
-	bool LoadCharacterData(FCharacterSaveData& OutCharacterData, const FString& UserID, int32 SlotIndex);
+	bool LoadCharacterData(FCharacterSaveData& OutCharacterData, const FErosUserId& UserID, int32 SlotIndex);
 
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
-	bool CharacterExists(const FString& UserID, int32 SlotIndex);
+	bool CharacterExists(const FErosUserId& UserID, int32 SlotIndex);
 
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
-	bool DeleteCharacter(const FString& UserID, int32 SlotIndex);
+	bool DeleteCharacter(const FErosUserId& UserID, int32 SlotIndex);
 
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
-	bool SaveOutfit(const FOutfitData& OutfitData, const FString& UserID, const FString& OutfitName);
+	bool SaveOutfit(const FOutfitData& OutfitData, const FErosUserId& UserID, const FString& OutfitName);
 
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
-	bool LoadOutfit(FOutfitData& OutOutfitData, const FString& UserID, const FString& OutfitName);
+	bool LoadOutfit(FOutfitData& OutOutfitData, const FErosUserId& UserID, const FString& OutfitName);
 
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
-	bool SaveWorldMap(const FString& MapData, const FString& UserID, const FString& MapName);
+	bool SaveWorldMap(const FString& MapData, const FErosUserId& UserID, const FString& MapName);
 
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
-	bool LoadWorldMap(FString& OutMapData, const FString& UserID, const FString& MapName);
+	bool LoadWorldMap(FString& OutMapData, const FErosUserId& UserID, const FString& MapName);
 
 	UFUNCTION(BlueprintPure, Category = "SaveGame")
-	FString GetSaveGamePath(const FString& UserID) const;
+	FString GetSaveGamePath(const FErosUserId& UserID) const;
 
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
-	void EnsureSaveDirectoriesExist(const FString& UserID);
+	void EnsureSaveDirectoriesExist(const FErosUserId& UserID);
+
+	/**
+	 * Move a pasta antiga (nome = string do login) para a pasta do FErosUserId
+	 * Só age uma vez: sem pasta antiga, ou com a nova já existente, não faz nada
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveGame")
+	bool MigrateLegacySaveDirectory(const FString& LegacyUserID, const FErosUserId& UserID);
 
 	UFUNCTION(BlueprintPure, Category = "SaveGame")
 	int32 GetCurrentTimestamp() const;
@@ -0,0 +1,258 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosGroomBudgetSubsystem.cpp
+
+#include "Systems/Significance/ErosGroomBudgetSubsystem.h"
+#include "Systems/Significance/ErosSignificanceStats.h"
+#include "Systems/Significance/ErosSignificanceSubsystem.h"
+#include "ErosSocialCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "GroomAsset.h"
+#include "GroomComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Groom Budget Evaluate"), STAT_ErosGroom_Evaluate, STATGROUP_ErosSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Groom Strands Rendered"), STAT_ErosGroom_Strands, STATGROUP_ErosSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Groom Strand Budget"), STAT_ErosGroom_StrandBudget, STATGROUP_ErosSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grooms on Strands"), STAT_ErosGroom_OnStrands, STATGROUP_ErosSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grooms on Cards/Mesh"), STAT_ErosGroom_OnCards, STATGROUP_ErosSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grooms Simulated"), STAT_ErosGroom_Simulated, STATGROUP_ErosSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grooms Over Budget"), STAT_ErosGroom_OverBudget, STATGROUP_ErosSignificance);
+
+UErosGroomBudgetSubsystem* UErosGroomBudgetSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosGroomBudgetSubsystem>() : nullptr;
+}
+
+bool UErosGroomBudgetSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Servidor dedicado não renderiza
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UErosGroomBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UErosGroomBudgetSubsystem::Deinitialize()
+{
+	LODInfos.Reset();
+	AppliedStates.Reset();
+	Candidates.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UErosGroomBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UErosGroomBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UErosGroomBudgetSubsystem::Tick(float DeltaTime)
+{
+	TimeUntilEvaluation -= DeltaTime;
+	if (TimeUntilEvaluation > 0.0f)
+	{
+		return;
+	}
+	TimeUntilEvaluation = EvaluationInterval;
+
+	EvaluateNow();
+}
+
+void UErosGroomBudgetSubsystem::EvaluateNow()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosGroom_Evaluate);
+
+	UWorld* World = GetWorld();
+	const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	const UErosSignificanceSubsystem* Significance = UErosSignificanceSubsystem::Get(this);
+
+	Candidates.Reset();
+	for (TActorIterator<AErosSocialCharacter> It(World); It; ++It)
+	{
+		AErosSocialCharacter* Character = *It;
+		USkeletalMeshComponent* MeshComponent = Character->GetMesh();
+		if (!MeshComponent)
+		{
+			continue;
+		}
+
+		// O degrau de significância limita o melhor LOD
+		int32 SignificanceTier = 0;
+		int32 MinLOD = 0;
+		if (Significance)
+		{
+			SignificanceTier = FMath::Max(Significance->GetTier(Character), 0);
+			const FErosSignificanceTier* Tier = Significance->GetTierSettings(SignificanceTier);
+			MinLOD = Tier ? FMath::Max(Tier->HairLOD, 0) : 0;
+		}
+
+		const float Distance = FVector::Dist(Character->GetActorLocation(), ViewLocation);
+
+		TArray<USceneComponent*> Children;
+		MeshComponent->GetChildrenComponents(true, Children);
+		for (USceneComponent* Child : Children)
+		{
+			UGroomComponent* Groom = Cast<UGroomComponent>(Child);
+			if (Groom && Groom->GroomAsset)
+			{
+				Candidates.Add({ Groom, Distance, MinLOD, SignificanceTier });
+			}
+		}
+	}
+
+	// Mais importante primeiro: degrau de significância, depois distância
+	Candidates.Sort([](const FGroomCandidate& A, const FGroomCandidate& B)
+	{
+		return A.SignificanceTier != B.SignificanceTier ? A.SignificanceTier < B.SignificanceTier : A.Distance < B.Distance;
+	});
+
+	int64 RemainingStrands = StrandBudget;
+	int32 NumOnStrands = 0;
+	int32 NumOnCards = 0;
+	int32 NumSimulated = 0;
+	int32 NumOverBudget = 0;
+
+	for (const FGroomCandidate& Candidate : Candidates)
+	{
+		UGroomComponent* Groom = Candidate.Groom.Get();
+		const FGroomLODInfo& Info = GetLODInfo(Groom->GroomAsset);
+		const int32 NumLODs = Info.Strands.Num();
+		if (NumLODs == 0)
+		{
+			continue;
+		}
+
+		int32 LOD = ChooseDistanceLOD(Info, Candidate.Distance, Candidate.MinLOD);
+
+		// Desce de LOD até caber; sem LOD que caiba, cards/mesh ou o último LOD
+		if (Info.Strands[LOD] > RemainingStrands)
+		{
+			++NumOverBudget;
+			while (LOD < NumLODs - 1 && Info.Strands[LOD] > RemainingStrands)
+			{
+				++LOD;
+			}
+			if (Info.Strands[LOD] > RemainingStrands && Info.FirstCardsLOD != INDEX_NONE)
+			{
+				LOD = Info.FirstCardsLOD;
+			}
+		}
+
+		RemainingStrands -= Info.Strands[LOD];
+
+		const bool bSimulation = Info.IsStrands[LOD]
+			&& Candidate.Distance <= SimulationRadius
+			&& NumSimulated < MaxSimulatedGrooms;
+
+		Apply(*Groom, LOD, bSimulation);
+
+		NumSimulated += bSimulation ? 1 : 0;
+		NumOnStrands += Info.IsStrands[LOD] ? 1 : 0;
+		NumOnCards += Info.IsStrands[LOD] ? 0 : 1;
+	}
+
+	for (auto It = AppliedStates.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ErosGroom_Strands, static_cast<uint32>(FMath::Max<int64>(StrandBudget - RemainingStrands, 0)));
+	SET_DWORD_STAT(STAT_ErosGroom_StrandBudget, StrandBudget);
+	SET_DWORD_STAT(STAT_ErosGroom_OnStrands, NumOnStrands);
+	SET_DWORD_STAT(STAT_ErosGroom_OnCards, NumOnCards);
+	SET_DWORD_STAT(STAT_ErosGroom_Simulated, NumSimulated);
+	SET_DWORD_STAT(STAT_ErosGroom_OverBudget, NumOverBudget);
+}
+
+const UErosGroomBudgetSubsystem::FGroomLODInfo& UErosGroomBudgetSubsystem::GetLODInfo(UGroomAsset* Asset)
+{
+	const TObjectKey<UGroomAsset> AssetKey(Asset);
+	if (const FGroomLODInfo* Cached = LODInfos.Find(AssetKey))
+	{
+		return *Cached;
+	}
+
+	FGroomLODInfo& Info = LODInfos.Add(AssetKey);
+	const int32 NumLODs = Asset->GetLODCount();
+	Info.Strands.Init(0, NumLODs);
+	Info.IsStrands.Init(false, NumLODs);
+
+	const TArray<FHairGroupsInfo>& GroupsInfo = Asset->GetHairGroupsInfo();
+	const TArray<FHairGroupsLOD>& GroupsLOD = Asset->GetHairGroupsLOD();
+
+	for (int32 LOD = 0; LOD < NumLODs; ++LOD)
+	{
+		for (int32 Group = 0; Group < GroupsLOD.Num(); ++Group)
+		{
+			if (!GroupsLOD[Group].LODs.IsValidIndex(LOD) || GroupsLOD[Group].LODs[LOD].GeometryType != EGroomGeometryType::Strands)
+			{
+				continue;
+			}
+
+			const int32 NumCurves = GroupsInfo.IsValidIndex(Group) ? GroupsInfo[Group].NumCurves : 0;
+			Info.Strands[LOD] += FMath::CeilToInt(NumCurves * FMath::Clamp(GroupsLOD[Group].LODs[LOD].CurveDecimation, 0.0f, 1.0f));
+			Info.IsStrands[LOD] = true;
+		}
+
+		if (!Info.IsStrands[LOD] && Info.FirstCardsLOD == INDEX_NONE)
+		{
+			Info.FirstCardsLOD = LOD;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UErosGroomBudgetSubsystem::GetLODInfo - %s: %d LODs, %d strands at LOD0, cards/mesh from LOD %d"),
+		*Asset->GetName(), NumLODs, NumLODs > 0 ? Info.Strands[0] : 0, Info.FirstCardsLOD);
+	return Info;
+}
+
+int32 UErosGroomBudgetSubsystem::ChooseDistanceLOD(const FGroomLODInfo& Info, float Distance, int32 MinLOD) const
+{
+	const int32 NumLODs = Info.Strands.Num();
+
+	if (Distance >= CardsDistance && Info.FirstCardsLOD != INDEX_NONE)
+	{
+		return FMath::Max(Info.FirstCardsLOD, FMath::Min(MinLOD, NumLODs - 1));
+	}
+
+	int32 LOD = 0;
+	while (LOD + 1 < LODDistances.Num() && Distance >= LODDistances[LOD + 1])
+	{
+		++LOD;
+	}
+
+	return FMath::Clamp(FMath::Max(LOD, MinLOD), 0, NumLODs - 1);
+}
+
+void UErosGroomBudgetSubsystem::Apply(UGroomComponent& Groom, int32 LOD, bool bSimulation)
+{
+	FAppliedState& State = AppliedStates.FindOrAdd(&Groom);
+
+	if (State.LOD != LOD)
+	{
+		State.LOD = LOD;
+		Groom.SetForcedLOD(LOD);
+	}
+
+	if (State.bSimulation != bSimulation)
+	{
+		State.bSimulation = bSimulation;
+		Groom.SetEnableSimulation(bSimulation);
+	}
+}
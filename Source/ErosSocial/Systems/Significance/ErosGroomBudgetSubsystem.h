@@ -0,0 +1,103 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosGroomBudgetSubsystem.h
+// LOD, cards/mesh e simulação dos grooms dos avatares dentro de um orçamento de strands
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ErosGroomBudgetSubsystem.generated.h"
+
+class UGroomAsset;
+class UGroomComponent;
+
+/**
+ * Controla os UGroomComponent presos nos avatares (somente cliente)
+ * - LOD por distância, nunca melhor que o HairLOD do degrau de significância do avatar
+ * - Além de CardsDistance usa o primeiro LOD de cards/mesh do asset (se houver)
+ * - Orçamento global de strands: do avatar mais importante para o menos, o groom desce de LOD até caber
+ * - Simulação só dentro de SimulationRadius, em LOD de strands e até MaxSimulatedGrooms
+ *
+ * Strands por LOD = curvas do asset * CurveDecimation do LOD (0 para LODs de cards/mesh)
+ */
+UCLASS(config = Game)
+class EROSSOCIAL_API UErosGroomBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosGroomBudgetSubsystem* Get(const UObject* WorldContextObject);
+
+	// USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Reavalia todos agora (normalmente a cada EvaluationInterval) */
+	void EvaluateNow();
+
+	// ========== CONFIGURAÇÃO (DefaultGame.ini) ==========
+
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.25f;
+
+	// Strands renderizados somando todos os grooms
+	UPROPERTY(Config)
+	int32 StrandBudget = 500000;
+
+	// Distância a partir da qual cada LOD é usado (índice = LOD)
+	UPROPERTY(Config)
+	TArray<float> LODDistances;
+
+	// Além daqui o groom vai para cards/mesh
+	UPROPERTY(Config)
+	float CardsDistance = 2500.0f;
+
+	UPROPERTY(Config)
+	float SimulationRadius = 1200.0f;
+
+	UPROPERTY(Config)
+	int32 MaxSimulatedGrooms = 8;
+
+private:
+	struct FGroomLODInfo
+	{
+		// Por LOD: strands renderizados (0 em cards/mesh)
+		TArray<int32> Strands;
+		TArray<bool> IsStrands;
+		int32 FirstCardsLOD = INDEX_NONE;
+	};
+
+	struct FGroomCandidate
+	{
+		TWeakObjectPtr<UGroomComponent> Groom;
+		float Distance = 0.0f;
+		int32 MinLOD = 0;
+		int32 SignificanceTier = 0;
+	};
+
+	struct FAppliedState
+	{
+		int32 LOD = INDEX_NONE;
+		bool bSimulation = true;
+	};
+
+	const FGroomLODInfo& GetLODInfo(UGroomAsset* Asset);
+
+	int32 ChooseDistanceLOD(const FGroomLODInfo& Info, float Distance, int32 MinLOD) const;
+
+	void Apply(UGroomComponent& Groom, int32 LOD, bool bSimulation);
+
+	TMap<TObjectKey<UGroomAsset>, FGroomLODInfo> LODInfos;
+	TMap<TObjectKey<UGroomComponent>, FAppliedState> AppliedStates;
+
+	// Reaproveitado entre avaliações
+	TArray<FGroomCandidate> Candidates;
+
+	float TimeUntilEvaluation = 0.0f;
+};
@@ -0,0 +1,10 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosSignificanceStats.h
+// Grupo de stats de significância dos avatares ("stat ErosSignificance")
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("ErosSocial Significance"), STATGROUP_ErosSignificance, STATCAT_Advanced);
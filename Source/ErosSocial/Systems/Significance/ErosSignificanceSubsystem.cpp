@@ -0,0 +1,316 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosSignificanceSubsystem.cpp
+
+#include "Systems/Significance/ErosSignificanceSubsystem.h"
+#include "Systems/Significance/ErosSignificanceStats.h"
+#include "Systems/Customization/ErosMorphComponent.h"
+#include "ErosSocialCharacter.h"
+#include "ErosSocialPlayerController.h"
+#include "ErosSocialPlayerState.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GroomComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Evaluate"), STAT_ErosSignificance_Evaluate, STATGROUP_ErosSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Avatars Top Tier"), STAT_ErosSignificance_TopTier, STATGROUP_ErosSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Avatars Lowest Tier"), STAT_ErosSignificance_LowestTier, STATGROUP_ErosSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tier Changes"), STAT_ErosSignificance_Changes, STATGROUP_ErosSignificance);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Budget Used"), STAT_ErosSignificance_BudgetUsed, STATGROUP_ErosSignificance);
+
+UErosSignificanceSubsystem* UErosSignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UErosSignificanceSubsystem>() : nullptr;
+}
+
+bool UErosSignificanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Servidor dedicado não renderiza nem anima para ninguém ver
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UErosSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UErosSignificanceSubsystem::Deinitialize()
+{
+	Registered.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UErosSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UErosSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UErosSignificanceSubsystem::Tick(float DeltaTime)
+{
+	TimeUntilEvaluation -= DeltaTime;
+	if (TimeUntilEvaluation > 0.0f)
+	{
+		return;
+	}
+	TimeUntilEvaluation = EvaluationInterval;
+
+	EvaluateNow();
+}
+
+void UErosSignificanceSubsystem::RegisterCharacter(AErosSocialCharacter* Character)
+{
+	if (!Character || GetTier(Character) != INDEX_NONE)
+	{
+		return;
+	}
+
+	FRegisteredCharacter& Entry = Registered.AddDefaulted_GetRef();
+	Entry.Character = Character;
+	Entry.Tier = Tiers.Num() > 0 ? 0 : INDEX_NONE;
+
+	// Entra no melhor degrau; a próxima avaliação ajusta
+	TimeUntilEvaluation = FMath::Min(TimeUntilEvaluation, 0.0f);
+}
+
+void UErosSignificanceSubsystem::UnregisterCharacter(AErosSocialCharacter* Character)
+{
+	Registered.RemoveAllSwap([Character](const FRegisteredCharacter& Entry)
+	{
+		return !Entry.Character.IsValid() || Entry.Character.Get() == Character;
+	});
+}
+
+int32 UErosSignificanceSubsystem::GetTier(const AErosSocialCharacter* Character) const
+{
+	const FRegisteredCharacter* Entry = Registered.FindByPredicate([Character](const FRegisteredCharacter& Candidate)
+	{
+		return Candidate.Character.Get() == Character;
+	});
+	return Entry ? Entry->Tier : INDEX_NONE;
+}
+
+void UErosSignificanceSubsystem::RefreshAttachments(AErosSocialCharacter* Character)
+{
+	FRegisteredCharacter* Entry = Registered.FindByPredicate([Character](const FRegisteredCharacter& Candidate)
+	{
+		return Candidate.Character.Get() == Character;
+	});
+
+	if (Entry && Character && Tiers.IsValidIndex(Entry->Tier))
+	{
+		ApplyTier(*Entry, Tiers[Entry->Tier]);
+	}
+}
+
+void UErosSignificanceSubsystem::EvaluateNow()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ErosSignificance_Evaluate);
+
+	UWorld* World = GetWorld();
+	const AErosSocialPlayerController* PlayerController = World ? Cast<AErosSocialPlayerController>(World->GetFirstPlayerController()) : nullptr;
+	if (!PlayerController || Tiers.Num() == 0)
+	{
+		return;
+	}
+
+	// Ponto de vista e relações do jogador local
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	ViewDirection = ViewRotation.Vector();
+
+	const float HalfFOVRadians = FMath::DegreesToRadians(0.5f * (PlayerController->PlayerCameraManager ? PlayerController->PlayerCameraManager->GetFOVAngle() : 90.0f));
+	CosHalfFOV = FMath::Cos(HalfFOVRadians);
+	InvTanHalfFOV = 1.0f / FMath::Max(FMath::Tan(HalfFOVRadians), KINDA_SMALL_NUMBER);
+
+	const AErosSocialPlayerState* LocalPlayerState = PlayerController->GetPlayerState<AErosSocialPlayerState>();
+	const AErosSocialPlayerState* Partner = LocalPlayerState ? LocalPlayerState->GetPartner() : nullptr;
+	LocalPawn = PlayerController->GetPawn();
+	PartnerPawn = Partner ? Partner->GetPawn() : nullptr;
+	HoveredActor = PlayerController->HoveredPlayer;
+	SelectedActor = PlayerController->SelectedPlayer;
+
+	Registered.RemoveAllSwap([](const FRegisteredCharacter& Entry) { return !Entry.Character.IsValid(); });
+
+	SortedIndices.Reset(Registered.Num());
+	for (int32 Index = 0; Index < Registered.Num(); ++Index)
+	{
+		Registered[Index].Significance = ComputeSignificance(Registered[Index].Character.Get());
+		SortedIndices.Add(Index);
+	}
+
+	SortedIndices.Sort([this](int32 A, int32 B)
+	{
+		return Registered[A].Significance > Registered[B].Significance;
+	});
+
+	const int32 LowestTier = Tiers.Num() - 1;
+	float RemainingBudget = FrameBudget;
+	int32 NumTop = 0;
+	int32 NumLowest = 0;
+	int32 NumChanges = 0;
+
+	for (const int32 Index : SortedIndices)
+	{
+		FRegisteredCharacter& Entry = Registered[Index];
+
+		int32 NewTier = LowestTier;
+		for (int32 TierIndex = 0; TierIndex < LowestTier; ++TierIndex)
+		{
+			const FErosSignificanceTier& Tier = Tiers[TierIndex];
+			const bool bPromotion = Entry.Tier == INDEX_NONE || TierIndex < Entry.Tier;
+			const float MinSignificance = Tier.MinSignificance * (bPromotion ? 1.0f + PromotionHysteresis : 1.0f);
+
+			if (Entry.Significance >= MinSignificance && Tier.Cost <= RemainingBudget)
+			{
+				NewTier = TierIndex;
+				break;
+			}
+		}
+
+		// O último degrau é o piso: não consome orçamento
+		if (NewTier < LowestTier)
+		{
+			RemainingBudget -= Tiers[NewTier].Cost;
+		}
+
+		if (NewTier != Entry.Tier)
+		{
+			Entry.Tier = NewTier;
+			ApplyTier(Entry, Tiers[NewTier]);
+			++NumChanges;
+		}
+		else if (HaveAttachmentsChanged(Entry))
+		{
+			// Roupa presa/solta desde o último ApplyTier: entra no degrau atual
+			ApplyTier(Entry, Tiers[NewTier]);
+		}
+
+		NumTop += NewTier == 0 ? 1 : 0;
+		NumLowest += NewTier == LowestTier ? 1 : 0;
+	}
+
+	SET_DWORD_STAT(STAT_ErosSignificance_TopTier, NumTop);
+	SET_DWORD_STAT(STAT_ErosSignificance_LowestTier, NumLowest);
+	SET_DWORD_STAT(STAT_ErosSignificance_Changes, NumChanges);
+	SET_FLOAT_STAT(STAT_ErosSignificance_BudgetUsed, FrameBudget - RemainingBudget);
+}
+
+float UErosSignificanceSubsystem::ComputeSignificance(const AErosSocialCharacter* Character) const
+{
+	// O próprio avatar sempre no primeiro degrau
+	if (Character == LocalPawn.Get())
+	{
+		return MAX_flt;
+	}
+
+	const USkeletalMeshComponent* MeshComponent = Character->GetMesh();
+	const float Radius = MeshComponent ? MeshComponent->Bounds.SphereRadius : Character->GetSimpleCollisionRadius();
+
+	const FVector ToCharacter = Character->GetActorLocation() - ViewLocation;
+	const float Distance = FMath::Max(ToCharacter.Size(), 1.0f);
+
+	// Raio projetado como fração da meia largura da tela
+	float Significance = FMath::Min(Radius * InvTanHalfFOV / Distance, 1.0f);
+
+	const bool bInView = Distance <= Radius || FVector::DotProduct(ToCharacter, ViewDirection) >= CosHalfFOV * Distance - Radius;
+	if (!bInView)
+	{
+		Significance *= OffscreenScale;
+	}
+
+	const AActor* CharacterPlayerState = Character->GetPlayerState();
+	auto IsActor = [Character, CharacterPlayerState](const TWeakObjectPtr<const AActor>& Actor)
+	{
+		return Actor.IsValid() && (Actor.Get() == Character || Actor.Get() == CharacterPlayerState);
+	};
+
+	if (IsActor(PartnerPawn))
+	{
+		Significance *= PartnerBoost;
+	}
+	if (IsActor(HoveredActor))
+	{
+		Significance *= HoveredBoost;
+	}
+	if (IsActor(SelectedActor))
+	{
+		Significance *= SelectedBoost;
+	}
+
+	return Significance;
+}
+
+bool UErosSignificanceSubsystem::HaveAttachmentsChanged(const FRegisteredCharacter& Entry) const
+{
+	const AErosSocialCharacter* Character = Entry.Character.Get();
+	const USkeletalMeshComponent* MeshComponent = Character ? Character->GetMesh() : nullptr;
+	return MeshComponent && MeshComponent->GetNumChildrenComponents() != Entry.NumMeshChildren;
+}
+
+void UErosSignificanceSubsystem::ApplyTier(FRegisteredCharacter& Entry, const FErosSignificanceTier& Tier) const
+{
+	AErosSocialCharacter* Character = Entry.Character.Get();
+	USkeletalMeshComponent* MeshComponent = Character ? Character->GetMesh() : nullptr;
+	if (!MeshComponent)
+	{
+		return;
+	}
+
+	Entry.NumMeshChildren = MeshComponent->GetNumChildrenComponents();
+
+	MeshComponent->SetComponentTickInterval(Tier.AnimTickInterval);
+
+	// Os pesos continuam no mesh; só o envio das mudanças fica mais espaçado
+	if (UErosMorphComponent* MorphComponent = Character->GetMorphComponent())
+	{
+		MorphComponent->SetComponentTickInterval(Tier.MorphTickInterval);
+	}
+
+	TArray<USceneComponent*> Children;
+	MeshComponent->GetChildrenComponents(true, Children);
+	Children.Add(MeshComponent);
+
+	for (USceneComponent* Child : Children)
+	{
+		if (USkeletalMeshComponent* SkeletalChild = Cast<USkeletalMeshComponent>(Child))
+		{
+			if (Tier.bClothSimulation)
+			{
+				SkeletalChild->ResumeClothingSimulation();
+			}
+			else
+			{
+				SkeletalChild->SuspendClothingSimulation();
+			}
+
+			// Peças de roupa seguem o tick da animação do corpo
+			if (SkeletalChild != MeshComponent)
+			{
+				SkeletalChild->SetComponentTickInterval(Tier.AnimTickInterval);
+			}
+		}
+
+		// Groom: LOD e visibilidade com o UErosGroomBudgetSubsystem
+		// Só esconde o que está visível e guarda quem foi, para não reexibir o que gameplay escondeu
+		if (!Tier.bShowAttachments && Child != MeshComponent && Child->IsA<UMeshComponent>() && !Child->IsA<UGroomComponent>()
+			&& Child->GetVisibleFlag())
+		{
+			Child->SetVisibility(false);
+			Entry.HiddenAttachments.AddUnique(Child);
+		}
+	}
+
+	if (Tier.bShowAttachments)
+	{
+		for (const TWeakObjectPtr<USceneComponent>& Hidden : Entry.HiddenAttachments)
+		{
+			if (USceneComponent* Attachment = Hidden.Get())
+			{
+				Attachment->SetVisibility(true);
+			}
+		}
+		Entry.HiddenAttachments.Reset();
+	}
+}
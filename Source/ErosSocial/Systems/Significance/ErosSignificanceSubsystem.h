@@ -0,0 +1,157 @@
+// Copyright BlueCatt Studios - All Rights Reserved
+// ErosSignificanceSubsystem.h
+// Significância dos avatares e orçamento de atualização (animação, morphs, cabelo, roupas)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ErosSignificanceSubsystem.generated.h"
+
+class AErosSocialCharacter;
+
+/**
+ * Degrau de qualidade de um avatar (DefaultGame.ini, do melhor para o pior)
+ */
+USTRUCT()
+struct FErosSignificanceTier
+{
+	GENERATED_BODY()
+
+	// Significância mínima (fração da tela, já com o bônus social) para entrar no degrau
+	UPROPERTY()
+	float MinSignificance = 0.0f;
+
+	// Custo estimado de um avatar nesse degrau (unidades de FrameBudget)
+	UPROPERTY()
+	float Cost = 1.0f;
+
+	// Intervalo de tick da animação (0 = todo frame)
+	UPROPERTY()
+	float AnimTickInterval = 0.0f;
+
+	// Intervalo de envio dos morphs sujos para o mesh (0 = todo frame)
+	UPROPERTY()
+	float MorphTickInterval = 0.0f;
+
+	// Melhor LOD permitido para o groom (UErosGroomBudgetSubsystem; -1 = sem limite)
+	UPROPERTY()
+	int32 HairLOD = -1;
+
+	UPROPERTY()
+	bool bClothSimulation = true;
+
+	// Roupas e acessórios presos no mesh
+	UPROPERTY()
+	bool bShowAttachments = true;
+};
+
+/**
+ * Ordena os avatares por significância e distribui os degraus dentro de um orçamento por frame (somente cliente)
+ * - Significância = tamanho na tela, reduzido fora do campo de visão
+ * - Partner, hover e seleção do jogador local ganham bônus; o próprio avatar fica sempre no primeiro degrau
+ * - Do mais significativo para o menos: melhor degrau cujo mínimo e custo cabem; o último degrau não tem custo
+ * - Só aplica quando o degrau muda (histerese na promoção evita troca a cada avaliação)
+ *   ou quando o número de componentes presos no mesh muda (roupa nova entra no degrau atual)
+ * - Só reexibe as peças que ele mesmo escondeu; o que gameplay/Blueprint escondeu fica escondido
+ * - O cabelo fica com o UErosGroomBudgetSubsystem, que lê o degrau de cada avatar
+ */
+UCLASS(config = Game)
+class EROSSOCIAL_API UErosSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UErosSignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	// USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCharacter(AErosSocialCharacter* Character);
+	void UnregisterCharacter(AErosSocialCharacter* Character);
+
+	/** Degrau atual do avatar (INDEX_NONE se não registrado) */
+	int32 GetTier(const AErosSocialCharacter* Character) const;
+
+	const FErosSignificanceTier* GetTierSettings(int32 TierIndex) const { return Tiers.IsValidIndex(TierIndex) ? &Tiers[TierIndex] : nullptr; }
+
+	/** Reaplica o degrau atual (chamar depois de prender/soltar roupas para não esperar a próxima avaliação) */
+	UFUNCTION(BlueprintCallable, Category = "Significance")
+	void RefreshAttachments(AErosSocialCharacter* Character);
+
+	/** Reavalia todos agora (normalmente a cada EvaluationInterval) */
+	void EvaluateNow();
+
+	// ========== CONFIGURAÇÃO (DefaultGame.ini) ==========
+
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.2f;
+
+	// Orçamento total por frame (soma dos Cost dos degraus atribuídos)
+	UPROPERTY(Config)
+	float FrameBudget = 64.0f;
+
+	UPROPERTY(Config)
+	TArray<FErosSignificanceTier> Tiers;
+
+	// Multiplicador para quem está fora do campo de visão
+	UPROPERTY(Config)
+	float OffscreenScale = 0.25f;
+
+	// Bônus (multiplicador) para partner, hover e seleção do jogador local
+	UPROPERTY(Config)
+	float PartnerBoost = 4.0f;
+
+	UPROPERTY(Config)
+	float HoveredBoost = 2.0f;
+
+	UPROPERTY(Config)
+	float SelectedBoost = 3.0f;
+
+	// Promoção exige MinSignificance * (1 + PromotionHysteresis)
+	UPROPERTY(Config)
+	float PromotionHysteresis = 0.15f;
+
+private:
+	struct FRegisteredCharacter
+	{
+		TWeakObjectPtr<AErosSocialCharacter> Character;
+		float Significance = 0.0f;
+		int32 Tier = INDEX_NONE;
+
+		// Filhos diretos do mesh no último ApplyTier (INDEX_NONE = nunca aplicado)
+		int32 NumMeshChildren = INDEX_NONE;
+
+		// Peças que este subsystem escondeu (e só essas voltam a aparecer)
+		TArray<TWeakObjectPtr<USceneComponent>> HiddenAttachments;
+	};
+
+	float ComputeSignificance(const AErosSocialCharacter* Character) const;
+
+	bool HaveAttachmentsChanged(const FRegisteredCharacter& Entry) const;
+
+	void ApplyTier(FRegisteredCharacter& Entry, const FErosSignificanceTier& Tier) const;
+
+	TArray<FRegisteredCharacter> Registered;
+
+	// Ponto de vista e relações do jogador local da avaliação atual
+	FVector ViewLocation = FVector::ZeroVector;
+	FVector ViewDirection = FVector::ForwardVector;
+	float CosHalfFOV = 0.5f;
+	float InvTanHalfFOV = 1.0f;
+	TWeakObjectPtr<const AActor> LocalPawn;
+	TWeakObjectPtr<const AActor> PartnerPawn;
+	TWeakObjectPtr<const AActor> HoveredActor;
+	TWeakObjectPtr<const AActor> SelectedActor;
+
+	// Reaproveitado entre avaliações
+	TArray<int32> SortedIndices;
+
+	float TimeUntilEvaluation = 0.0f;
+};